@@ -0,0 +1,377 @@
+//
+// FMRT Core V2.2
+// bench_fleet_scaling.cpp
+//
+// Fleet scalability: steps per second over fleet sizes (1k .. 10M
+// organisms) and thread counts, to locate where the organism columns
+// leave the caches and where adding threads stops paying.
+//
+//   fmrt_bench_scaling [--max-organisms N] [--threads 1,2,4,...]
+//                      [--min-events N] [--workload update|gap|all]
+//                      [--csv FILE|-]
+//
+// Workloads (one Fleet per cell, LifecyclePolicy::AutoReset with
+// auto_reset_after = 0, so organisms that collapse are RESET and keep
+// producing full steps instead of the collapsed early return):
+//   update  modeled on test_update_high_stress: large Δ / Φ / M, strong
+//           per-organism UPDATE stimuli (scaled so an organism survives
+//           ~30 events). Each organism gets its own event per round via
+//           submit() + run(); only run() is timed — submission is one
+//           producer thread and would otherwise be the bottleneck.
+//   gap     modeled on test_gap_sequence_stability: relaxed states, one
+//           GAP (dt = 1) per round for every organism via broadcast().
+//
+// Columns:
+//   MiB       state columns of the fleet (organisms x Δ, Φ, M, κ,
+//             RegimePrev): the data every step reads and writes; the
+//             per-organism bookkeeping adds ~20 bytes per organism
+//   fits      smallest cache level holding those columns (sysconf)
+//   steps/s   events applied per second (per thread: divide by threads)
+//   GB/s      estimated traffic: state columns read + written per step,
+//             plus the FleetEvent record for `update` — a lower bound
+//             (bookkeeping arrays and write-allocate are not counted)
+//   eff       steps/s / (threads x steps/s at 1 thread, same size)
+//   resets    share of steps that were AutoReset RESETs
+//   errors    share of steps that returned ERROR (state left unchanged;
+//             under `update` mostly regime-irreversibility rejections)
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#   include <unistd.h>
+#endif
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    // state columns of one organism (Δ, Φ, M, κ, RegimePrev)
+    constexpr double STATE_BYTES = sizeof(double) * (DELTA_DIM + 3) + sizeof(Regime);
+
+    struct Rng
+    {
+        std::uint64_t s;
+
+        double uniform(double lo, double hi)
+        {
+            s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+            return lo + (hi - lo) * (static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0));
+        }
+    };
+
+    enum class Workload { Update, Gap };
+
+    const char* workloadName(Workload w) { return w == Workload::Update ? "update" : "gap"; }
+
+    // ---------------------------------------------------------------------
+    // Cache sizes
+    // ---------------------------------------------------------------------
+    struct CacheLevel
+    {
+        const char* name;
+        double      bytes;
+    };
+
+    std::vector<CacheLevel> cacheLevels()
+    {
+        std::vector<CacheLevel> c;
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+        const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+        const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (l1 > 0) c.push_back({ "L1", static_cast<double>(l1) });
+        if (l2 > 0) c.push_back({ "L2", static_cast<double>(l2) });
+        if (l3 > 0) c.push_back({ "L3", static_cast<double>(l3) });
+#endif
+        return c;
+    }
+
+    const char* fits(const std::vector<CacheLevel>& caches, double bytes)
+    {
+        if (caches.empty())
+            return "-";
+        for (const CacheLevel& c : caches)
+            if (bytes <= c.bytes)
+                return c.name;
+        return "DRAM";
+    }
+
+    // ---------------------------------------------------------------------
+    // One cell: organisms x threads
+    // ---------------------------------------------------------------------
+    struct Cell
+    {
+        double seconds = 0.0;       // timed region
+        double steps   = 0.0;       // events applied in the timed region
+        double resets  = 0.0;
+        double errors  = 0.0;
+    };
+
+    StructuralState initialState(Workload w, Rng& rng)
+    {
+        StructuralState X;
+        X.reset();
+
+        if (w == Workload::Update)
+        {
+            // test_update_high_stress at 1/5 scale
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                X.Delta[k] = ((k & 1) ? -1.0 : 1.0) * rng.uniform(5.0, 10.0);
+            X.Phi   = rng.uniform(5.0, 10.0);
+            X.M     = rng.uniform(10.0, 20.0);
+            X.Kappa = rng.uniform(0.5, 1.0);
+        }
+        else
+        {
+            // test_gap_sequence_stability, jittered
+            const double base[4] = { 0.4, -0.2, 0.3, -0.1 };
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                X.Delta[k] = base[k % 4] * rng.uniform(0.5, 1.5);
+            X.Phi   = rng.uniform(1.0, 2.0);
+            X.M     = rng.uniform(4.0, 6.0);
+            X.Kappa = rng.uniform(0.8, 1.0);
+        }
+        return X;
+    }
+
+    // one event per organism, pushed in ring-sized chunks; run() timed
+    double updateRound(Fleet& fleet, std::size_t organisms, Rng& rng)
+    {
+        StructEvent E;
+        E.type = EventType::Update;
+        E.dt   = 0.1;
+
+        double      seconds = 0.0;
+        std::size_t next    = 0;
+        bool        pending = false;
+
+        for (;;)
+        {
+            while (next < organisms)
+            {
+                if (!pending)
+                {
+                    for (auto& v : E.stimulus) v = rng.uniform(-10.0, 10.0);
+                    pending = true;
+                }
+                if (!fleet.submit(static_cast<OrganismId>(next), E))
+                    break;
+                pending = false;
+                ++next;
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            fleet.run();
+            const auto t1 = std::chrono::steady_clock::now();
+            seconds += std::chrono::duration<double>(t1 - t0).count();
+
+            if (next == organisms)
+                return seconds;
+        }
+    }
+
+    double gapRound(Fleet& fleet)
+    {
+        StructEvent E;
+        E.type = EventType::Gap;
+        E.dt   = 1.0;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        fleet.broadcast(E);
+        const auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(t1 - t0).count();
+    }
+
+    Cell runCell(Workload w, std::size_t organisms, std::size_t threads, std::size_t min_events)
+    {
+        Cell cell;
+        Rng  rng{ 0x5CA1E ^ organisms };
+
+        FleetConfig cfg;
+        cfg.threads          = threads;
+        cfg.lifecycle        = LifecyclePolicy::AutoReset;
+        cfg.auto_reset_after = 0;
+
+        Fleet fleet(cfg);
+        for (std::size_t i = 0; i < organisms; ++i)
+            fleet.add(initialState(w, rng));
+
+        auto round = [&]
+        {
+            return (w == Workload::Update) ? updateRound(fleet, organisms, rng) : gapRound(fleet);
+        };
+
+        round();                                // first touch, warm caches
+
+        const std::size_t rounds = std::max<std::size_t>(3, (min_events + organisms - 1) / organisms);
+        const FleetStats  before = fleet.stats();
+
+        for (std::size_t r = 0; r < rounds; ++r)
+            cell.seconds += round();
+
+        const FleetStats after = fleet.stats();
+        cell.steps  = static_cast<double>(after.steps - before.steps);
+        cell.resets = static_cast<double>(after.auto_resets - before.auto_resets);
+        cell.errors = static_cast<double>(after.errors - before.errors);
+        return cell;
+    }
+
+    std::vector<std::size_t> parseList(const char* s)
+    {
+        std::vector<std::size_t> v;
+        while (*s)
+        {
+            char* end = nullptr;
+            const unsigned long x = std::strtoul(s, &end, 10);
+            if (end == s)
+                break;
+            if (x > 0)
+                v.push_back(static_cast<std::size_t>(x));
+            s = (*end == ',') ? end + 1 : end;
+        }
+        return v;
+    }
+
+    void usage()
+    {
+        std::fprintf(stderr,
+                     "usage: fmrt_bench_scaling [--max-organisms N] [--threads 1,2,4,...]\n"
+                     "                          [--min-events N] [--workload update|gap|all]\n"
+                     "                          [--csv FILE|-]\n");
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t              max_organisms = 10000000;
+    std::size_t              min_events    = std::size_t{1} << 22;
+    std::vector<std::size_t> threads;
+    std::vector<Workload>    workloads = { Workload::Update, Workload::Gap };
+    const char*              csv = nullptr;
+
+    for (int a = 1; a < argc; ++a)
+    {
+        const bool has_value = a + 1 < argc;
+
+        if (!std::strcmp(argv[a], "--max-organisms") && has_value)
+            max_organisms = std::strtoull(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "--min-events") && has_value)
+            min_events = std::strtoull(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "--threads") && has_value)
+            threads = parseList(argv[++a]);
+        else if (!std::strcmp(argv[a], "--csv") && has_value)
+            csv = argv[++a];
+        else if (!std::strcmp(argv[a], "--workload") && has_value)
+        {
+            const char* w = argv[++a];
+            if      (!std::strcmp(w, "update")) workloads = { Workload::Update };
+            else if (!std::strcmp(w, "gap"))    workloads = { Workload::Gap };
+            else if (!std::strcmp(w, "all"))    workloads = { Workload::Update, Workload::Gap };
+            else { usage(); return 2; }
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    // default: powers of two up to the hardware, plus the hardware count
+    if (threads.empty())
+    {
+        const std::size_t hw = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        for (std::size_t t = 1; t < hw; t *= 2)
+            threads.push_back(t);
+        threads.push_back(hw);
+    }
+    // efficiency is relative to one thread
+    if (std::find(threads.begin(), threads.end(), std::size_t{1}) == threads.end())
+        threads.insert(threads.begin(), 1);
+    std::sort(threads.begin(), threads.end());
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 1000; n <= max_organisms; n *= 10)
+        sizes.push_back(n);
+
+    const std::vector<CacheLevel> caches = cacheLevels();
+
+    std::FILE* out = nullptr;
+    if (csv)
+    {
+        out = !std::strcmp(csv, "-") ? stdout : std::fopen(csv, "w");
+        if (!out)
+        {
+            std::fprintf(stderr, "fmrt_bench_scaling: cannot open %s\n", csv);
+            return 1;
+        }
+    }
+
+    std::printf("fleet scaling, >= %zu events per cell, hardware threads %u\n",
+                min_events, std::thread::hardware_concurrency());
+    for (const CacheLevel& c : caches)
+        std::printf("  %s %.0f KiB\n", c.name, c.bytes / 1024.0);
+    std::printf("  %-7s %10s %7s %9s %5s %12s %9s %8s %6s %7s %7s\n",
+                "load", "organisms", "threads", "MiB", "fits", "steps/s", "ns/step", "GB/s", "eff",
+                "resets", "errors");
+
+    std::vector<std::string> rows;
+
+    for (Workload w : workloads)
+        for (std::size_t n : sizes)
+        {
+            const double columns = static_cast<double>(n) * STATE_BYTES;
+            double       base    = 0.0;         // steps/s at 1 thread
+
+            for (std::size_t t : threads)
+            {
+                const Cell c = runCell(w, n, t, min_events);
+
+                const double rate  = c.seconds > 0.0 ? c.steps / c.seconds : 0.0;
+                const double bytes = 2.0 * STATE_BYTES + (w == Workload::Update ? sizeof(FleetEvent) : 0.0);
+                const double gbs   = rate * bytes * 1e-9;
+                const double eff   = (t == 1) ? 1.0 : (base > 0.0 ? rate / (static_cast<double>(t) * base) : 0.0);
+                if (t == 1)
+                    base = rate;
+
+                const double share = c.steps > 0.0 ? 100.0 / c.steps : 0.0;
+
+                std::printf("  %-7s %10zu %7zu %9.2f %5s %12.4g %9.2f %8.2f %6.2f %6.2f%% %6.2f%%\n",
+                            workloadName(w), n, t, columns / (1024.0 * 1024.0), fits(caches, columns),
+                            rate, rate > 0.0 ? 1e9 / rate : 0.0, gbs, eff,
+                            c.resets * share, c.errors * share);
+                std::fflush(stdout);
+
+                if (out)
+                {
+                    char row[256];
+                    std::snprintf(row, sizeof(row), "%s,%zu,%zu,%.0f,%s,%.6g,%.6g,%.4f,%.0f,%.0f,%.0f",
+                                  workloadName(w), n, t, columns, fits(caches, columns),
+                                  rate, gbs, eff, c.steps, c.resets, c.errors);
+                    rows.push_back(row);
+                }
+            }
+        }
+
+    if (out)
+    {
+        std::fprintf(out, "workload,organisms,threads,state_bytes,fits,steps_per_s,est_gb_per_s,efficiency,steps,resets,errors\n");
+        for (const std::string& r : rows)
+            std::fprintf(out, "%s\n", r.c_str());
+        if (out != stdout)
+            std::fclose(out);
+    }
+
+    return 0;
+}
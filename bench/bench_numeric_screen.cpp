@@ -0,0 +1,172 @@
+//
+// FMRT Core V2.2
+// bench_numeric_screen.cpp
+//
+// Cost of the FMRT_Step entry screen: the original multi-pass checks
+// (isFinite + fpclassify per field, then EventHandler's isFinite again)
+// against the fused FpGuard exponent-bit screen.
+//
+// Output: ns and TSC cycles per screen, plus full FMRT_Step cost.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define FMRT_BENCH_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#   define FMRT_BENCH_HAS_TSC 1
+#endif
+
+#include "fmrt_api.hpp"
+#include "internal/fp_guard.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    // ---------------------------------------------------------------------
+    // Original entry checks of FMRT_Step (before the fused screen)
+    // ---------------------------------------------------------------------
+    inline bool is_denormal(double x)
+    {
+        return x != 0.0 && std::fpclassify(x) == FP_SUBNORMAL;
+    }
+
+    bool has_denormal(const StructuralState& X)
+    {
+        for (double v : X.Delta)
+            if (is_denormal(v)) return true;
+
+        return is_denormal(X.Phi) || is_denormal(X.M) || is_denormal(X.Kappa);
+    }
+
+    bool has_denormal(const StructEvent& E)
+    {
+        if (is_denormal(E.dt)) return true;
+
+        for (double v : E.stimulus)
+            if (is_denormal(v)) return true;
+
+        return false;
+    }
+
+    bool legacy_accept(const StructuralState& X, const StructEvent& E)
+    {
+        if (!X.isFinite() || !E.isFinite() || has_denormal(X) || has_denormal(E))
+            return false;
+
+        return E.isFinite();    // repeated by EventHandler::validate
+    }
+
+    inline std::uint64_t ticks()
+    {
+#if defined(FMRT_BENCH_HAS_TSC)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct Timing
+    {
+        double ns_per_op;
+        double cycles_per_op;
+    };
+
+    template <class F>
+    Timing measure(std::size_t ops, F&& body)
+    {
+        const auto          t0 = std::chrono::steady_clock::now();
+        const std::uint64_t c0 = ticks();
+        body();
+        const std::uint64_t c1 = ticks();
+        const auto          t1 = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        return { ns / static_cast<double>(ops),
+                 static_cast<double>(c1 - c0) / static_cast<double>(ops) };
+    }
+} // namespace
+
+int main()
+{
+    constexpr std::size_t COUNT  = 1024;
+    constexpr int         ROUNDS = 2000;
+    constexpr std::size_t OPS    = COUNT * ROUNDS;
+
+    std::vector<StructuralState> states(COUNT);
+    std::vector<StructEvent>     events(COUNT);
+
+    std::uint64_t s = 7;
+    auto uniform = [&s](double lo, double hi)
+    {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lo + (hi - lo) * (static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0));
+    };
+
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        states[i].reset();
+        for (auto& v : states[i].Delta) v = uniform(-5.0, 5.0);
+        states[i].Phi   = uniform(0.0, 10.0);
+        states[i].M     = uniform(0.0, 10.0);
+        states[i].Kappa = uniform(0.1, 1.0);
+
+        events[i].type = EventType::Update;
+        events[i].dt   = uniform(0.01, 0.5);
+        for (auto& v : events[i].stimulus) v = uniform(-1.0, 1.0);
+    }
+
+    const FpGuard fp{};
+    volatile unsigned sink = 0;
+
+    const Timing legacy = measure(OPS, [&]
+    {
+        unsigned acc = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += legacy_accept(states[i], events[i]) ? 1u : 0u;
+        sink = acc;
+    });
+
+    const Timing fused = measure(OPS, [&]
+    {
+        unsigned acc = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += FpGuard::numericReject(fp.screen(states[i]) | fp.screen(events[i]),
+                                              events[i].type) ? 0u : 1u;
+        sink = acc;
+    });
+
+    StateEnvelope env;
+    const Timing step = measure(OPS / 8, [&]
+    {
+        unsigned acc = 0;
+        for (int r = 0; r < ROUNDS / 8; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                FMRT_StepInto(states[i], events[i], env);
+                acc += static_cast<unsigned>(env.status);
+            }
+        sink = acc;
+    });
+
+    (void)sink;
+
+    std::printf("numeric screen, %zu state/event pairs x %d rounds\n", COUNT, ROUNDS);
+    std::printf("  legacy multi-pass : %7.2f ns  %7.1f cycles\n", legacy.ns_per_op, legacy.cycles_per_op);
+    std::printf("  fused exponent    : %7.2f ns  %7.1f cycles\n", fused.ns_per_op, fused.cycles_per_op);
+    std::printf("  saved per step    : %7.2f ns  %7.1f cycles\n",
+                legacy.ns_per_op - fused.ns_per_op,
+                legacy.cycles_per_op - fused.cycles_per_op);
+    std::printf("  FMRT_StepInto     : %7.2f ns  %7.1f cycles\n", step.ns_per_op, step.cycles_per_op);
+
+    return 0;
+}
@@ -0,0 +1,337 @@
+//
+// FMRT Core V2.2
+// bench_perf_counters.cpp
+//
+// Hardware performance counters around the step paths and the evolution
+// kernels (Linux, perf_event_open). Wall-clock time alone is too noisy on
+// shared hosts to judge an optimization; cycles, instructions (IPC),
+// branch misses and cache misses per step are not.
+//
+// Measured: FMRT_Step / FMRT_StepInPlace (UPDATE), FMRT_StepBatch per
+// organism, and the EvolutionEngine kernels computeCurvature,
+// computeDetG, computeTau and updateDelta (through EngineProbe, i.e. the
+// compiled kernels the pipeline calls).
+//
+// Counters are opened per event, user space only (works with
+// perf_event_paranoid <= 2), and scaled by time_enabled / time_running
+// when the PMU multiplexes. A counter the host does not provide (VMs
+// often expose no PMU) is reported as "-"; the software task-clock is
+// always available and gives CPU time per op without scheduler gaps.
+//
+// Output: one row per subject, every column per op.
+//
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "fmrt_api.hpp"
+#include "internal/kernel_probe.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    // ---------------------------------------------------------------------
+    // Counters
+    // ---------------------------------------------------------------------
+    enum Counter : std::size_t
+    {
+        TASK_CLOCK = 0,
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_MISSES,
+        LLC_MISSES,
+        COUNTERS
+    };
+
+    const char* const COUNTER_NAME[COUNTERS] = {
+        "task-clock", "cycles", "instructions", "branch-misses", "L1D-read-misses", "LLC-read-misses"
+    };
+
+    constexpr std::uint64_t cacheConfig(std::uint64_t cache)
+    {
+        return cache |
+               (std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+               (std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+    }
+
+    int openCounter(std::uint32_t type, std::uint64_t config)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    class PerfCounters
+    {
+    public:
+        PerfCounters()
+        {
+            open(TASK_CLOCK,    PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+            open(CYCLES,        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            open(INSTRUCTIONS,  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            open(BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+            open(L1D_MISSES,    PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D));
+            open(LLC_MISSES,    PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_LL));
+        }
+
+        ~PerfCounters()
+        {
+            for (int f : fd)
+                if (f >= 0)
+                    close(f);
+        }
+
+        PerfCounters(const PerfCounters&)            = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available(std::size_t c) const noexcept { return fd[c] >= 0; }
+
+        void report(std::FILE* out) const
+        {
+            for (std::size_t c = 0; c < COUNTERS; ++c)
+                if (!available(c))
+                    std::fprintf(out, "  %-16s unavailable (%s)\n", COUNTER_NAME[c], std::strerror(error[c]));
+        }
+
+        void start()
+        {
+            for (int f : fd)
+                if (f >= 0)
+                {
+                    ioctl(f, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(f, PERF_EVENT_IOC_ENABLE, 0);
+                }
+        }
+
+        // counts since start(), scaled for multiplexing; -1: unavailable
+        void stop(double (&value)[COUNTERS])
+        {
+            for (int f : fd)
+                if (f >= 0)
+                    ioctl(f, PERF_EVENT_IOC_DISABLE, 0);
+
+            for (std::size_t c = 0; c < COUNTERS; ++c)
+            {
+                value[c] = -1.0;
+
+                std::uint64_t r[3];     // value, time_enabled, time_running
+                if (fd[c] < 0 || read(fd[c], r, sizeof(r)) != static_cast<ssize_t>(sizeof(r)) || r[2] == 0)
+                    continue;
+
+                value[c] = static_cast<double>(r[0]) *
+                           (static_cast<double>(r[1]) / static_cast<double>(r[2]));
+            }
+        }
+
+    private:
+        void open(std::size_t c, std::uint32_t type, std::uint64_t config)
+        {
+            fd[c]    = openCounter(type, config);
+            error[c] = (fd[c] < 0) ? errno : 0;
+        }
+
+        int fd[COUNTERS];
+        int error[COUNTERS];
+    };
+
+    // ---------------------------------------------------------------------
+    // Measurement
+    // ---------------------------------------------------------------------
+    template <class F>
+    void measure(PerfCounters& pc, const char* name, std::size_t ops, F&& body)
+    {
+        body();                                 // warm caches and branch predictors
+
+        double v[COUNTERS];
+        const auto t0 = std::chrono::steady_clock::now();
+        pc.start();
+        body();
+        pc.stop(v);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double n  = static_cast<double>(ops);
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+
+        auto cell = [&](std::size_t c, const char* fmt)
+        {
+            if (v[c] < 0.0) std::printf("%10s", "-");
+            else            std::printf(fmt, v[c] / n);
+        };
+
+        std::printf("  %-22s %9.2f", name, ns);
+        cell(TASK_CLOCK, "%10.2f");
+        cell(CYCLES, "%10.1f");
+        cell(INSTRUCTIONS, "%10.1f");
+        if (v[CYCLES] > 0.0 && v[INSTRUCTIONS] >= 0.0)
+            std::printf("%7.2f", v[INSTRUCTIONS] / v[CYCLES]);
+        else
+            std::printf("%7s", "-");
+        cell(BRANCH_MISSES, "%10.3f");
+        cell(L1D_MISSES, "%10.3f");
+        cell(LLC_MISSES, "%10.4f");
+        std::printf("\n");
+    }
+
+    struct Rng
+    {
+        std::uint64_t s;
+
+        double uniform(double lo, double hi)
+        {
+            s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+            return lo + (hi - lo) * (static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0));
+        }
+    };
+} // namespace
+
+int main()
+{
+    constexpr std::size_t COUNT  = 4096;
+    constexpr std::size_t ROUNDS = 64;
+    constexpr std::size_t OPS    = COUNT * ROUNDS;
+
+    Rng rng{ 5 };
+
+    std::vector<StructuralState> states(COUNT);
+    std::vector<StructEvent>     events(COUNT);
+    std::vector<double>          kappa(COUNT), curvature(COUNT);
+
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        states[i].reset();
+        for (auto& v : states[i].Delta) v = rng.uniform(-5.0, 5.0);
+        states[i].Phi   = rng.uniform(0.0, 10.0);
+        states[i].M     = rng.uniform(0.0, 10.0);
+        states[i].Kappa = rng.uniform(0.1, 1.0);
+
+        events[i].type = EventType::Update;
+        events[i].dt   = rng.uniform(0.01, 0.5);
+        for (auto& v : events[i].stimulus) v = rng.uniform(-1.0, 1.0);
+
+        kappa[i]     = states[i].Kappa;
+        curvature[i] = rng.uniform(0.0, 40.0);
+    }
+
+    // batch columns, refilled from `states` before every pass (the refill
+    // is part of the FMRT_StepBatch row, ~one state copy per organism)
+    std::vector<double> cols[DELTA_DIM];
+    std::vector<double> phi(COUNT), m(COUNT), kap(COUNT);
+    std::vector<Regime> prev(COUNT);
+    for (auto& c : cols) c.resize(COUNT);
+
+    StateColumns X;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) X.Delta[k] = cols[k].data();
+    X.Phi = phi.data();
+    X.M = m.data();
+    X.Kappa = kap.data();
+    X.RegimePrev = prev.data();
+
+    PerfCounters pc;
+    const EvolutionEngine engine{};
+    using Probe = EngineProbe<DELTA_DIM>;
+
+    volatile double sink = 0.0;
+
+    std::printf("perf counters, %zu organisms x %zu rounds (per op)\n", COUNT, ROUNDS);
+    pc.report(stdout);
+    std::printf("  %-22s %9s%10s%10s%10s%7s%10s%10s%10s\n",
+                "subject", "wall ns", "task ns", "cycles", "instr", "IPC",
+                "br-miss", "L1D-miss", "LLC-miss");
+
+    measure(pc, "FMRT_Step", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += FMRT_Step(states[i], events[i]).metrics.tau;
+        sink = acc;
+    });
+
+    measure(pc, "FMRT_StepInPlace", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                StructuralState Y = states[i];
+                FMRT_StepInPlace(Y, events[i]);
+                acc += Y.Kappa;
+            }
+        sink = acc;
+    });
+
+    measure(pc, "FMRT_StepBatch", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+        {
+            for (std::size_t i = 0; i < COUNT; ++i)
+                X.store(i, states[i]);
+            FMRT_StepBatch(X, events.data(), COUNT, X, EnvelopeColumns{});
+            acc += X.Kappa[r % COUNT];
+        }
+        sink = acc;
+    });
+
+    measure(pc, "computeCurvature", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += Probe::computeCurvature(engine, states[i]);
+        sink = acc;
+    });
+
+    measure(pc, "computeDetG", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += Probe::computeDetG(engine, curvature[i], kappa[i]);
+        sink = acc;
+    });
+
+    measure(pc, "computeTau", OPS, [&]
+    {
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+                acc += Probe::computeTau(engine, kappa[i]);
+        sink = acc;
+    });
+
+    measure(pc, "updateDelta", OPS, [&]
+    {
+        StructuralState out;
+        double acc = 0.0;
+        for (std::size_t r = 0; r < ROUNDS; ++r)
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                Probe::updateDelta(engine, states[i], events[i], 0.5, out);
+                acc += out.Delta[0];
+            }
+        sink = acc;
+    });
+
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,168 @@
+#pragma once
+//
+// FMRT Core V2.2
+// bench_runner.hpp
+//
+// Minimal micro-benchmark runner for fmrt_bench.
+//
+//   BenchRunner runner(options);
+//   runner.run("step/update", [&](std::size_t iters) { ...iters ops... });
+//   runner.writeJson(file);
+//
+// Per benchmark:
+//   - calibration: the iteration count doubles until one repetition lasts
+//     at least min_time_ms (timer resolution and call overhead vanish)
+//   - warmup repetitions, not recorded
+//   - `repetitions` timed repetitions; ns/op of each one
+//   - reported: median, p99 (nearest rank), min and mean ns/op
+//
+// The body must perform exactly `iters` operations and feed its results
+// to a sink the compiler cannot drop (see BenchRunner::sink).
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fmrt
+{
+    struct BenchOptions
+    {
+        std::size_t warmup      = 3;
+        std::size_t repetitions = 25;
+        double      min_time_ms = 5.0;
+        std::string filter;                 // substring of the benchmark name; empty: all
+    };
+
+    struct BenchResult
+    {
+        std::string name;
+        std::size_t iterations  = 0;        // ops per repetition
+        std::size_t repetitions = 0;
+        double      median_ns   = 0.0;      // per op
+        double      p99_ns      = 0.0;
+        double      min_ns      = 0.0;
+        double      mean_ns     = 0.0;
+    };
+
+#if !(defined(__GNUC__) || defined(__clang__))
+    // BenchRunner::sink without inline asm
+    inline volatile unsigned char bench_sink_byte = 0;
+#endif
+
+    class BenchRunner
+    {
+    public:
+        explicit BenchRunner(const BenchOptions& options) : opt(options) {}
+
+        template <class Body>
+        void run(const char* name, Body&& body)
+        {
+            if (!opt.filter.empty() && std::strstr(name, opt.filter.c_str()) == nullptr)
+                return;
+
+            std::size_t iters = 1;
+            while (timeNs(body, iters) < opt.min_time_ms * 1e6 && iters < (std::size_t{1} << 40))
+                iters *= 2;
+
+            for (std::size_t w = 0; w < opt.warmup; ++w)
+                timeNs(body, iters);
+
+            std::vector<double> per_op(std::max<std::size_t>(opt.repetitions, 1));
+            for (double& v : per_op)
+                v = timeNs(body, iters) / static_cast<double>(iters);
+
+            std::sort(per_op.begin(), per_op.end());
+
+            BenchResult r;
+            r.name        = name;
+            r.iterations  = iters;
+            r.repetitions = per_op.size();
+            r.median_ns   = nearestRank(per_op, 0.50);
+            r.p99_ns      = nearestRank(per_op, 0.99);
+            r.min_ns      = per_op.front();
+            for (double v : per_op)
+                r.mean_ns += v / static_cast<double>(per_op.size());
+
+            std::printf("  %-32s %10.2f %10.2f %10.2f  x%zu\n",
+                        r.name.c_str(), r.median_ns, r.p99_ns, r.min_ns, r.iterations);
+            std::fflush(stdout);
+
+            results.push_back(r);
+        }
+
+        void printHeader() const
+        {
+            std::printf("  %-32s %10s %10s %10s  %s\n", "benchmark", "median ns", "p99 ns", "min ns", "ops/rep");
+        }
+
+        // {"suite":..., "context":{...}, "benchmarks":[...]}
+        void writeJson(std::FILE* out, const char* suite,
+                       const std::vector<std::pair<std::string, std::string>>& context) const
+        {
+            std::fprintf(out, "{\n  \"suite\": \"%s\",\n  \"context\": {", suite);
+            for (std::size_t i = 0; i < context.size(); ++i)
+                std::fprintf(out, "%s\n    \"%s\": \"%s\"", i ? "," : "",
+                             context[i].first.c_str(), context[i].second.c_str());
+            std::fprintf(out, "\n  },\n  \"benchmarks\": [");
+
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const BenchResult& r = results[i];
+                std::fprintf(out,
+                             "%s\n    {\"name\": \"%s\", \"unit\": \"ns/op\", "
+                             "\"median\": %.4f, \"p99\": %.4f, \"min\": %.4f, \"mean\": %.4f, "
+                             "\"iterations\": %zu, \"repetitions\": %zu}",
+                             i ? "," : "", r.name.c_str(), r.median_ns, r.p99_ns, r.min_ns,
+                             r.mean_ns, r.iterations, r.repetitions);
+            }
+            std::fprintf(out, "\n  ]\n}\n");
+        }
+
+        const std::vector<BenchResult>& all() const noexcept { return results; }
+
+        // keeps a computed value alive without a measurable cost: the
+        // compiler must assume the empty asm reads all of v
+        template <class T>
+        static void sink(const T& v) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r"(&v) : "memory");
+#else
+            unsigned char b = 0;
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(&v);
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+                b ^= p[i];
+            bench_sink_byte = static_cast<unsigned char>(bench_sink_byte ^ b);
+#endif
+        }
+
+    private:
+        template <class Body>
+        static double timeNs(Body& body, std::size_t iters)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            body(iters);
+            const auto t1 = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+
+        // sorted input
+        static double nearestRank(const std::vector<double>& v, double q)
+        {
+            std::size_t rank = static_cast<std::size_t>(q * static_cast<double>(v.size()) + 0.999999);
+            rank = std::min(std::max<std::size_t>(rank, 1), v.size());
+            return v[rank - 1];
+        }
+
+        BenchOptions             opt;
+        std::vector<BenchResult> results;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,142 @@
+//
+// FMRT Core V2.2
+// bench_sorted_batch.cpp
+//
+// Event batches interleaved across many organisms: FMRT_StepInPlace in
+// arrival order against SortedEventBatch::step (radix sort by organism,
+// runs stepped back to back, next state prefetched).
+//
+// Output: ns per event for both, for pools from cache-resident to far
+// larger than the last-level cache. Both modes step the same batches on
+// their own copy of the pool; the final states are compared.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_organism_pool.hpp"
+#include "fmrt_sorted_batch.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    struct Rng
+    {
+        std::uint64_t s;
+
+        std::uint64_t next()
+        {
+            s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+            return s >> 11;
+        }
+
+        double uniform(double lo, double hi)
+        {
+            return lo + (hi - lo) * (static_cast<double>(next()) * (1.0 / 9007199254740992.0));
+        }
+    };
+
+    OrganismPool makePool(std::size_t organisms)
+    {
+        Rng rng{ 11 };
+
+        OrganismPool pool;
+        pool.reserve(organisms);
+        for (std::size_t i = 0; i < organisms; ++i)
+        {
+            StructuralState X;
+            X.reset();
+            for (auto& v : X.Delta) v = rng.uniform(-5.0, 5.0);
+            X.Phi   = rng.uniform(0.0, 10.0);
+            X.M     = rng.uniform(0.0, 10.0);
+            X.Kappa = rng.uniform(0.5, 1.0);
+            pool.insert(X);
+        }
+        return pool;
+    }
+
+    // events of `organisms` random organisms, mostly updates
+    std::vector<FleetEvent> makeBatch(Rng& rng, std::size_t organisms, std::size_t n)
+    {
+        std::vector<FleetEvent> batch(n);
+        for (FleetEvent& e : batch)
+        {
+            e.id   = static_cast<OrganismId>(rng.next() % organisms);
+            e.type = (rng.next() % 4 == 0) ? EventType::Heartbeat : EventType::Update;
+            e.dt   = rng.uniform(0.001, 0.01);
+            if (e.type == EventType::Update)
+                for (auto& v : e.stimulus) v = rng.uniform(-0.1, 0.1);
+        }
+        return batch;
+    }
+
+    bool sameStates(const OrganismPool& a, const OrganismPool& b)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            const StructuralState x = a.loadDense(i);
+            const StructuralState y = b.loadDense(i);
+            if (std::memcmp(x.Delta.data(), y.Delta.data(), sizeof(double) * DELTA_DIM) != 0 ||
+                std::memcmp(&x.Phi, &y.Phi, sizeof(double)) != 0 ||
+                std::memcmp(&x.M, &y.M, sizeof(double)) != 0 ||
+                std::memcmp(&x.Kappa, &y.Kappa, sizeof(double)) != 0 ||
+                x.RegimePrev != y.RegimePrev)
+                return false;
+        }
+        return true;
+    }
+
+    void run(std::size_t organisms, std::size_t batch_size, std::size_t batches)
+    {
+        OrganismPool arrival = makePool(organisms);
+        OrganismPool sorted  = makePool(organisms);
+
+        Rng rng{ 29 };
+        std::vector<std::vector<FleetEvent>> input;
+        for (std::size_t b = 0; b < batches; ++b)
+            input.push_back(makeBatch(rng, organisms, batch_size));
+
+        const StateColumns A = arrival.columns();
+        const StateColumns S = sorted.columns();
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const auto& batch : input)
+            for (const FleetEvent& e : batch)
+            {
+                StructuralState X = A.load(e.id);
+                FMRT_StepInPlace(X, e.event());
+                A.store(e.id, X);
+            }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        SortedEventBatch grouped;
+        for (const auto& batch : input)
+            grouped.step(S, batch.data(), batch.size());
+        const auto t2 = std::chrono::steady_clock::now();
+
+        const double events = static_cast<double>(batch_size * batches);
+        const double ns_arrival = std::chrono::duration<double, std::nano>(t1 - t0).count() / events;
+        const double ns_sorted  = std::chrono::duration<double, std::nano>(t2 - t1).count() / events;
+
+        std::printf("  %8zu organisms %7zu events/batch : arrival %7.1f ns  sorted %7.1f ns  x%.2f%s\n",
+                    organisms, batch_size, ns_arrival, ns_sorted, ns_arrival / ns_sorted,
+                    sameStates(arrival, sorted) ? "" : "  STATES DIFFER");
+    }
+} // namespace
+
+int main()
+{
+    std::printf("interleaved event batches, ns per event (arrival order vs sorted)\n");
+
+    run(4096,        65536, 16);    // pool in L2
+    run(65536,       65536, 16);    // ~4 MB of state
+    run(1u << 20,    65536, 16);    // ~70 MB: sparse runs
+    run(1u << 20, 1u << 20,  4);    // ~70 MB: one event per organism on average
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+//
+// FMRT Core V2.2
+// bench_trajectory.cpp
+//
+// Trajectory store (fmrt_trajectory.hpp) against a raw dump of the
+// envelopes (array of { id, step, StateEnvelope }).
+//
+// Rows: MarketWorkload rounds over a fleet, stepped with FMRT_Step,
+// appended in arrival order (organisms interleaved). Output:
+//   - file size against the raw dump, encoded bytes per column per row
+//   - write and full decode (checksums verified) in ns per row
+//   - scan of one column (min κ, rows below a threshold): single-column
+//     decode against a strided pass over the raw array
+//   - the same query restricted by block statistics (mayContain)
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_trajectory.hpp"
+#include "fmrt_workload.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    struct Row
+    {
+        OrganismId    id;
+        std::uint64_t step;
+        StateEnvelope env;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double nsPerRow(Clock::time_point t0, Clock::time_point t1, std::size_t rows)
+    {
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(rows);
+    }
+
+    std::vector<Row> makeRows(OrganismId organisms, std::size_t rounds)
+    {
+        WorkloadConfig wc;
+        wc.seed = 5;
+        const MarketWorkload w(wc);
+
+        std::vector<StructuralState> X(organisms);
+        for (StructuralState& x : X)
+            x.reset();
+
+        std::vector<FleetEvent> round(organisms);
+        std::vector<Row>        rows;
+        rows.reserve(std::size_t{organisms} * rounds);
+        for (std::size_t i = 0; i < rounds; ++i)
+        {
+            w.round(i, 0, organisms, round.data());
+            for (const FleetEvent& e : round)
+            {
+                const StateEnvelope env = FMRT_Step(X[e.id], e.event());
+                if (env.status != StepStatus::ERROR)
+                    X[e.id] = env.state;
+                rows.push_back({ e.id, i, env });
+            }
+        }
+        return rows;
+    }
+
+    struct Scan
+    {
+        double      min   = std::numeric_limits<double>::infinity();
+        std::size_t below = 0;
+
+        void add(double k, double threshold)
+        {
+            min    = std::min(min, k);
+            below += k < threshold;
+        }
+    };
+} // namespace
+
+int main()
+{
+    constexpr OrganismId  ORGANISMS = 500;
+    constexpr std::size_t ROUNDS    = 1000;
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "fmrt_bench_trajectory.bin").string();
+
+    const std::vector<Row> rows = makeRows(ORGANISMS, ROUNDS);
+    const std::size_t      n    = rows.size();
+
+    // --- write -----------------------------------------------------------------
+    TrajectoryWriter wr;
+    if (!wr.open(path.c_str()))
+    {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), wr.error().c_str());
+        return 1;
+    }
+    const auto w0 = Clock::now();
+    for (const Row& r : rows)
+        wr.append(r.id, r.step, r.env);
+    wr.close();
+    const auto w1 = Clock::now();
+
+    const double raw    = static_cast<double>(n * sizeof(Row));
+    const double stored = static_cast<double>(wr.bytes());
+
+    std::printf("trajectory store: %u organisms x %zu rounds = %zu rows\n", ORGANISMS, ROUNDS, n);
+    std::printf("  raw dump %10.0f bytes (%zu B/row)\n", raw, sizeof(Row));
+    std::printf("  store    %10.0f bytes (%.1f B/row)  x%.1f smaller\n", stored, stored / n, raw / stored);
+
+    std::printf("  bytes per row by column:\n");
+    for (std::size_t c = 0; c < TRAJ_COLUMNS; ++c)
+        std::printf("    %-20s %7.3f\n", trajectoryColumnName(c),
+                    static_cast<double>(wr.columnBytes()[c]) / static_cast<double>(n));
+
+    // --- read ------------------------------------------------------------------
+    TrajectoryReader rd;
+    if (!rd.open(path.c_str()))
+    {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), rd.error().c_str());
+        return 1;
+    }
+
+    TrajectoryBlock blk;
+    const auto d0 = Clock::now();
+    for (std::size_t b = 0; b < rd.blocks(); ++b)
+        rd.decode(b, blk);
+    const auto d1 = Clock::now();
+
+    // κ below the value reached by the lowest tenth of the rows
+    std::vector<double> kappa(n);
+    for (std::size_t j = 0; j < n; ++j)
+        kappa[j] = rows[j].env.state.Kappa;
+    std::nth_element(kappa.begin(), kappa.begin() + n / 10, kappa.end());
+    const double threshold = kappa[n / 10];
+
+    const auto s0 = Clock::now();
+    Scan aos;
+    for (const Row& r : rows)
+        aos.add(r.env.state.Kappa, threshold);
+    const auto s1 = Clock::now();
+
+    Scan col;
+    for (std::size_t b = 0; b < rd.blocks(); ++b)
+    {
+        rd.decode(b, blk, trajColumn(TRAJ_KAPPA));
+        const double* k = blk.reals(TRAJ_KAPPA);
+        for (std::size_t j = 0; j < blk.rows; ++j)
+            col.add(k[j], threshold);
+    }
+    const auto s2 = Clock::now();
+
+    Scan skip;
+    std::size_t decoded = 0;
+    for (std::size_t b = 0; b < rd.blocks(); ++b)
+    {
+        if (!rd.mayContain(b, TRAJ_KAPPA, -std::numeric_limits<double>::infinity(), threshold))
+            continue;
+        ++decoded;
+        rd.decode(b, blk, trajColumn(TRAJ_KAPPA));
+        const double* k = blk.reals(TRAJ_KAPPA);
+        for (std::size_t j = 0; j < blk.rows; ++j)
+            if (k[j] < threshold)
+                ++skip.below;
+    }
+    const auto s3 = Clock::now();
+
+    std::printf("  write                   %7.1f ns/row\n", nsPerRow(w0, w1, n));
+    std::printf("  decode, all columns     %7.1f ns/row\n", nsPerRow(d0, d1, n));
+    std::printf("  kappa < %.4f: raw strided %7.2f ns/row, column %7.2f ns/row, "
+                "block stats %7.2f ns/row (%zu of %zu blocks decoded)%s\n",
+                threshold, nsPerRow(s0, s1, n), nsPerRow(s1, s2, n), nsPerRow(s2, s3, n), decoded,
+                rd.blocks(),
+                aos.min == col.min && aos.below == col.below && aos.below == skip.below ? "" : "  MISMATCH");
+
+    rd.close();
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,413 @@
+//
+// FMRT Core V2.2
+// fmrt_bench.cpp
+//
+// Micro-benchmark suite of the scalar step and its kernels, with
+// machine-readable output for regression tracking.
+//
+//   fmrt_bench [--filter SUBSTR] [--reps N] [--warmup N] [--min-time-ms T]
+//              [--json FILE|-]
+//
+// Benchmarks (ns per op, each over a pool of POOL distinct inputs):
+//   step/<type>              FMRT_StepInto per event type
+//   step/collapsed           κ <= EPS_KAPPA: evolve's early collapse return
+//   step/numeric_reject      NaN stimulus: rejected by the entry screen
+//   step_in_place/update     FMRT_StepInPlace, carried-metrics chain
+//   engine/<kernel>          EvolutionEngine::evolve and every helper
+//   validator/<check>        InvariantValidator::validate and every check
+//
+// Engine and validator helpers are called through kernel_probe.hpp, i.e.
+// the compiled members the pipeline uses. Validator inputs are real
+// (X, X_next, metrics) triples produced by evolve.
+//
+// JSON (--json): {"suite", "context", "benchmarks": [{name, unit, median,
+// p99, min, mean, iterations, repetitions}]}; "-" writes to stdout after
+// the table.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "internal/kernel_probe.hpp"
+#include "bench_runner.hpp"
+
+using namespace fmrt;
+
+namespace
+{
+    constexpr std::size_t POOL = 1024;      // power of two: index = i & MASK
+    constexpr std::size_t MASK = POOL - 1;
+
+    struct Rng
+    {
+        std::uint64_t s;
+
+        double uniform(double lo, double hi)
+        {
+            s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+            return lo + (hi - lo) * (static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0));
+        }
+    };
+
+    StructuralState randomState(Rng& rng)
+    {
+        StructuralState X;
+        X.reset();
+        for (auto& v : X.Delta) v = rng.uniform(-5.0, 5.0);
+        X.Phi   = rng.uniform(0.0, 10.0);
+        X.M     = rng.uniform(0.0, 10.0);
+        X.Kappa = rng.uniform(0.1, 1.0);
+        return X;
+    }
+
+    StructEvent randomEvent(Rng& rng, EventType type)
+    {
+        StructEvent E;
+        E.type = type;
+        E.dt   = rng.uniform(0.01, 0.5);
+        if (type == EventType::Update)
+            for (auto& v : E.stimulus) v = rng.uniform(-1.0, 1.0);
+        return E;
+    }
+
+    struct Inputs
+    {
+        std::vector<StructuralState> states, collapsed, next;
+        std::vector<StructEvent>     update, gap, heartbeat, reset, rejected;
+        std::vector<DerivedMetrics>  metrics;               // of next[i]
+        std::vector<double>          R, mu, tau, kappa, norm2;
+        std::vector<MorphologyClass> morph;
+        std::vector<Regime>          regime;
+
+        Inputs()
+        {
+            Rng rng{ 7 };
+            const EvolutionEngine engine{};
+
+            for (std::size_t i = 0; i < POOL; ++i)
+            {
+                states.push_back(randomState(rng));
+
+                StructuralState C = states.back();
+                C.Kappa = 0.5 * EPS_KAPPA;
+                collapsed.push_back(C);
+
+                update.push_back(randomEvent(rng, EventType::Update));
+                gap.push_back(randomEvent(rng, EventType::Gap));
+                heartbeat.push_back(randomEvent(rng, EventType::Heartbeat));
+                reset.push_back(randomEvent(rng, EventType::Reset));
+
+                StructEvent bad = update.back();
+                bad.stimulus[i % DELTA_DIM] = std::numeric_limits<double>::quiet_NaN();
+                rejected.push_back(bad);
+
+                StructuralState Y;
+                DerivedMetrics  M;
+                engine.evolve(states[i], update[i], Y, M);
+                next.push_back(Y);
+                metrics.push_back(M);
+
+                R.push_back(M.curvature_R);
+                mu.push_back(M.mu);
+                tau.push_back(M.tau);
+                kappa.push_back(Y.Kappa);
+                norm2.push_back(EngineProbe<DELTA_DIM>::deltaNorm2(engine, Y));
+                morph.push_back(M.morph_class);
+                regime.push_back(Y.RegimePrev);
+            }
+        }
+    };
+
+    void usage()
+    {
+        std::fprintf(stderr,
+                     "usage: fmrt_bench [--filter SUBSTR] [--reps N] [--warmup N]\n"
+                     "                  [--min-time-ms T] [--json FILE|-]\n");
+    }
+
+    // ---------------------------------------------------------------------
+    // Suites
+    // ---------------------------------------------------------------------
+    void benchStep(BenchRunner& run, const Inputs& in)
+    {
+        auto stepOver = [&](const std::vector<StructuralState>& X, const std::vector<StructEvent>& E)
+        {
+            return [&X, &E](std::size_t iters)
+            {
+                StateEnvelope env;
+                double acc = 0.0;
+                for (std::size_t i = 0; i < iters; ++i)
+                {
+                    FMRT_StepInto(X[i & MASK], E[i & MASK], env);
+                    acc += env.state.Kappa;
+                }
+                BenchRunner::sink(acc);
+            };
+        };
+
+        run.run("step/update",         stepOver(in.states, in.update));
+        run.run("step/gap",            stepOver(in.states, in.gap));
+        run.run("step/heartbeat",      stepOver(in.states, in.heartbeat));
+        run.run("step/reset",          stepOver(in.states, in.reset));
+        run.run("step/collapsed",      stepOver(in.collapsed, in.update));
+        run.run("step/numeric_reject", stepOver(in.states, in.rejected));
+
+        run.run("step_in_place/update", [&](std::size_t iters)
+        {
+            StructuralState X = in.states[0];
+            CarriedMetrics  carry;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                // restart the chain from a fresh state every POOL steps so
+                // it does not drift into collapse
+                if ((i & MASK) == 0)
+                    X = in.states[(i / POOL) & MASK];
+                FMRT_StepInPlace(X, in.update[i & MASK], carry);
+                acc += X.Kappa;
+            }
+            BenchRunner::sink(acc);
+        });
+    }
+
+    void benchEngine(BenchRunner& run, const Inputs& in)
+    {
+        using Probe = EngineProbe<DELTA_DIM>;
+        const EvolutionEngine engine{};
+
+        run.run("engine/evolve", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            DerivedMetrics  M;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                engine.evolve(in.states[i & MASK], in.update[i & MASK], Y, M);
+                acc += Y.Kappa;
+            }
+            BenchRunner::sink(acc);
+        });
+
+        run.run("engine/updateDelta", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                Probe::updateDelta(engine, in.states[i & MASK], in.update[i & MASK], in.mu[i & MASK], Y);
+                acc += Y.Delta[0];
+            }
+            BenchRunner::sink(acc);
+        });
+
+        run.run("engine/updatePhi", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                Y = in.next[i & MASK];
+                Probe::updatePhi(engine, in.states[i & MASK], in.update[i & MASK], Y, Y);
+                acc += Y.Phi;
+            }
+            BenchRunner::sink(acc);
+        });
+
+        run.run("engine/updateMemory", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                Probe::updateMemory(engine, in.states[i & MASK], in.tau[i & MASK], in.update[i & MASK], Y);
+                acc += Y.M;
+            }
+            BenchRunner::sink(acc);
+        });
+
+        run.run("engine/updateKappa", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                Probe::updateKappa(engine, in.states[i & MASK], in.R[i & MASK], in.mu[i & MASK],
+                                   in.update[i & MASK], Y);
+                acc += Y.Kappa;
+            }
+            BenchRunner::sink(acc);
+        });
+
+        auto scalar = [&](const char* name, auto&& f)
+        {
+            run.run(name, [&](std::size_t iters)
+            {
+                double acc = 0.0;
+                for (std::size_t i = 0; i < iters; ++i)
+                    acc += f(i & MASK);
+                BenchRunner::sink(acc);
+            });
+        };
+
+        scalar("engine/computeCurvature", [&](std::size_t i) { return Probe::computeCurvature(engine, in.states[i]); });
+        scalar("engine/deltaNorm2",       [&](std::size_t i) { return Probe::deltaNorm2(engine, in.states[i]); });
+        scalar("engine/curvatureFrom",    [&](std::size_t i) { return Probe::curvatureFrom(engine, in.norm2[i], in.next[i]); });
+        scalar("engine/computeDetG",      [&](std::size_t i) { return Probe::computeDetG(engine, in.R[i], in.kappa[i]); });
+        scalar("engine/computeTau",       [&](std::size_t i) { return Probe::computeTau(engine, in.kappa[i]); });
+        scalar("engine/computeMu",        [&](std::size_t i) { return Probe::computeMu(engine, in.R[i]); });
+
+        scalar("engine/classifyMorphology", [&](std::size_t i)
+        {
+            return static_cast<double>(Probe::classifyMorphology(engine, in.mu[i]));
+        });
+
+        scalar("engine/computeRegime", [&](std::size_t i)
+        {
+            return static_cast<double>(Probe::computeRegime(engine, in.regime[(i + 1) & MASK],
+                                                            in.morph[i], in.kappa[i]));
+        });
+
+        run.run("engine/processCollapse", [&](std::size_t iters)
+        {
+            StructuralState Y;
+            DerivedMetrics  M;
+            double acc = 0.0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                Y = in.collapsed[i & MASK];
+                Probe::processCollapse(engine, Y, M);
+                acc += M.det_g;
+            }
+            BenchRunner::sink(acc);
+        });
+    }
+
+    void benchValidator(BenchRunner& run, const Inputs& in)
+    {
+        using Probe = ValidatorProbe<DELTA_DIM>;
+        const InvariantValidator validator{};
+
+        run.run("validator/validate", [&](std::size_t iters)
+        {
+            InvariantStatus st;
+            std::uint32_t acc = 0;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                validator.validate(in.states[i & MASK], in.next[i & MASK], in.metrics[i & MASK], st);
+                acc += st.flags;
+            }
+            BenchRunner::sink(acc);
+        });
+
+        // every check runs on a fresh status, as in validate()
+        auto check = [&](const char* name, auto&& f)
+        {
+            run.run(name, [&](std::size_t iters)
+            {
+                std::uint32_t acc = 0;
+                for (std::size_t i = 0; i < iters; ++i)
+                {
+                    InvariantStatus st;
+                    acc += static_cast<std::uint32_t>(f(i & MASK, st)) + st.flags;
+                }
+                BenchRunner::sink(acc);
+            });
+        };
+
+        check("validator/checkMemory", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkMemory(validator, in.states[i], in.next[i], st);
+        });
+        check("validator/checkKappa", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkKappa(validator, in.next[i], st);
+        });
+        check("validator/checkMetric", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkMetric(validator, in.next[i], in.metrics[i], st);
+        });
+        check("validator/checkTau", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkTau(validator, in.next[i], in.metrics[i], st);
+        });
+        check("validator/checkMorphology", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkMorphology(validator, in.metrics[i], st);
+        });
+        check("validator/checkRegime", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkRegime(validator, in.states[i].RegimePrev, in.metrics[i].regime, st);
+        });
+        check("validator/checkCollapse", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkCollapse(validator, in.next[i], in.metrics[i], st);
+        });
+        check("validator/checkForbidden", [&](std::size_t i, InvariantStatus& st)
+        {
+            return Probe::checkForbidden(validator, in.next[i], in.metrics[i], st);
+        });
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchOptions opt;
+    const char*  json = nullptr;
+
+    for (int a = 1; a < argc; ++a)
+    {
+        const bool has_value = a + 1 < argc;
+
+        if      (!std::strcmp(argv[a], "--filter")      && has_value) opt.filter      = argv[++a];
+        else if (!std::strcmp(argv[a], "--reps")        && has_value) opt.repetitions = std::strtoul(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "--warmup")      && has_value) opt.warmup      = std::strtoul(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "--min-time-ms") && has_value) opt.min_time_ms = std::strtod(argv[++a], nullptr);
+        else if (!std::strcmp(argv[a], "--json")        && has_value) json            = argv[++a];
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    const Inputs in;
+    BenchRunner  run(opt);
+
+    std::printf("fmrt_bench: pool %zu, %zu warmup + %zu repetitions, >= %.1f ms each\n",
+                POOL, opt.warmup, opt.repetitions, opt.min_time_ms);
+    run.printHeader();
+
+    benchStep(run, in);
+    benchEngine(run, in);
+    benchValidator(run, in);
+
+    if (json)
+    {
+        const bool to_stdout = !std::strcmp(json, "-");
+        std::FILE* out = to_stdout ? stdout : std::fopen(json, "w");
+        if (!out)
+        {
+            std::fprintf(stderr, "fmrt_bench: cannot open %s\n", json);
+            return 1;
+        }
+
+        run.writeJson(out, "fmrt_bench", {
+            { "delta_dim",         std::to_string(DELTA_DIM) },
+            { "deterministic_exp", DETERMINISTIC_EXP ? "on" : "off" },
+            { "stage_profiling",   FMRT_StageProfilingEnabled() ? "on" : "off" },
+            { "pool",              std::to_string(POOL) },
+        });
+
+        if (!to_stdout)
+            std::fclose(out);
+    }
+
+    return 0;
+}
@@ -4,11 +4,21 @@
 
 #include <cmath>      // std::isfinite
 #include <cstdint>
+#include <new>        // std::nothrow
 
 using namespace fmrt;
 
-// persistent FMRT state inside the DLL
-static StructuralState g_state;
+static_assert(DELTA_DIM == 4, "bridge ABI is fixed to 4 Delta components");
+
+// one organism per handle
+struct fmrt_bridge_instance
+{
+    StructuralState state;
+    CarriedMetrics  carry;      // metrics of `state` from the last step
+};
+
+// persistent FMRT state behind the legacy FMRT_Step / FMRT_Reset calls
+static fmrt_bridge_instance g_default;
 
 static inline bool is_finite_double(double x) noexcept
 {
@@ -24,24 +34,22 @@ static inline bool validate_event(const fmrt_bridge_event* in) noexcept
         return false;
 
     // stimulus must be finite
-    for (int i = 0; i < DELTA_DIM; ++i)
+    for (std::size_t i = 0; i < DELTA_DIM; ++i)
         if (!is_finite_double(in->stimulus[i]))
             return false;
 
     // type must be within known enum range (defensive)
-    // Adjust these bounds if your EventType enum differs.
-    // Expected: {UPDATE=0/1, HEARTBEAT=..., GAP=...}
     const std::uint8_t t = in->type;
-    if (t > static_cast<std::uint8_t>(EventType::GAP))
+    if (t > static_cast<std::uint8_t>(EventType::Reset))
         return false;
 
     // Optional strictness (TIT-like): HEARTBEAT and GAP must have zero stimulus.
     // Uncomment if FMRT expects zero-vector for these.
     /*
-    if (t == static_cast<std::uint8_t>(EventType::HEARTBEAT) ||
-        t == static_cast<std::uint8_t>(EventType::GAP))
+    if (t == static_cast<std::uint8_t>(EventType::Heartbeat) ||
+        t == static_cast<std::uint8_t>(EventType::Gap))
     {
-        for (int i = 0; i < DELTA_DIM; ++i)
+        for (std::size_t i = 0; i < DELTA_DIM; ++i)
             if (in->stimulus[i] != 0.0)
                 return false;
     }
@@ -50,13 +58,39 @@ static inline bool validate_event(const fmrt_bridge_event* in) noexcept
     return true;
 }
 
-FMRT_API void FMRT_CALL FMRT_Reset()
+static inline void write_envelope(StepStatus             status,
+                                  const DerivedMetrics&  metrics,
+                                  const InvariantStatus& invariants,
+                                  fmrt_bridge_envelope*  out) noexcept
 {
-    g_state.reset();
+    out->status        = static_cast<std::uint8_t>(status);
+    out->invariants_ok = invariants.all_ok ? 1u : 0u;
+
+    // derived metrics
+    out->derived[0] = metrics.curvature_R;
+    out->derived[1] = metrics.det_g;
+    out->derived[2] = metrics.tau;
+    out->derived[3] = 0.0; // reserved / ABI-stable slot
 }
 
-FMRT_API int FMRT_CALL FMRT_Step(const fmrt_bridge_event* in,
-                                 fmrt_bridge_envelope*    out)
+static inline bool is_escapable(StepStatus st) noexcept
+{
+    // TIT-style: only OK/ERROR/DEAD are allowed to escape as normal.
+    // Any other status is a fatal integration bug.
+    return st == StepStatus::OK ||
+           st == StepStatus::ERROR ||
+           st == StepStatus::DEAD;
+}
+
+static inline bool is_aligned8(const void* p, std::size_t stride) noexcept
+{
+    return (reinterpret_cast<std::uintptr_t>(p) % alignof(double)) == 0 &&
+           (stride % alignof(double)) == 0;
+}
+
+static int step_instance(fmrt_bridge_instance&    inst,
+                         const fmrt_bridge_event* in,
+                         fmrt_bridge_envelope*    out)
 {
     if (!in || !out)
         return FMRT_BRIDGE_E_NULLPTR;
@@ -69,33 +103,218 @@ FMRT_API int FMRT_CALL FMRT_Step(const fmrt_bridge_event* in,
     E.type = static_cast<EventType>(in->type);
     E.dt   = in->dt;
 
-    for (int i = 0; i < DELTA_DIM; ++i)
+    for (std::size_t i = 0; i < DELTA_DIM; ++i)
         E.stimulus[i] = in->stimulus[i];
 
-    // Real FMRT step
-    StateEnvelope env = fmrt::FMRT_Step(g_state, E);
+    // Real FMRT step; persistent state is only updated on valid steps
+    DerivedMetrics  metrics;
+    InvariantStatus invariants;
+    const StepStatus status =
+        fmrt::FMRT_StepInPlace(inst.state, E, inst.carry, &metrics, &invariants);
 
-    // TIT-style: only OK/ERROR/COLLAPSE are allowed to escape as normal.
-    // Any other status (e.g., REJECT) is a fatal integration bug.
-    if (env.status != StepStatus::OK &&
-        env.status != StepStatus::ERROR &&
-        env.status != StepStatus::COLLAPSE)
-    {
+    if (!is_escapable(status))
         return FMRT_BRIDGE_E_FATAL_STATUS;
+
+    // Convert FMRT → bridge
+    write_envelope(status, metrics, invariants, out);
+
+    return FMRT_BRIDGE_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Legacy single-organism API
+// -----------------------------------------------------------------------------
+
+FMRT_API void FMRT_CALL FMRT_Reset()
+{
+    g_default.state.reset();
+}
+
+FMRT_API int FMRT_CALL FMRT_Step(const fmrt_bridge_event* in,
+                                 fmrt_bridge_envelope*    out)
+{
+    return step_instance(g_default, in, out);
+}
+
+// -----------------------------------------------------------------------------
+// Handle-based API
+// -----------------------------------------------------------------------------
+
+FMRT_API fmrt_bridge_handle FMRT_CALL fmrt_bridge_create()
+{
+    fmrt_bridge_instance* inst = new (std::nothrow) fmrt_bridge_instance{};
+    if (inst)
+        inst->state.reset();
+
+    return inst;
+}
+
+FMRT_API void FMRT_CALL fmrt_bridge_destroy(fmrt_bridge_handle h)
+{
+    delete h;
+}
+
+FMRT_API int FMRT_CALL fmrt_bridge_reset(fmrt_bridge_handle h)
+{
+    if (!h)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    h->state.reset();
+    return FMRT_BRIDGE_OK;
+}
+
+FMRT_API int FMRT_CALL fmrt_bridge_import_state(fmrt_bridge_handle       h,
+                                                const fmrt_bridge_state* in)
+{
+    if (!h || !in)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    StructuralState X{};
+    for (std::size_t i = 0; i < DELTA_DIM; ++i)
+        X.Delta[i] = in->delta[i];
+
+    X.Phi   = in->phi;
+    X.M     = in->m;
+    X.Kappa = in->kappa;
+
+    if (!X.isFinite() || X.Kappa < 0.0 ||
+        in->regime_prev > static_cast<std::uint8_t>(Regime::COL))
+    {
+        return FMRT_BRIDGE_E_BAD_INPUT;
     }
 
-    // update persistent state only on valid steps
-    g_state = env.state;
+    X.RegimePrev = static_cast<Regime>(in->regime_prev);
 
-    // Convert FMRT → bridge
-    out->status        = static_cast<std::uint8_t>(env.status);
-    out->invariants_ok = env.invariants.all_ok ? 1u : 0u;
+    h->state = X;
+    return FMRT_BRIDGE_OK;
+}
 
-    // derived metrics
-    out->derived[0] = env.metrics.curvature_R;
-    out->derived[1] = env.metrics.det_g;
-    out->derived[2] = env.metrics.tau;
-    out->derived[3] = 0.0; // reserved / ABI-stable slot
+FMRT_API int FMRT_CALL fmrt_bridge_export_state(fmrt_bridge_handle h,
+                                                fmrt_bridge_state* out)
+{
+    if (!h || !out)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    const StructuralState& X = h->state;
+
+    for (std::size_t i = 0; i < DELTA_DIM; ++i)
+        out->delta[i] = X.Delta[i];
+
+    out->phi         = X.Phi;
+    out->m           = X.M;
+    out->kappa       = X.Kappa;
+    out->regime_prev = static_cast<std::uint8_t>(X.RegimePrev);
 
     return FMRT_BRIDGE_OK;
 }
+
+FMRT_API int FMRT_CALL fmrt_bridge_step(fmrt_bridge_handle       h,
+                                        const fmrt_bridge_event* ev,
+                                        fmrt_bridge_envelope*    out)
+{
+    if (!h)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    return step_instance(*h, ev, out);
+}
+
+FMRT_API int FMRT_CALL fmrt_bridge_step_many(const fmrt_bridge_handle* handles,
+                                             const fmrt_bridge_event*  events,
+                                             fmrt_bridge_envelope*     out,
+                                             std::size_t               count,
+                                             int*                      rcs)
+{
+    if (count == 0)
+        return FMRT_BRIDGE_OK;
+
+    if (!handles || !events || !out)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    int first_rc = FMRT_BRIDGE_OK;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const int rc = handles[i]
+            ? step_instance(*handles[i], &events[i], &out[i])
+            : FMRT_BRIDGE_E_NULLPTR;
+
+        if (rcs)
+            rcs[i] = rc;
+
+        if (rc != FMRT_BRIDGE_OK && first_rc == FMRT_BRIDGE_OK)
+            first_rc = rc;
+    }
+
+    return first_rc;
+}
+
+FMRT_API int FMRT_CALL fmrt_bridge_step_stream(fmrt_bridge_handle h,
+                                               const void*        events,
+                                               std::size_t        event_stride,
+                                               void*              envelopes,
+                                               std::size_t        envelope_stride,
+                                               std::size_t        count)
+{
+    if (!h)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    if (count == 0)
+        return FMRT_BRIDGE_OK;
+
+    if (!events || !envelopes)
+        return FMRT_BRIDGE_E_NULLPTR;
+
+    if (event_stride < sizeof(fmrt_bridge_event) ||
+        envelope_stride < sizeof(fmrt_bridge_envelope) ||
+        !is_aligned8(events, event_stride) ||
+        !is_aligned8(envelopes, envelope_stride))
+    {
+        return FMRT_BRIDGE_E_BAD_INPUT;
+    }
+
+    const char* in_ptr  = static_cast<const char*>(events);
+    char*       out_ptr = static_cast<char*>(envelopes);
+
+    // state stays local for the whole stream, written back once
+    StructuralState X = h->state;
+    CarriedMetrics  C = h->carry;
+    int rc = FMRT_BRIDGE_OK;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const fmrt_bridge_event* in =
+            reinterpret_cast<const fmrt_bridge_event*>(in_ptr + i * event_stride);
+
+        // same gate as fmrt_bridge_step: the stream stops at the first bad event
+        if (!validate_event(in))
+        {
+            rc = FMRT_BRIDGE_E_BAD_INPUT;
+            break;
+        }
+
+        StructEvent E{};
+        E.type = static_cast<EventType>(in->type);
+        E.dt   = in->dt;
+
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            E.stimulus[k] = in->stimulus[k];
+
+        DerivedMetrics  metrics;
+        InvariantStatus invariants;
+        const StepStatus status =
+            fmrt::FMRT_StepInPlace(X, E, C, &metrics, &invariants);
+
+        if (!is_escapable(status))
+        {
+            rc = FMRT_BRIDGE_E_FATAL_STATUS;
+            break;
+        }
+
+        write_envelope(status, metrics, invariants,
+            reinterpret_cast<fmrt_bridge_envelope*>(out_ptr + i * envelope_stride));
+    }
+
+    h->state = X;
+    h->carry = C;
+    return rc;
+}
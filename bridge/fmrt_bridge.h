@@ -1,5 +1,6 @@
 // fmrt_bridge.h
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 #ifdef _WIN32
@@ -22,22 +23,93 @@ struct fmrt_bridge_event
 
 struct fmrt_bridge_envelope
 {
-    std::uint8_t status;        // must map to fmrt::StepStatus (OK/ERROR/COLLAPSE only)
+    std::uint8_t status;        // must map to fmrt::StepStatus (OK/ERROR/DEAD only)
     std::uint8_t invariants_ok; // 1 = true, 0 = false
     double       derived[4];     // last slot reserved for ABI stability
 };
 
+// Structural state X(t) as seen across the ABI (import / export)
+struct fmrt_bridge_state
+{
+    double       delta[4];     // Δ(t)
+    double       phi;          // Φ(t)
+    double       m;            // M(t)
+    double       kappa;        // κ(t), must be >= 0
+    std::uint8_t regime_prev;  // must map to fmrt::Regime
+};
+
+// Opaque organism instance. Each handle owns one StructuralState.
+// Different handles may be stepped concurrently from different threads;
+// a single handle must not be used by two threads at the same time.
+struct fmrt_bridge_instance;
+typedef fmrt_bridge_instance* fmrt_bridge_handle;
+
 // return codes (bridge-level)
 enum : int
 {
     FMRT_BRIDGE_OK                = 0,
     FMRT_BRIDGE_E_NULLPTR         = -1,
     FMRT_BRIDGE_E_BAD_INPUT       = -2,
-    FMRT_BRIDGE_E_FATAL_STATUS    = -3
+    FMRT_BRIDGE_E_FATAL_STATUS    = -3,
+    FMRT_BRIDGE_E_NO_MEMORY       = -4
 };
 
+// -----------------------------------------------------------------------------
+// Legacy single-organism API (process-wide default instance, NOT thread-safe)
+// -----------------------------------------------------------------------------
 FMRT_API int  FMRT_CALL FMRT_Step(const fmrt_bridge_event* ev,
                                   fmrt_bridge_envelope*    out);
 
 FMRT_API void FMRT_CALL FMRT_Reset();
 
+// -----------------------------------------------------------------------------
+// Handle-based API
+// -----------------------------------------------------------------------------
+
+// Returns a new instance in the RESET state, or nullptr on allocation failure.
+FMRT_API fmrt_bridge_handle FMRT_CALL fmrt_bridge_create();
+
+// Releases an instance. nullptr is ignored.
+FMRT_API void FMRT_CALL fmrt_bridge_destroy(fmrt_bridge_handle h);
+
+FMRT_API int FMRT_CALL fmrt_bridge_reset(fmrt_bridge_handle h);
+
+// Replaces the instance state. Rejected (state unchanged) if any field is
+// non-finite, kappa < 0 or regime_prev is out of range.
+FMRT_API int FMRT_CALL fmrt_bridge_import_state(fmrt_bridge_handle       h,
+                                                const fmrt_bridge_state* in);
+
+FMRT_API int FMRT_CALL fmrt_bridge_export_state(fmrt_bridge_handle h,
+                                                fmrt_bridge_state* out);
+
+FMRT_API int FMRT_CALL fmrt_bridge_step(fmrt_bridge_handle       h,
+                                        const fmrt_bridge_event* ev,
+                                        fmrt_bridge_envelope*    out);
+
+// Steps handles[i] with events[i] for i in [0, count) in one call.
+// Items are processed in array order, so a handle may appear several times.
+// rcs (optional) receives the per-item return code. Returns FMRT_BRIDGE_OK
+// if every item succeeded, otherwise the first failing item's code.
+FMRT_API int FMRT_CALL fmrt_bridge_step_many(const fmrt_bridge_handle* handles,
+                                             const fmrt_bridge_event*  events,
+                                             fmrt_bridge_envelope*     out,
+                                             std::size_t               count,
+                                             int*                      rcs);
+
+// Steps one handle through a caller-owned array of events in a single pass.
+//   events[i]    = *(const fmrt_bridge_event*)   ((const char*)events    + i * event_stride)
+//   envelopes[i] = *(fmrt_bridge_envelope*)       ((char*)envelopes       + i * envelope_stride)
+// Strides let the arrays live inside larger records (e.g. a memory-mapped
+// log); both base pointers and strides must keep 8-byte alignment.
+// Nothing is copied: each event is checked like in fmrt_bridge_step and then
+// goes straight to the FMRT pipeline. The stream stops at the first event that
+// fails the check and returns FMRT_BRIDGE_E_BAD_INPUT; the events before it
+// stay applied and their envelopes are written, the envelopes from the bad
+// event on are left untouched. Events the pipeline itself rejects come back
+// as status ERROR (instance state unchanged).
+FMRT_API int FMRT_CALL fmrt_bridge_step_stream(fmrt_bridge_handle h,
+                                               const void*        events,
+                                               std::size_t        event_stride,
+                                               void*              envelopes,
+                                               std::size_t        envelope_stride,
+                                               std::size_t        count);
@@ -18,6 +18,27 @@ namespace fmrt
     // -------------------------------------------------------------------------
     constexpr bool ENABLE_FP_GUARDS = true;
 
+    // -------------------------------------------------------------------------
+    // Build toggle (CMake FMRT_DETERMINISTIC_EXP): τ and det g use the
+    // in-house exp kernel (internal/det_exp.hpp) instead of std::exp, so
+    // results no longer depend on the libm version
+    // -------------------------------------------------------------------------
+#if defined(FMRT_DETERMINISTIC_EXP) && FMRT_DETERMINISTIC_EXP
+    constexpr bool DETERMINISTIC_EXP = true;
+#else
+    constexpr bool DETERMINISTIC_EXP = false;
+#endif
+
+    // -------------------------------------------------------------------------
+    // Build toggle (CMake FMRT_STAGE_PROFILING): per-stage latency
+    // histograms of the step pipeline (fmrt_profile.hpp). Off: the timing
+    // hooks are not compiled at all.
+    // -------------------------------------------------------------------------
+#if !defined(FMRT_STAGE_PROFILING)
+#   define FMRT_STAGE_PROFILING 0
+#endif
+    constexpr bool STAGE_PROFILING = FMRT_STAGE_PROFILING != 0;
+
     // -------------------------------------------------------------------------
     // Deny unsafe build modes (fast-math, relaxed FP, extended precision)
     // These conditions will be validated during static analysis.
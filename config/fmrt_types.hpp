@@ -16,9 +16,15 @@ namespace fmrt
     // Compile-time constants
     // -------------------------------------------------------------------------
 
-    // Δ-dimensionality (fixed at compile time, must be O(1))
+    // Default Δ-dimensionality (fixed at compile time, must be O(1)).
+    // StructuralState / StructEvent / StateEnvelope are aliases for this size.
     constexpr std::size_t DELTA_DIM = 4; // Can be changed if needed
 
+    // Δ-dimensionalities compiled into the library. Every templated module
+    // is explicitly instantiated for each size listed here; other sizes
+    // fail at link time.
+#define FMRT_FOR_EACH_DELTA_DIM(X) X(4) X(8) X(16) X(64)
+
     // -------------------------------------------------------------------------
     // Event types
     // -------------------------------------------------------------------------
@@ -14,6 +14,13 @@
 #include "fmrt_state.hpp"
 #include "fmrt_event.hpp"
 #include "fmrt_envelope.hpp"
+#include "fmrt_batch.hpp"
+#include "fmrt_horizon.hpp"
+#include "fmrt_carry.hpp"
+#include "fmrt_profile.hpp"
+
+#include <cstddef>
+#include <cstdint>
 
 namespace fmrt
 {
@@ -25,12 +32,228 @@ namespace fmrt
     //   - no IO, no randomness
     //   - identical outputs across all platforms for identical inputs
     //
+    // N is deduced from the arguments; the library provides every size in
+    // FMRT_FOR_EACH_DELTA_DIM (StructuralState / StructEvent use DELTA_DIM).
+    //
     // NEXT:
     //   Implementation is in src/fmrt_api.cpp
     // -------------------------------------------------------------------------
-    StateEnvelope FMRT_Step(
-        const StructuralState& X,
-        const StructEvent& E
+    template <std::size_t N>
+    StateEnvelopeT<N> FMRT_Step(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>& E
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_StepInto:
+    //   Same transition as FMRT_Step, but the envelope is produced directly
+    //   in caller storage (no temporaries, no envelope copies).
+    //   Every field of env is overwritten; env.state may be X itself.
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    void FMRT_StepInto(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>& E,
+        StateEnvelopeT<N>& env
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_StepInPlace:
+    //   Advances X to X(t+1) when the step is accepted (status OK).
+    //   On ERROR, X is left untouched — including numeric rejects, where
+    //   FMRT_Step would report a RESET state instead.
+    //
+    //   The optional outputs receive the matching FMRT_Step envelope fields;
+    //   a null pointer is simply not written.
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    StepStatus FMRT_StepInPlace(
+        StructuralStateT<N>& X,
+        const StructEventT<N>& E,
+        DerivedMetrics*  metrics        = nullptr,
+        InvariantStatus* invariants     = nullptr,
+        ErrorCategory*   error_category = nullptr
+    );
+
+    // -------------------------------------------------------------------------
+    // Carried-metrics overloads:
+    //   Same results (bit for bit) as the overloads above. carry holds the
+    //   curvature, μ and τ of the input state when the previous call
+    //   produced it; a step reuses them instead of recomputing, and leaves
+    //   carry describing its output state. An empty or stale carry is
+    //   detected by its key and recomputed.
+    //
+    //   Typical loop:  CarriedMetrics c;  for (...) FMRT_StepInPlace(X, E, c);
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    void FMRT_StepInto(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>& E,
+        StateEnvelopeT<N>& env,
+        CarriedMetricsT<N>& carry
+    );
+
+    template <std::size_t N>
+    StepStatus FMRT_StepInPlace(
+        StructuralStateT<N>& X,
+        const StructEventT<N>& E,
+        CarriedMetricsT<N>& carry,
+        DerivedMetrics*     metrics        = nullptr,
+        InvariantStatus*    invariants     = nullptr,
+        ErrorCategory*      error_category = nullptr
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_FastForward:
+    //   Result of k consecutive FMRT_Step calls with the same event E, each
+    //   fed the previous env.state; the envelope of the last step is returned.
+    //
+    //   - GAP / HEARTBEAT: stimulus-free stretches are advanced in closed
+    //     form, so the cost depends on the number of discrete events
+    //     (collapse, Φ floor, Δ clipping / underflow, regime changes, binade
+    //     changes of κ and Φ), not on k. κ, Φ, the regime and the step
+    //     status are exact; Δ and M carry the closed-form rounding
+    //     (relative error ~ k·2^-52).
+    //   - other events are stepped one by one
+    //   - stops early at a fixed point (collapse, rejected event, frozen
+    //     invariant violation): the remaining steps would repeat it
+    //   - k == 0 is rejected as InvalidEvent
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    StateEnvelopeT<N> FMRT_FastForward(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>& E,
+        std::uint64_t k
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_CollapseHorizon:
+    //   Number of steps of the repeated event E until κ crosses EPS_KAPPA
+    //   and the step reports collapse (see CollapseHorizon).
+    //
+    //   - GAP / HEARTBEAT: exact; cost grows with the binades of κ
+    //     crossed, not with the horizon
+    //   - UPDATE: conservative [steps_min, steps_max] for a constant
+    //     stimulus; steps_max is NEVER when collapse is not guaranteed
+    //     within 2^47 steps
+    //   - RESET: NEVER
+    //   - states / events FMRT_Step rejects report ERROR and the matching
+    //     error category; the remaining fields are then not meaningful
+    //
+    //   The horizon follows the evolution equations: steps the invariant
+    //   validator would reject are not modelled.
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    CollapseHorizon FMRT_CollapseHorizon(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>& E
+    );
+
+    // out[i] = FMRT_CollapseHorizon(X.load(i), E[i]) for i in [0, count)
+    template <std::size_t N>
+    void FMRT_CollapseHorizonBatch(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>*  E,
+        std::size_t             count,
+        CollapseHorizon*        out
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_StepBatch:
+    //   Applies E[i] to organism i for i in [0, count), reading X(t) from
+    //   the SoA columns X and writing X(t+1) to X_next.
+    //
+    //   For every organism the result is bit-identical to
+    //       StateEnvelope env = FMRT_Step(X.load(i), E[i]);
+    //   (X_next <- env.state, out columns <- remaining envelope fields).
+    //
+    //   - X and X_next may be the same columns (in-place); partially
+    //     overlapping columns are not allowed
+    //   - organisms are independent; lanes are evaluated 4 (AVX2) or
+    //     8 (AVX-512) at a time, uncommon cases fall back to FMRT_Step
+    //   - no allocations, no hidden state
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    void FMRT_StepBatch(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>*  E,
+        std::size_t             count,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_StepBroadcast:
+    //   Applies the same event E to every organism in [0, count), e.g. a
+    //   timer-driven HEARTBEAT or a market-close GAP for a whole fleet.
+    //
+    //   For every organism the result is bit-identical to
+    //       StateEnvelope env = FMRT_Step(X.load(i), E);
+    //
+    //   - E is screened, validated and canonicalized once, not per organism
+    //   - GAP / HEARTBEAT run a stimulus-free kernel with one dt for all
+    //     lanes; UPDATE runs the FMRT_StepBatch kernel with the event
+    //     transposed once; RESET and a rejected E take the FMRT_Step path
+    //   - without FMRT_SIMD the kernels run one organism at a time; the
+    //     event is still handled once
+    //   - same column rules as FMRT_StepBatch (in-place allowed)
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    void FMRT_StepBroadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    );
+
+    // FMRT_StepBroadcast with FMRT_StepInPlace semantics: X is advanced in
+    // place and an organism whose step is rejected keeps X(t), also for
+    // numeric rejects (out columns as for FMRT_StepInPlace)
+    template <std::size_t N>
+    void FMRT_StepBroadcastInPlace(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const EnvelopeColumns&  out
+    );
+
+    // -------------------------------------------------------------------------
+    // FMRT_StepFactorBroadcast:
+    //   One common shock, scaled per organism: organism i receives E with
+    //   stimulus[k] = loading[i] * E.stimulus[k] (e.g. an index move times
+    //   each organism's beta). Result bit-identical to
+    //       StructEventT<N> Ei = E;
+    //       for (k) Ei.stimulus[k] = loading[i] * E.stimulus[k];
+    //       StateEnvelope env = FMRT_Step(X.load(i), Ei);
+    //
+    //   - UPDATE: dt is validated and canonicalized once; the scaled
+    //     stimulus is formed and screened inside the vector pass, no
+    //     event is built. Organisms whose scaled stimulus is rejected
+    //     (non-finite / subnormal) get the FMRT_Step error envelope
+    //   - other event types take the FMRT_Step path with the scaled event
+    //   - the kernel runs without FMRT_SIMD too (see FMRT_StepBroadcast)
+    //   - loading has count entries; same column rules as FMRT_StepBatch
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    void FMRT_StepFactorBroadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const double*           loading,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    );
+
+    // FMRT_StepFactorBroadcast with FMRT_StepInPlace semantics (see
+    // FMRT_StepBroadcastInPlace)
+    template <std::size_t N>
+    void FMRT_StepFactorBroadcastInPlace(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const double*           loading,
+        const EnvelopeColumns&  out
     );
 
 } // namespace fmrt
@@ -0,0 +1,76 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_batch.hpp
+//
+// Structure-of-arrays views consumed by FMRT_StepBatch().
+// All columns are owned by the caller; FMRT never allocates, resizes or
+// retains them. Column i of every array describes organism i.
+//
+
+#include <cstddef>
+
+#include "fmrt_state.hpp"
+#include "fmrt_metrics.hpp"
+#include "fmrt_invariants.hpp"
+#include "fmrt_types.hpp"
+
+namespace fmrt
+{
+    // -------------------------------------------------------------------------
+    // StateColumnsT<N>:
+    //   Column-wise view of StructuralStateT<N> objects.
+    //   Delta[k][i] is Δ_k of organism i.
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    struct StateColumnsT
+    {
+        double* Delta[N] = {};
+        double* Phi        = nullptr;
+        double* M          = nullptr;
+        double* Kappa      = nullptr;
+        Regime* RegimePrev = nullptr;
+
+        StructuralStateT<N> load(std::size_t i) const noexcept
+        {
+            StructuralStateT<N> X;
+            for (std::size_t k = 0; k < N; ++k)
+                X.Delta[k] = Delta[k][i];
+
+            X.Phi        = Phi[i];
+            X.M          = M[i];
+            X.Kappa      = Kappa[i];
+            X.RegimePrev = RegimePrev[i];
+            return X;
+        }
+
+        void store(std::size_t i, const StructuralStateT<N>& X) const noexcept
+        {
+            for (std::size_t k = 0; k < N; ++k)
+                Delta[k][i] = X.Delta[k];
+
+            Phi[i]        = X.Phi;
+            M[i]          = X.M;
+            Kappa[i]      = X.Kappa;
+            RegimePrev[i] = X.RegimePrev;
+        }
+    };
+
+    using StateColumns = StateColumnsT<DELTA_DIM>;
+
+    // -------------------------------------------------------------------------
+    // EnvelopeColumns:
+    //   Per-organism outputs of a batch step. Every pointer is optional;
+    //   a null column is simply not written.
+    //   Together with the next-state columns these carry exactly the
+    //   fields of StateEnvelope (error_reason = errorCategoryToString()).
+    // -------------------------------------------------------------------------
+    struct EnvelopeColumns
+    {
+        DerivedMetrics*  metrics        = nullptr;
+        InvariantStatus* invariants     = nullptr;
+        StepStatus*      status         = nullptr;
+        ErrorCategory*   error_category = nullptr;
+    };
+
+} // namespace fmrt
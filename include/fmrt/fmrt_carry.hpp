@@ -0,0 +1,74 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_carry.hpp
+//
+// CarriedMetricsT<N>: optional cache kept next to a StructuralStateT<N>.
+// Every step needs the curvature, μ and τ of its input X(t); the step
+// that produced X(t) can hand them over instead of having them
+// recomputed. The cache is keyed on the exact bits of Φ, M, κ and every
+// Δ component and is used only when the key matches, so a stale cache
+// (state edited, imported, rejected step) costs a recomputation, never a
+// different result.
+//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "fmrt_state.hpp"
+
+namespace fmrt
+{
+    template <std::size_t N>
+    struct CarriedMetricsT
+    {
+        // ---------------------------------------------------------------------
+        // Metrics of the keyed state X
+        // ---------------------------------------------------------------------
+        double curvature_R = 0.0;   // R(X)
+        double mu          = 0.0;   // μ(R(X))
+        double tau         = 0.0;   // τ(X.Kappa)
+
+        // ---------------------------------------------------------------------
+        // Key: bits of Φ, M, κ and of every Δ component
+        // ---------------------------------------------------------------------
+        std::uint64_t                key_phi   = 0;
+        std::uint64_t                key_m     = 0;
+        std::uint64_t                key_kappa = 0;
+        std::array<std::uint64_t, N> key_delta{};
+        bool                         valid     = false;
+
+        void invalidate() noexcept { valid = false; }
+
+        bool matches(const StructuralStateT<N>& X) const noexcept
+        {
+            return valid &&
+                   bits(X.Kappa) == key_kappa &&
+                   bits(X.M)     == key_m &&
+                   bits(X.Phi)   == key_phi &&
+                   std::memcmp(X.Delta.data(), key_delta.data(), sizeof(double) * N) == 0;
+        }
+
+        void bind(const StructuralStateT<N>& X) noexcept
+        {
+            key_phi   = bits(X.Phi);
+            key_m     = bits(X.M);
+            key_kappa = bits(X.Kappa);
+            std::memcpy(key_delta.data(), X.Delta.data(), sizeof(double) * N);
+            valid     = true;
+        }
+
+    private:
+        static std::uint64_t bits(double x) noexcept
+        {
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof(double));
+            return b;
+        }
+    };
+
+    using CarriedMetrics = CarriedMetricsT<DELTA_DIM>;
+
+} // namespace fmrt
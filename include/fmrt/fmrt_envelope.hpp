@@ -11,6 +11,9 @@
 //   - diagnostics metadata (error codes, status)
 //   - event type
 //
+// StateEnvelopeT<N> wraps StructuralStateT<N>; StateEnvelope is the
+// default DELTA_DIM instance.
+//
 
 #include "fmrt_state.hpp"
 #include "fmrt_metrics.hpp"
@@ -20,12 +23,13 @@
 
 namespace fmrt
 {
-    struct StateEnvelope
+    template <std::size_t N>
+    struct StateEnvelopeT
     {
         // ---------------------------------------------------------------------
         // Structural state (next or unchanged if rejected)
         // ---------------------------------------------------------------------
-        StructuralState state;
+        StructuralStateT<N> state;
 
         // ---------------------------------------------------------------------
         // Derived metrics computed by evolution engine
@@ -62,4 +66,6 @@ namespace fmrt
         }
     };
 
+    using StateEnvelope = StateEnvelopeT<DELTA_DIM>;
+
 } // namespace fmrt
@@ -7,6 +7,9 @@
 // FMRT accepts exactly four event types:
 //   STRUCT_UPDATE, STRUCT_GAP, STRUCT_HEARTBEAT, STRUCT_RESET
 //
+// StructEventT<N> carries an N-dimensional stimulus; StructEvent is the
+// default DELTA_DIM instance.
+//
 
 #include <array>
 #include <cstddef>
@@ -18,11 +21,14 @@
 
 namespace fmrt
 {
-    struct StructEvent
+    template <std::size_t N>
+    struct StructEventT
     {
+        static constexpr std::size_t DIM = N;
+
         EventType type = EventType::Heartbeat;    // default: minimal tick
         double dt = 0.0;                          // required for UPDATE/GAP/HEARTBEAT
-        std::array<double, DELTA_DIM> stimulus{}; // deformation for UPDATE only
+        std::array<double, N> stimulus{};         // deformation for UPDATE only
         const char* reason = nullptr;             // RESET optional message
 
         // ---------------------------------------------------------------------
@@ -59,4 +65,6 @@ namespace fmrt
         }
     };
 
+    using StructEvent = StructEventT<DELTA_DIM>;
+
 } // namespace fmrt
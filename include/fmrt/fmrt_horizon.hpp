@@ -0,0 +1,44 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_horizon.hpp
+//
+// Time-to-collapse estimate returned by FMRT_CollapseHorizon().
+// Counts the steps of a repeated event E until κ reaches EPS_KAPPA and
+// the evolution engine collapses the organism.
+//
+
+#include <cstdint>
+#include <limits>
+
+#include "fmrt_types.hpp"
+
+namespace fmrt
+{
+    struct CollapseHorizon
+    {
+        // steps_max when κ never reaches EPS_KAPPA under this event
+        static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+        // ---------------------------------------------------------------------
+        // Step j (1-based) is the first whose envelope reports is_collapse;
+        // steps_min <= j <= steps_max. 0 when X is already collapsed.
+        // ---------------------------------------------------------------------
+        std::uint64_t steps_min = 0;
+        std::uint64_t steps_max = 0;
+
+        // same bounds in model time (steps · dt); +inf for NEVER
+        double time_min = 0.0;
+        double time_max = 0.0;
+
+        // true when steps_min == steps_max is the exact horizon
+        bool exact = false;
+
+        // ---------------------------------------------------------------------
+        // Diagnostics: ERROR for states / events FMRT_Step would reject
+        // ---------------------------------------------------------------------
+        StepStatus status = StepStatus::OK;
+        ErrorCategory error_category = ErrorCategory::None;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,157 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_profile.hpp
+//
+// Per-stage latency histograms of the scalar step pipeline
+// (FMRT_Step / FMRT_StepInto / FMRT_StepInPlace).
+//
+// Recording is compiled in only with the CMake option
+// FMRT_STAGE_PROFILING=ON; otherwise the pipeline contains no timing code
+// at all and FMRT_StageProfile() returns an empty profile. Each thread
+// records into its own histograms; FMRT_StageProfile() merges them,
+// including those of threads that have exited.
+//
+// Samples are TSC ticks (rdtsc) on x86 and steady_clock nanoseconds
+// elsewhere; StageProfile::unit names which.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace fmrt
+{
+    // -------------------------------------------------------------------------
+    // Pipeline stages, in step order
+    // -------------------------------------------------------------------------
+    enum class PipelineStage : std::uint8_t
+    {
+        FpGuard       = 0,  // FP environment check
+        NumericScreen = 1,  // NaN / Inf / subnormal reject
+        Validate      = 2,  // EventHandler: dt and event type
+        Canonicalize  = 3,  // EventHandler::canonicalize
+        Evolve        = 4,  // EvolutionEngine::evolve
+        Invariants    = 5,  // InvariantValidator::validate (not for RESET)
+        Diagnostics   = 6   // envelope / output assembly, OK or ERROR
+    };
+
+    constexpr std::size_t PIPELINE_STAGES = 7;
+
+    const char* pipelineStageName(PipelineStage s) noexcept;
+
+    // -------------------------------------------------------------------------
+    // StageHistogram:
+    //   HDR-style log-linear histogram. Values below 2^SUB_BITS have one
+    //   bucket each; above, every power of two is split into 2^SUB_BITS
+    //   linear buckets, so a bucket spans at most 1/16 of its value.
+    // -------------------------------------------------------------------------
+    struct StageHistogram
+    {
+        static constexpr std::size_t SUB_BITS = 4;
+        static constexpr std::size_t SUB      = std::size_t{1} << SUB_BITS;
+        static constexpr std::size_t BUCKETS  = (64 - SUB_BITS + 1) * SUB;
+
+        std::uint64_t count[BUCKETS] = {};
+        std::uint64_t samples = 0;
+        std::uint64_t sum     = 0;          // wraps only after ~2^64 ticks
+        std::uint64_t min     = 0;          // valid when samples > 0
+        std::uint64_t max     = 0;
+
+        static std::size_t bucketOf(std::uint64_t v) noexcept
+        {
+            if (v < SUB)
+                return static_cast<std::size_t>(v);
+
+            std::size_t e = 63;
+            while ((v >> e) == 0) --e;      // e >= SUB_BITS
+
+            const std::size_t mantissa = static_cast<std::size_t>(v >> (e - SUB_BITS));
+            return (e - SUB_BITS + 1) * SUB + (mantissa - SUB);
+        }
+
+        // smallest / largest value of bucket b
+        static std::uint64_t bucketLow(std::size_t b) noexcept
+        {
+            if (b < SUB)
+                return b;
+
+            const std::size_t   e        = b / SUB + SUB_BITS - 1;
+            const std::uint64_t mantissa = SUB + b % SUB;
+            return mantissa << (e - SUB_BITS);
+        }
+
+        static std::uint64_t bucketHigh(std::size_t b) noexcept
+        {
+            return (b + 1 < BUCKETS) ? bucketLow(b + 1) - 1 : ~std::uint64_t{0};
+        }
+
+        void record(std::uint64_t v) noexcept
+        {
+            ++count[bucketOf(v)];
+            min = (samples == 0 || v < min) ? v : min;
+            max = (v > max) ? v : max;
+            sum += v;
+            ++samples;
+        }
+
+        void merge(const StageHistogram& o) noexcept
+        {
+            if (o.samples == 0)
+                return;
+
+            for (std::size_t b = 0; b < BUCKETS; ++b)
+                count[b] += o.count[b];
+
+            min = (samples == 0 || o.min < min) ? o.min : min;
+            max = (o.max > max) ? o.max : max;
+            sum     += o.sum;
+            samples += o.samples;
+        }
+
+        double mean() const noexcept
+        {
+            return samples ? static_cast<double>(sum) / static_cast<double>(samples) : 0.0;
+        }
+
+        // Upper bound of the bucket holding quantile q in [0, 1], capped by
+        // max (0 when empty)
+        std::uint64_t quantile(double q) const noexcept;
+    };
+
+    struct StageProfile
+    {
+        StageHistogram stage[PIPELINE_STAGES];
+        const char*    unit = "ticks";      // "TSC ticks" or "ns"
+
+        // median of back-to-back clock reads, measured when the profile is
+        // taken: the floor every sample carries; 0 when disabled
+        std::uint64_t  clock_overhead = 0;
+
+        StageHistogram&       operator[](PipelineStage s) noexcept       { return stage[static_cast<std::size_t>(s)]; }
+        const StageHistogram& operator[](PipelineStage s) const noexcept { return stage[static_cast<std::size_t>(s)]; }
+
+        void merge(const StageProfile& o) noexcept
+        {
+            for (std::size_t i = 0; i < PIPELINE_STAGES; ++i)
+                stage[i].merge(o.stage[i]);
+        }
+    };
+
+    // -------------------------------------------------------------------------
+    // Collection
+    // -------------------------------------------------------------------------
+
+    // true when the library was built with FMRT_STAGE_PROFILING
+    bool FMRT_StageProfilingEnabled() noexcept;
+
+    // histograms of every thread, live and exited, merged
+    StageProfile FMRT_StageProfile();
+
+    // clears every thread's histograms; call while no step is running
+    void FMRT_StageProfileReset();
+
+    // one line per stage: samples, mean, p50 / p90 / p99 / p99.9, max
+    void FMRT_StageProfileDump(const StageProfile& profile, std::FILE* out);
+
+} // namespace fmrt
@@ -7,6 +7,9 @@
 // This structure is the ONLY representation of the organism state.
 // Must remain deterministic, finite, contiguous, and O(1).
 //
+// StructuralStateT<N> carries an N-dimensional Δ; StructuralState is the
+// default DELTA_DIM instance.
+//
 
 #include <array>
 #include <cstddef>
@@ -18,9 +21,14 @@
 
 namespace fmrt
 {
-struct StructuralState
+template <std::size_t N>
+struct StructuralStateT
 {
-    std::array<double, DELTA_DIM> Delta {};
+    static_assert(N > 0, "Delta dimension must be positive");
+
+    static constexpr std::size_t DIM = N;
+
+    std::array<double, N> Delta {};
     double Phi = 0.0;
     double M = 0.0;
     double Kappa = 1.0;
@@ -54,5 +62,7 @@ struct StructuralState
     bool isCollapsed() const noexcept { return Kappa == 0.0; }
 };
 
+using StructuralState = StructuralStateT<DELTA_DIM>;
+
 
 } // namespace fmrt
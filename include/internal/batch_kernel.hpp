@@ -0,0 +1,99 @@
+#pragma once
+//
+// FMRT Core V2.2
+// batch_kernel.hpp
+//
+// Lane-parallel Evolution Engine + Invariant Validator used by
+// FMRT_StepBatch() and the broadcast steps. The kernel mirrors
+// EvolutionEngine::evolve and InvariantValidator::validate operation by
+// operation, so every lane is bit-identical to the scalar pipeline.
+//
+// The kernel only handles the common path:
+//   - event already validated and canonicalized (Update / Gap / Heartbeat)
+//   - state finite, free of denormals and living (κ > EPS_KAPPA)
+// All other lanes are reported back to the caller for the scalar path.
+//
+
+#include <cstddef>
+
+#include "fmrt_batch.hpp"
+#include "fmrt_state.hpp"
+#include "fmrt_types.hpp"
+#include "simd.hpp"
+
+namespace fmrt
+{
+    // -------------------------------------------------------------------------
+    // LaneEvents:
+    //   One canonical event per lane, transposed for vector loads.
+    //   update[l] = 1.0 for STRUCT_UPDATE, 0.0 for GAP / HEARTBEAT.
+    // -------------------------------------------------------------------------
+    template <std::size_t N>
+    struct LaneEventsT
+    {
+        alignas(64) double dt[simd::LANES];
+        alignas(64) double stimulus[N][simd::LANES];
+        alignas(64) double update[simd::LANES];
+    };
+
+    class BatchKernel
+    {
+    public:
+        static constexpr std::size_t LANES = simd::LANES;
+
+        // ---------------------------------------------------------------------
+        // step:
+        //   Advances organisms [i, i + LANES) whose bit is set in `eligible`.
+        //   Returns the bitmask of lanes actually written; the caller must
+        //   run the scalar pipeline for eligible lanes not in the result.
+        //   X and X_next may be the same columns (in-place stepping).
+        //   With LANES == 1 (no SIMD) it works, but FMRT_StepBatch does
+        //   not use it: per-lane events gain nothing over FMRT_Step there.
+        //   Instantiated for every size in FMRT_FOR_EACH_DELTA_DIM.
+        // ---------------------------------------------------------------------
+        template <std::size_t N>
+        unsigned step(
+            const StateColumnsT<N>& X,
+            std::size_t             i,
+            const LaneEventsT<N>&   E,
+            unsigned                eligible,
+            const StateColumnsT<N>& X_next,
+            const EnvelopeColumns&  out
+        ) const noexcept;
+
+        // ---------------------------------------------------------------------
+        // tick:
+        //   step() for one canonical GAP / HEARTBEAT of duration dt shared
+        //   by every lane (FMRT_StepBroadcast). Same contract as step();
+        //   skips the stimulus, deformation and Update-only decay terms.
+        // ---------------------------------------------------------------------
+        template <std::size_t N>
+        unsigned tick(
+            const StateColumnsT<N>& X,
+            std::size_t             i,
+            double                  dt,
+            unsigned                eligible,
+            const StateColumnsT<N>& X_next,
+            const EnvelopeColumns&  out
+        ) const noexcept;
+
+        // ---------------------------------------------------------------------
+        // factor:
+        //   step() for one canonical UPDATE of duration dt whose stimulus
+        //   in lane l is loading[i + l] * shock[k] (FMRT_StepFactorBroadcast).
+        //   Lanes whose product is non-finite or subnormal are not handled.
+        // ---------------------------------------------------------------------
+        template <std::size_t N>
+        unsigned factor(
+            const StateColumnsT<N>& X,
+            std::size_t             i,
+            double                  dt,
+            const double*           shock,
+            const double*           loading,
+            unsigned                eligible,
+            const StateColumnsT<N>& X_next,
+            const EnvelopeColumns&  out
+        ) const noexcept;
+    };
+
+} // namespace fmrt
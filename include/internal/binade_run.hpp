@@ -0,0 +1,131 @@
+#pragma once
+//
+// FMRT Core V2.2
+// binade_run.hpp
+//
+// Exact repeated subtraction x_{j+1} = fl(x_j − c) inside one binade.
+// While every exact difference stays in the binade of x_0, each step
+// removes a constant number of ulps, so j steps are integer arithmetic
+// on the mantissa. Shared by fastForward() and collapseHorizon().
+//
+
+#include <cstdint>
+#include <cstring>
+
+namespace fmrt
+{
+    namespace binade
+    {
+        constexpr std::uint64_t MANT_MASK = 0x000FFFFFFFFFFFFFULL;
+        constexpr std::uint64_t IMPLICIT  = 0x0010000000000000ULL;
+        constexpr std::uint64_t UNBOUNDED = ~std::uint64_t{0};
+
+        inline std::uint64_t toBits(double x) noexcept
+        {
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof(double));
+            return b;
+        }
+
+        inline double fromBits(std::uint64_t b) noexcept
+        {
+            double x;
+            std::memcpy(&x, &b, sizeof(double));
+            return x;
+        }
+    } // namespace binade
+
+    // -------------------------------------------------------------------------
+    // BinadeRun:
+    //   x_{j+1} = fl(x_j − c) for positive normal x, while every exact
+    //   difference x_j − c stays in the binade of x_0. There the result
+    //   is x_j minus `step` ulps (the first step may differ on ties).
+    //   length == 0: not even the first step stays in the binade.
+    // -------------------------------------------------------------------------
+    struct BinadeRun
+    {
+        std::uint64_t hi     = 0;   // exponent bits of x_0
+        std::uint64_t mant   = 0;   // x_0 in ulps (53-bit)
+        std::uint64_t first  = 0;   // ulps removed by step 1
+        std::uint64_t step   = 0;   // ulps removed by every later step
+        std::uint64_t length = 0;   // steps that are exact (UNBOUNDED: all)
+
+        double value(std::uint64_t j) const noexcept
+        {
+            const std::uint64_t m =
+                (j == 0) ? mant : mant - first - (j - 1) * step;
+            return binade::fromBits(hi | (m & binade::MANT_MASK));
+        }
+    };
+
+    inline BinadeRun makeBinadeRun(double x, double c) noexcept
+    {
+        using namespace binade;
+
+        BinadeRun run;
+
+        const std::uint64_t bx = toBits(x);
+        const std::uint64_t ex = bx >> 52;              // sign bit is 0
+        if (!(x > 0.0) || ex == 0 || ex == 0x7FF || !(c >= 0.0))
+            return run;
+
+        run.hi   = bx & ~MANT_MASK;
+        run.mant = (bx & MANT_MASK) | IMPLICIT;
+
+        // c / ulp(x) = m + f,  f classified against 1/2
+        std::uint64_t m   = 0;
+        int           cmp = -1;                          // f < 1/2
+
+        if (c > 0.0)
+        {
+            const std::uint64_t bc = toBits(c);
+            const std::uint64_t ec = bc >> 52;
+            const std::uint64_t mc = (ec == 0) ? (bc & MANT_MASK)
+                                               : ((bc & MANT_MASK) | IMPLICIT);
+            const int d = static_cast<int>(ec == 0 ? 1 : ec) - static_cast<int>(ex);
+
+            if (d > 10)
+                return run;                              // c > x: leaves at once
+
+            if (d >= 0)
+            {
+                m = mc << d;
+            }
+            else if (-d < 64)
+            {
+                const int s = -d;
+                const std::uint64_t rem  = mc & ((std::uint64_t{1} << s) - 1);
+                const std::uint64_t half = std::uint64_t{1} << (s - 1);
+                m   = mc >> s;
+                cmp = (rem < half) ? -1 : (rem == half ? 0 : 1);
+            }
+        }
+
+        if (cmp == 0)
+        {
+            // ties-to-even: the result mantissa is always the even one
+            run.first = (((run.mant - m) & 1u) == 0) ? m : m + 1;
+            run.step  = ((m & 1u) == 0) ? m : m + 1;
+        }
+        else
+        {
+            run.first = run.step = (cmp > 0) ? m + 1 : m;
+        }
+
+        // x_j − c ≥ 2^e  ⇐  mant_j − (m + 1) ≥ 2^52
+        const std::uint64_t floor_mant = IMPLICIT + m + 1;
+        if (run.mant < floor_mant)
+            return run;
+
+        const std::uint64_t mant1 = run.mant - run.first;
+        if (mant1 < floor_mant)
+            run.length = 1;
+        else if (run.step == 0)
+            run.length = UNBOUNDED;
+        else
+            run.length = 2 + (mant1 - floor_mant) / run.step;
+
+        return run;
+    }
+
+} // namespace fmrt
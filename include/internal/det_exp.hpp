@@ -0,0 +1,154 @@
+#pragma once
+//
+// FMRT Core V2.2
+// det_exp.hpp
+//
+// Deterministic exp() for τ and det g (FMRT_DETERMINISTIC_EXP).
+//
+// Built only from correctly rounded IEEE-754 operations (+ − × ÷,
+// compare) and exact bit manipulation, evaluated in a fixed order, so
+// the result depends on the input bits alone — not on libm, compiler or
+// SIMD width. Requires -ffp-contract=off (set for fmrt_core).
+//
+// Algorithm (fdlibm-style):
+//   x = k·ln2 + r,  |r| <= ln2/2,  k = nearest(x / ln2)
+//   ln2 = LN2_HI + LN2_LO with LN2_HI carrying 32 bits, so k·LN2_HI is
+//   exact for every |k| <= 1075 and r is formed as (x − k·LN2_HI) − k·LN2_LO
+//   exp(r) = 1 + r + r·c / (2 − c),  c = r − r²·P(r²)  (P: degree-5 minimax)
+//   exp(x) = exp(r) · 2^k1 · 2^k2,  k1 + k2 = k (both factors normal, so
+//   only the last product rounds — also into the subnormal range)
+//
+// Error bound: < 1 ulp over the whole domain (dense-sample test in
+// tests/test_det_exp.cpp against a double-double reference).
+//
+// Special values: NaN -> NaN, x > EXP_OVERFLOW -> +inf,
+// x < EXP_UNDERFLOW -> +0.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "fmrt_config.hpp"
+
+#include "simd.hpp"
+
+namespace fmrt
+{
+    namespace detexp
+    {
+        constexpr double INV_LN2 = 1.44269504088896338700e+00;
+        constexpr double LN2_HI  = 6.93147180369123816490e-01;   // 0x3FE62E42FEE00000
+        constexpr double LN2_LO  = 1.90821492927058770002e-10;   // 0x3DEA39EF35793C76
+
+        // x + SHIFT rounds x to an integer held in the low mantissa bits
+        constexpr double SHIFT   = 0x1.8p52;
+
+        constexpr double P1 =  1.66666666666666019037e-01;
+        constexpr double P2 = -2.77777777770155933842e-03;
+        constexpr double P3 =  6.61375632143793436117e-05;
+        constexpr double P4 = -1.65339022054652515390e-06;
+        constexpr double P5 =  4.13813679705723846039e-08;
+
+        constexpr double EXP_OVERFLOW  =  7.09782712893383973096e+02;
+        constexpr double EXP_UNDERFLOW = -7.45133219101941108420e+02;
+
+        // 2^k for an integer-valued k in [-1022, 1023]
+        inline double pow2(double k) noexcept
+        {
+            const double  shifted = k + (SHIFT + 1023.0);   // low bits: k + 1023
+            std::uint64_t b;
+            std::memcpy(&b, &shifted, sizeof(double));
+            b <<= 52;
+            double r;
+            std::memcpy(&r, &b, sizeof(double));
+            return r;
+        }
+    } // namespace detexp
+
+    // -------------------------------------------------------------------------
+    // detExp: scalar kernel
+    // -------------------------------------------------------------------------
+    inline double detExp(double x) noexcept
+    {
+        using namespace detexp;
+
+        if (x != x)                 return x + x;           // NaN
+        if (x > EXP_OVERFLOW)       return HUGE_VAL;
+        if (x < EXP_UNDERFLOW)      return 0.0;
+
+        const double k  = (x * INV_LN2 + SHIFT) - SHIFT;    // nearest, ties-to-even
+        const double hi = x - k * LN2_HI;
+        const double lo = k * LN2_LO;
+        const double r  = hi - lo;
+
+        const double t  = r * r;
+        const double c  = r - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+        const double y  = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+
+        const double k1 = (k * 0.5 + SHIFT) - SHIFT;
+        const double k2 = k - k1;
+
+        return (y * pow2(k1)) * pow2(k2);
+    }
+
+    // -------------------------------------------------------------------------
+    // engineExp: exp used by the Evolution Engine for τ and det g
+    // -------------------------------------------------------------------------
+    inline double engineExp(double x) noexcept
+    {
+        if constexpr (DETERMINISTIC_EXP)
+            return detExp(x);
+        else
+            return std::exp(x);
+    }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+    namespace simd
+    {
+        // ---------------------------------------------------------------------
+        // detExp: lane version, the scalar kernel operation by operation
+        // (bit-identical per lane)
+        // ---------------------------------------------------------------------
+        inline VecD detExp(VecD x) noexcept
+        {
+            using namespace detexp;
+
+            const VecD shift = set1(SHIFT);
+
+            const VecD k  = sub(add(mul(x, set1(INV_LN2)), shift), shift);
+            const VecD hi = sub(x, mul(k, set1(LN2_HI)));
+            const VecD lo = mul(k, set1(LN2_LO));
+            const VecD r  = sub(hi, lo);
+
+            const VecD t  = mul(r, r);
+            VecD p = add(set1(P4), mul(t, set1(P5)));
+            p = add(set1(P3), mul(t, p));
+            p = add(set1(P2), mul(t, p));
+            p = add(set1(P1), mul(t, p));
+            const VecD c  = sub(r, mul(t, p));
+            const VecD y  = sub(set1(1.0),
+                                sub(sub(lo, div(mul(r, c), sub(set1(2.0), c))), hi));
+
+            const VecD k1 = sub(add(mul(k, set1(0.5)), shift), shift);
+            const VecD k2 = sub(k, k1);
+
+            const VecD bias = set1(SHIFT + 1023.0);
+            VecD e = mul(mul(y, shiftBits52(add(k1, bias))), shiftBits52(add(k2, bias)));
+
+            // special values (checked last, in the scalar order)
+            e = select(lt(x, set1(EXP_UNDERFLOW)), set1(0.0), e);
+            e = select(gt(x, set1(EXP_OVERFLOW)), set1(HUGE_VAL), e);
+            e = select(ne(x, x), add(x, x), e);
+            return e;
+        }
+    } // namespace simd
+#else
+    namespace simd
+    {
+        // one lane: the scalar kernel itself
+        inline VecD detExp(VecD x) noexcept { return { fmrt::detExp(x.v) }; }
+    } // namespace simd
+#endif
+
+} // namespace fmrt
@@ -21,7 +21,8 @@
 
 namespace fmrt
 {
-    class DiagnosticsLayer
+    template <std::size_t N>
+    class DiagnosticsLayerT
     {
     public:
 
@@ -31,14 +32,27 @@ namespace fmrt
         //   Copies X_next and metrics into envelope, marks status = OK.
         // ---------------------------------------------------------------------
         void buildOkEnvelope(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
             EventType event_type,
-            StateEnvelope& out_env
+            StateEnvelopeT<N>& out_env
         ) const noexcept
         {
             out_env.state          = X_next;
             out_env.metrics        = metrics;
+            finishOkEnvelope(event_type, out_env);
+        }
+
+        // ---------------------------------------------------------------------
+        // finishOkEnvelope:
+        //   Same as buildOkEnvelope when X_next and metrics were already
+        //   produced inside out_env (in-place stepping).
+        // ---------------------------------------------------------------------
+        void finishOkEnvelope(
+            EventType event_type,
+            StateEnvelopeT<N>& out_env
+        ) const noexcept
+        {
             out_env.status         = StepStatus::OK;
             out_env.error_category = ErrorCategory::None;
             out_env.error_reason   = ERR_NONE;
@@ -51,12 +65,12 @@ namespace fmrt
         //   X_preserved is usually X(t) (previous valid state).
         // ---------------------------------------------------------------------
         void buildErrorEnvelope(
-            const StructuralState& X_preserved,
+            const StructuralStateT<N>& X_preserved,
             const DerivedMetrics& metrics_preserved,
             EventType event_type,
             ErrorCategory category,
             const char* reason,
-            StateEnvelope& out_env
+            StateEnvelopeT<N>& out_env
         ) const noexcept
         {
             out_env.state          = X_preserved;
@@ -73,10 +87,10 @@ namespace fmrt
         //   All future non-RESET events should return this envelope unchanged.
         // ---------------------------------------------------------------------
         void buildDeadEnvelope(
-            const StructuralState& X_dead,
+            const StructuralStateT<N>& X_dead,
             const DerivedMetrics& metrics_dead,
             EventType event_type,
-            StateEnvelope& out_env
+            StateEnvelopeT<N>& out_env
         ) const noexcept
         {
             out_env.state          = X_dead;
@@ -88,4 +102,6 @@ namespace fmrt
         }
     };
 
+    using DiagnosticsLayer = DiagnosticsLayerT<DELTA_DIM>;
+
 } // namespace fmrt
@@ -8,15 +8,26 @@
 
 namespace fmrt
 {
-    class EventHandler
+    template <std::size_t N>
+    class EventHandlerT
     {
     public:
 
         // Stage 1 of FMRT pipeline — pure validation & canonicalization
-        bool validate(const StructEvent& E, StateEnvelope& out_env) const noexcept;
+        // check() returns ErrorCategory::None for an acceptable event.
+        ErrorCategory check(const StructEventT<N>& E) const noexcept;
+
+        // check() minus the finiteness test, for events that already
+        // passed the FpGuard numeric screen
+        ErrorCategory checkScreened(const StructEventT<N>& E) const noexcept;
+
+        // validate() = check() + error fields written into out_env
+        bool validate(const StructEventT<N>& E, StateEnvelopeT<N>& out_env) const noexcept;
 
         // Stage 2 — normalize event (stimulus, dt, etc.)
-        void canonicalize(StructEvent& E) const noexcept;
+        void canonicalize(StructEventT<N>& E) const noexcept;
     };
 
+    using EventHandler = EventHandlerT<DELTA_DIM>;
+
 } // namespace fmrt
@@ -1,65 +1,112 @@
 #pragma once
 
+#include <cstdint>
+
 #include "fmrt_state.hpp"
 #include "fmrt_event.hpp"
 #include "fmrt_metrics.hpp"
 #include "fmrt_envelope.hpp"
+#include "fmrt_horizon.hpp"
+#include "fmrt_carry.hpp"
 #include "fmrt_constants.hpp"
 
 namespace fmrt
 {
-    class EvolutionEngine
+    template <std::size_t N> struct EngineProbe;    // kernel_probe.hpp (benchmarks)
+
+    // Evolution Engine for an N-dimensional Δ. Explicitly instantiated for
+    // every size in FMRT_FOR_EACH_DELTA_DIM (evolution_engine.cpp).
+    template <std::size_t N>
+    class EvolutionEngineT
     {
     public:
+        // carry (optional): read when it matches X_current, rebound to
+        // next_state afterwards (invalidated on RESET / collapse)
         void evolve(
-            const StructuralState& X_current,
-            const StructEvent&    E,
-            StructuralState&      next_state,
-            DerivedMetrics&       metrics
+            const StructuralStateT<N>& X_current,
+            const StructEventT<N>&    E,
+            StructuralStateT<N>&      next_state,
+            DerivedMetrics&       metrics,
+            CarriedMetricsT<N>*   carry = nullptr
+        ) const noexcept;
+
+        // ---------------------------------------------------------------------
+        // fastForward (fast_forward.cpp):
+        //   Advances X by up to max_steps identical canonical GAP / HEARTBEAT
+        //   events in closed form and returns the number of steps taken.
+        //   Only runs without discrete events qualify (no collapse, Φ floor,
+        //   clipping, subnormal Δ or regime change); 0 means "take a scalar
+        //   step". κ and Φ are exact, Δ and M are closed-form approximations.
+        // ---------------------------------------------------------------------
+        std::uint64_t fastForward(
+            const StructuralStateT<N>& X_current,
+            const StructEventT<N>&    E,
+            std::uint64_t         max_steps,
+            StructuralStateT<N>&      next_state
+        ) const noexcept;
+
+        // ---------------------------------------------------------------------
+        // collapseHorizon (collapse_horizon.cpp):
+        //   Steps of the canonical event E until κ <= EPS_KAPPA (fills the
+        //   steps_* and exact fields of out). GAP / HEARTBEAT: exact, κ falls
+        //   by the constant dt·A4. UPDATE: conservative bounds from monotone
+        //   envelopes of R, Φ and μ along the run.
+        // ---------------------------------------------------------------------
+        void collapseHorizon(
+            const StructuralStateT<N>& X_current,
+            const StructEventT<N>&    E,
+            CollapseHorizon&      out
         ) const noexcept;
 
     private:
+        friend struct EngineProbe<N>;
+
+        static constexpr double MAX_DELTA = 10.0; // жёсткий предел деформации
 
         // === CORE UPDATE RULES (FMT 3.1) ====================================
 
         void updateDelta(
-            const StructuralState& X,
-            const StructEvent&    E,
+            const StructuralStateT<N>& X,
+            const StructEventT<N>&    E,
             double                mu,
-            StructuralState&      out
+            StructuralStateT<N>&      out
         ) const noexcept;
 
         void updatePhi(
-            const StructuralState& X,
-            const StructEvent&    E,
-            const StructuralState& X_next,
-            StructuralState&      out
+            const StructuralStateT<N>& X,
+            const StructEventT<N>&    E,
+            const StructuralStateT<N>& X_next,
+            StructuralStateT<N>&      out
         ) const noexcept;
 
         void updateMemory(
-            const StructuralState& X,
+            const StructuralStateT<N>& X,
             double                 tau,
-            const StructEvent&     E,
-            StructuralState&       out
+            const StructEventT<N>&     E,
+            StructuralStateT<N>&       out
         ) const noexcept;
 
         void updateKappa(
-            const StructuralState& X,
+            const StructuralStateT<N>& X,
             double                 R,
             double                 mu,
-            const StructEvent&     E,
-            StructuralState&       out
+            const StructEventT<N>&     E,
+            StructuralStateT<N>&       out
         ) const noexcept;
 
         // === METRICS ========================================================
 
-        double computeCurvature(const StructuralState& X) const noexcept;
+        double computeCurvature(const StructuralStateT<N>& X) const noexcept;
+        double deltaNorm2(const StructuralStateT<N>& X) const noexcept;
+        double curvatureFrom(double norm2, const StructuralStateT<N>& X) const noexcept;
         double computeDetG(double R, double kappa) const noexcept;
         double computeTau(double kappa) const noexcept;
         double computeMu(double curvature_R) const noexcept;
         MorphologyClass classifyMorphology(double mu) const noexcept;
         Regime computeRegime(Regime prev, MorphologyClass mc, double kappa) const noexcept;
 
-        void processCollapse(StructuralState& X, DerivedMetrics& M) const noexcept;
+        void processCollapse(StructuralStateT<N>& X, DerivedMetrics& M) const noexcept;
     };
+
+    using EvolutionEngine = EvolutionEngineT<DELTA_DIM>;
 }
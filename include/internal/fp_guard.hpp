@@ -5,17 +5,34 @@
 //
 // Ensures strict IEEE-754 environment, FE_TONEAREST rounding,
 // and finiteness checks for all numeric values.
-// This module contains ONLY inline constexpr / noexcept logic.
+// Everything is noexcept; only the state / event screens live in
+// fp_guard.cpp (they may use SIMD and are instantiated per Δ dimension).
 // No allocations, no I/O, no exceptions.
 //
 
 #include <cfenv>
 #include <cmath>
+#include <cstddef>
 
 #include "fmrt_config.hpp"
+#include "fmrt_state.hpp"
+#include "fmrt_event.hpp"
 
 namespace fmrt
 {
+    // -------------------------------------------------------------------------
+    // Screen result bits (one pass over every double of X and E)
+    // -------------------------------------------------------------------------
+    enum ScreenBits : unsigned
+    {
+        SCREEN_STATE_NONFINITE = 1u << 0,   // NaN / Inf in Δ, Φ, M or κ
+        SCREEN_STATE_SUBNORMAL = 1u << 1,
+        SCREEN_DT_NONFINITE    = 1u << 2,
+        SCREEN_DT_SUBNORMAL    = 1u << 3,
+        SCREEN_STIM_NONFINITE  = 1u << 4,
+        SCREEN_STIM_SUBNORMAL  = 1u << 5
+    };
+
     class FpGuard
     {
     public:
@@ -64,6 +81,30 @@ namespace fmrt
         {
             dst = numericSafe(src) ? src : 0.0;
         }
+
+        // ---------------------------------------------------------------------
+        // screen(X) / screen(E)
+        // Classifies every double by its exponent bits in a single pass and
+        // returns the ScreenBits that occurred. No early exits.
+        // ---------------------------------------------------------------------
+        template <std::size_t N>
+        unsigned screen(const StructuralStateT<N>& X) const noexcept;
+
+        template <std::size_t N>
+        unsigned screen(const StructEventT<N>& E) const noexcept;
+
+        // ---------------------------------------------------------------------
+        // numericReject(bits, type)
+        // Global numeric reject of FMRT_Step: any NaN / Inf / subnormal,
+        // except that a RESET event's stimulus only has to be non-subnormal
+        // (StructEvent::isFinite ignores it).
+        // ---------------------------------------------------------------------
+        static constexpr bool numericReject(unsigned bits, EventType type) noexcept
+        {
+            const unsigned ignored =
+                (type == EventType::Reset) ? unsigned(SCREEN_STIM_NONFINITE) : 0u;
+            return (bits & ~ignored) != 0u;
+        }
     };
 
 } // namespace fmrt
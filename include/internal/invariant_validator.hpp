@@ -9,37 +9,49 @@
 
 namespace fmrt
 {
-    class InvariantValidator
+    template <std::size_t N> struct ValidatorProbe;     // kernel_probe.hpp (benchmarks)
+
+    template <std::size_t N>
+    class InvariantValidatorT
     {
     public:
         bool validate(
-            const StructuralState& X_current,
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_current,
+            const StructuralStateT<N>& X_next,
+            const DerivedMetrics& metrics,
+            StateEnvelopeT<N>& out_env
+        ) const noexcept;
+
+        // Same checks, result written straight into caller storage
+        bool validate(
+            const StructuralStateT<N>& X_current,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
-            StateEnvelope& out_env
+            InvariantStatus& out
         ) const noexcept;
 
     private:
+        friend struct ValidatorProbe<N>;
 
         bool checkMemory(
-            const StructuralState& X_cur,
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_cur,
+            const StructuralStateT<N>& X_next,
             InvariantStatus& st
         ) const noexcept;
 
         bool checkKappa(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             InvariantStatus& st
         ) const noexcept;
 
         bool checkMetric(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
             InvariantStatus& st
         ) const noexcept;
 
         bool checkTau(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
             InvariantStatus& st
         ) const noexcept;
@@ -56,16 +68,18 @@ namespace fmrt
         ) const noexcept;
 
         bool checkCollapse(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
             InvariantStatus& st
         ) const noexcept;
 
         bool checkForbidden(
-            const StructuralState& X_next,
+            const StructuralStateT<N>& X_next,
             const DerivedMetrics& metrics,
             InvariantStatus& st
         ) const noexcept;
     };
 
+    using InvariantValidator = InvariantValidatorT<DELTA_DIM>;
+
 } // namespace fmrt
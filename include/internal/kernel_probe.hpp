@@ -0,0 +1,154 @@
+#pragma once
+//
+// FMRT Core V2.2
+// kernel_probe.hpp
+//
+// Measurement access to the private kernels of EvolutionEngineT and
+// InvariantValidatorT, for the benchmarks in bench/. Each probe forwards
+// to exactly one member function (compiled in evolution_engine.cpp /
+// invariant_validator.cpp), so what is timed is the kernel the step
+// pipeline calls — not a copy of it.
+//
+// Not part of the API: signatures follow the engine internals.
+//
+
+#include "internal/evolution_engine.hpp"
+#include "internal/invariant_validator.hpp"
+
+namespace fmrt
+{
+    template <std::size_t N>
+    struct EngineProbe
+    {
+        using Engine = EvolutionEngineT<N>;
+        using State  = StructuralStateT<N>;
+        using Event  = StructEventT<N>;
+
+        // --- update rules ----------------------------------------------------
+        static void updateDelta(const Engine& e, const State& X, const Event& E,
+                                double mu, State& out) noexcept
+        {
+            e.updateDelta(X, E, mu, out);
+        }
+
+        static void updatePhi(const Engine& e, const State& X, const Event& E,
+                              const State& X_next, State& out) noexcept
+        {
+            e.updatePhi(X, E, X_next, out);
+        }
+
+        static void updateMemory(const Engine& e, const State& X, double tau,
+                                 const Event& E, State& out) noexcept
+        {
+            e.updateMemory(X, tau, E, out);
+        }
+
+        static void updateKappa(const Engine& e, const State& X, double R, double mu,
+                                const Event& E, State& out) noexcept
+        {
+            e.updateKappa(X, R, mu, E, out);
+        }
+
+        // --- metrics ---------------------------------------------------------
+        static double computeCurvature(const Engine& e, const State& X) noexcept
+        {
+            return e.computeCurvature(X);
+        }
+
+        static double deltaNorm2(const Engine& e, const State& X) noexcept
+        {
+            return e.deltaNorm2(X);
+        }
+
+        static double curvatureFrom(const Engine& e, double norm2, const State& X) noexcept
+        {
+            return e.curvatureFrom(norm2, X);
+        }
+
+        static double computeDetG(const Engine& e, double R, double kappa) noexcept
+        {
+            return e.computeDetG(R, kappa);
+        }
+
+        static double computeTau(const Engine& e, double kappa) noexcept
+        {
+            return e.computeTau(kappa);
+        }
+
+        static double computeMu(const Engine& e, double R) noexcept
+        {
+            return e.computeMu(R);
+        }
+
+        static MorphologyClass classifyMorphology(const Engine& e, double mu) noexcept
+        {
+            return e.classifyMorphology(mu);
+        }
+
+        static Regime computeRegime(const Engine& e, Regime prev, MorphologyClass mc,
+                                    double kappa) noexcept
+        {
+            return e.computeRegime(prev, mc, kappa);
+        }
+
+        static void processCollapse(const Engine& e, State& X, DerivedMetrics& M) noexcept
+        {
+            e.processCollapse(X, M);
+        }
+    };
+
+    template <std::size_t N>
+    struct ValidatorProbe
+    {
+        using Validator = InvariantValidatorT<N>;
+        using State     = StructuralStateT<N>;
+
+        static bool checkMemory(const Validator& v, const State& X_cur, const State& X_next,
+                                InvariantStatus& st) noexcept
+        {
+            return v.checkMemory(X_cur, X_next, st);
+        }
+
+        static bool checkKappa(const Validator& v, const State& X_next, InvariantStatus& st) noexcept
+        {
+            return v.checkKappa(X_next, st);
+        }
+
+        static bool checkMetric(const Validator& v, const State& X_next, const DerivedMetrics& M,
+                                InvariantStatus& st) noexcept
+        {
+            return v.checkMetric(X_next, M, st);
+        }
+
+        static bool checkTau(const Validator& v, const State& X_next, const DerivedMetrics& M,
+                             InvariantStatus& st) noexcept
+        {
+            return v.checkTau(X_next, M, st);
+        }
+
+        static bool checkMorphology(const Validator& v, const DerivedMetrics& M,
+                                    InvariantStatus& st) noexcept
+        {
+            return v.checkMorphology(M, st);
+        }
+
+        static bool checkRegime(const Validator& v, Regime prev, Regime next,
+                                InvariantStatus& st) noexcept
+        {
+            return v.checkRegime(prev, next, st);
+        }
+
+        static bool checkCollapse(const Validator& v, const State& X_next, const DerivedMetrics& M,
+                                  InvariantStatus& st) noexcept
+        {
+            return v.checkCollapse(X_next, M, st);
+        }
+
+        static bool checkForbidden(const Validator& v, const State& X_next, const DerivedMetrics& M,
+                                   InvariantStatus& st) noexcept
+        {
+            return v.checkForbidden(X_next, M, st);
+        }
+    };
+
+} // namespace fmrt
@@ -0,0 +1,263 @@
+#pragma once
+//
+// FMRT Core V2.2
+// simd.hpp
+//
+// Thin lane wrappers over AVX2 / AVX-512 double vectors used by the
+// batch kernel. Only IEEE-754 correctly rounded operations are exposed
+// (add, sub, mul, div, sqrt, compare, blend) plus exact bit manipulation,
+// so every lane produces the same bits as the scalar Evolution Engine.
+// No FMA, no approximations.
+//
+// The instruction set is selected at compile time (FMRT_SIMD in CMake).
+// Without AVX2/AVX-512 LANES == 1: the wrappers act on one plain double,
+// so the broadcast steps keep their single-event kernels, while
+// FMRT_StepBatch falls back to FMRT_Step for every organism.
+//
+
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#   include <immintrin.h>
+#else
+#   include <cmath>
+#   include <cstdint>
+#   include <cstring>
+#endif
+
+namespace fmrt
+{
+namespace simd
+{
+#if defined(__AVX512F__)
+
+    constexpr std::size_t LANES = 8;
+
+    struct VecD  { __m512d v; };
+    struct MaskD { __mmask8 m; };
+
+    inline VecD set1(double x) noexcept               { return { _mm512_set1_pd(x) }; }
+    inline VecD load(const double* p) noexcept        { return { _mm512_loadu_pd(p) }; }
+    inline void store(double* p, VecD a) noexcept     { _mm512_storeu_pd(p, a.v); }
+
+    inline VecD add(VecD a, VecD b) noexcept  { return { _mm512_add_pd(a.v, b.v) }; }
+    inline VecD sub(VecD a, VecD b) noexcept  { return { _mm512_sub_pd(a.v, b.v) }; }
+    inline VecD mul(VecD a, VecD b) noexcept  { return { _mm512_mul_pd(a.v, b.v) }; }
+    inline VecD div(VecD a, VecD b) noexcept  { return { _mm512_div_pd(a.v, b.v) }; }
+    // zero-masked form: same result; _mm512_sqrt_pd passes _mm512_undefined_pd()
+    // as pass-through, which GCC 12 reports as -Wmaybe-uninitialized
+    inline VecD sqrt(VecD a) noexcept         { return { _mm512_maskz_sqrt_pd(0xFF, a.v) }; }
+
+    inline MaskD lt(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ) }; }
+    inline MaskD le(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ) }; }
+    inline MaskD gt(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ) }; }
+    inline MaskD ge(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ) }; }
+    inline MaskD eq(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ) }; }
+    inline MaskD ne(VecD a, VecD b) noexcept  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_NEQ_OQ) }; }
+
+    inline MaskD operator&(MaskD a, MaskD b) noexcept { return { static_cast<__mmask8>(a.m & b.m) }; }
+    inline MaskD operator|(MaskD a, MaskD b) noexcept { return { static_cast<__mmask8>(a.m | b.m) }; }
+    inline MaskD operator~(MaskD a) noexcept          { return { static_cast<__mmask8>(~a.m) }; }
+
+    // select(m, a, b) = m ? a : b (per lane)
+    inline VecD select(MaskD m, VecD a, VecD b) noexcept
+    {
+        return { _mm512_mask_blend_pd(m.m, b.v, a.v) };
+    }
+
+    inline unsigned bits(MaskD m) noexcept { return static_cast<unsigned>(m.m); }
+    inline MaskD fromBits(unsigned b) noexcept { return { static_cast<__mmask8>(b) }; }
+
+    inline void storeMasked(double* p, MaskD m, VecD a) noexcept
+    {
+        _mm512_mask_storeu_pd(p, m.m, a.v);
+    }
+
+    inline VecD abs(VecD a) noexcept
+    {
+        return { _mm512_castsi512_pd(_mm512_and_epi64(
+            _mm512_castpd_si512(a.v),
+            _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL))) };
+    }
+
+    // Bit pattern shifted left by 52 (builds 2^k from a shifted integer);
+    // zero-masked for the same reason as sqrt
+    inline VecD shiftBits52(VecD a) noexcept
+    {
+        return { _mm512_castsi512_pd(_mm512_maskz_slli_epi64(0xFF, _mm512_castpd_si512(a.v), 52)) };
+    }
+
+    // Exponent-bit classification (independent of DAZ / FTZ modes)
+    inline MaskD nonFinite(VecD a) noexcept
+    {
+        const __m512i exp = _mm512_set1_epi64(0x7FF0000000000000LL);
+        return { _mm512_cmpeq_epi64_mask(
+            _mm512_and_epi64(_mm512_castpd_si512(a.v), exp), exp) };
+    }
+
+    inline MaskD subnormal(VecD a) noexcept
+    {
+        const __m512i b    = _mm512_castpd_si512(a.v);
+        const __m512i zero = _mm512_setzero_si512();
+        const __mmask8 e0 = _mm512_cmpeq_epi64_mask(
+            _mm512_and_epi64(b, _mm512_set1_epi64(0x7FF0000000000000LL)), zero);
+        const __mmask8 f1 = _mm512_cmpneq_epi64_mask(
+            _mm512_and_epi64(b, _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)), zero);
+        return { static_cast<__mmask8>(e0 & f1) };
+    }
+
+#elif defined(__AVX2__)
+
+    constexpr std::size_t LANES = 4;
+
+    struct VecD  { __m256d v; };
+    struct MaskD { __m256d m; };
+
+    inline VecD set1(double x) noexcept               { return { _mm256_set1_pd(x) }; }
+    inline VecD load(const double* p) noexcept        { return { _mm256_loadu_pd(p) }; }
+    inline void store(double* p, VecD a) noexcept     { _mm256_storeu_pd(p, a.v); }
+
+    inline VecD add(VecD a, VecD b) noexcept  { return { _mm256_add_pd(a.v, b.v) }; }
+    inline VecD sub(VecD a, VecD b) noexcept  { return { _mm256_sub_pd(a.v, b.v) }; }
+    inline VecD mul(VecD a, VecD b) noexcept  { return { _mm256_mul_pd(a.v, b.v) }; }
+    inline VecD div(VecD a, VecD b) noexcept  { return { _mm256_div_pd(a.v, b.v) }; }
+    inline VecD sqrt(VecD a) noexcept         { return { _mm256_sqrt_pd(a.v) }; }
+
+    inline MaskD lt(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+    inline MaskD le(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+    inline MaskD gt(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+    inline MaskD ge(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+    inline MaskD eq(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; }
+    inline MaskD ne(VecD a, VecD b) noexcept  { return { _mm256_cmp_pd(a.v, b.v, _CMP_NEQ_OQ) }; }
+
+    inline MaskD operator&(MaskD a, MaskD b) noexcept { return { _mm256_and_pd(a.m, b.m) }; }
+    inline MaskD operator|(MaskD a, MaskD b) noexcept { return { _mm256_or_pd(a.m, b.m) }; }
+    inline MaskD operator~(MaskD a) noexcept
+    {
+        return { _mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))) };
+    }
+
+    // select(m, a, b) = m ? a : b (per lane)
+    inline VecD select(MaskD m, VecD a, VecD b) noexcept
+    {
+        return { _mm256_blendv_pd(b.v, a.v, m.m) };
+    }
+
+    inline unsigned bits(MaskD m) noexcept { return static_cast<unsigned>(_mm256_movemask_pd(m.m)); }
+
+    inline MaskD fromBits(unsigned b) noexcept
+    {
+        return { _mm256_castsi256_pd(_mm256_set_epi64x(
+            -static_cast<long long>((b >> 3) & 1u),
+            -static_cast<long long>((b >> 2) & 1u),
+            -static_cast<long long>((b >> 1) & 1u),
+            -static_cast<long long>(b & 1u))) };
+    }
+
+    inline void storeMasked(double* p, MaskD m, VecD a) noexcept
+    {
+        _mm256_maskstore_pd(p, _mm256_castpd_si256(m.m), a.v);
+    }
+
+    inline VecD abs(VecD a) noexcept
+    {
+        return { _mm256_and_pd(a.v, _mm256_castsi256_pd(
+            _mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL))) };
+    }
+
+    // Bit pattern shifted left by 52 (builds 2^k from a shifted integer)
+    inline VecD shiftBits52(VecD a) noexcept
+    {
+        return { _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a.v), 52)) };
+    }
+
+    // Exponent-bit classification (independent of DAZ / FTZ modes)
+    inline MaskD nonFinite(VecD a) noexcept
+    {
+        const __m256i exp = _mm256_set1_epi64x(0x7FF0000000000000LL);
+        return { _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+            _mm256_and_si256(_mm256_castpd_si256(a.v), exp), exp)) };
+    }
+
+    inline MaskD subnormal(VecD a) noexcept
+    {
+        const __m256i b    = _mm256_castpd_si256(a.v);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i e0 = _mm256_cmpeq_epi64(
+            _mm256_and_si256(b, _mm256_set1_epi64x(0x7FF0000000000000LL)), zero);
+        const __m256i f0 = _mm256_cmpeq_epi64(
+            _mm256_and_si256(b, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)), zero);
+        return { _mm256_castsi256_pd(_mm256_andnot_si256(f0, e0)) };
+    }
+
+#else
+
+    constexpr std::size_t LANES = 1;
+
+    struct VecD  { double v; };
+    struct MaskD { bool m; };
+
+    inline VecD set1(double x) noexcept               { return { x }; }
+    inline VecD load(const double* p) noexcept        { return { *p }; }
+    inline void store(double* p, VecD a) noexcept     { *p = a.v; }
+
+    inline VecD add(VecD a, VecD b) noexcept  { return { a.v + b.v }; }
+    inline VecD sub(VecD a, VecD b) noexcept  { return { a.v - b.v }; }
+    inline VecD mul(VecD a, VecD b) noexcept  { return { a.v * b.v }; }
+    inline VecD div(VecD a, VecD b) noexcept  { return { a.v / b.v }; }
+    inline VecD sqrt(VecD a) noexcept         { return { std::sqrt(a.v) }; }
+
+    // ordered, quiet: false when either operand is NaN (as _CMP_*_OQ)
+    inline MaskD lt(VecD a, VecD b) noexcept  { return { a.v < b.v }; }
+    inline MaskD le(VecD a, VecD b) noexcept  { return { a.v <= b.v }; }
+    inline MaskD gt(VecD a, VecD b) noexcept  { return { a.v > b.v }; }
+    inline MaskD ge(VecD a, VecD b) noexcept  { return { a.v >= b.v }; }
+    inline MaskD eq(VecD a, VecD b) noexcept  { return { a.v == b.v }; }
+    inline MaskD ne(VecD a, VecD b) noexcept  { return { a.v < b.v || a.v > b.v }; }
+
+    inline MaskD operator&(MaskD a, MaskD b) noexcept { return { a.m && b.m }; }
+    inline MaskD operator|(MaskD a, MaskD b) noexcept { return { a.m || b.m }; }
+    inline MaskD operator~(MaskD a) noexcept          { return { !a.m }; }
+
+    inline VecD select(MaskD m, VecD a, VecD b) noexcept { return m.m ? a : b; }
+
+    inline unsigned bits(MaskD m) noexcept { return m.m ? 1u : 0u; }
+    inline MaskD fromBits(unsigned b) noexcept { return { (b & 1u) != 0 }; }
+
+    inline void storeMasked(double* p, MaskD m, VecD a) noexcept
+    {
+        if (m.m) *p = a.v;
+    }
+
+    inline VecD abs(VecD a) noexcept { return { std::fabs(a.v) }; }
+
+    inline std::uint64_t bitsOf(double x) noexcept
+    {
+        std::uint64_t b;
+        std::memcpy(&b, &x, sizeof(double));
+        return b;
+    }
+
+    inline VecD shiftBits52(VecD a) noexcept
+    {
+        const std::uint64_t b = bitsOf(a.v) << 52;
+        double r;
+        std::memcpy(&r, &b, sizeof(double));
+        return { r };
+    }
+
+    inline MaskD nonFinite(VecD a) noexcept
+    {
+        return { (bitsOf(a.v) & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL };
+    }
+
+    inline MaskD subnormal(VecD a) noexcept
+    {
+        const std::uint64_t b = bitsOf(a.v);
+        return { (b & 0x7FF0000000000000ULL) == 0 && (b & 0x000FFFFFFFFFFFFFULL) != 0 };
+    }
+
+#endif
+
+} // namespace simd
+} // namespace fmrt
@@ -0,0 +1,69 @@
+#pragma once
+//
+// FMRT Core V2.2
+// stage_profile.hpp
+//
+// Stage timing hooks of the step pipeline (public side: fmrt_profile.hpp).
+//
+//   FMRT_STAGE_START();                     // opens a timed sequence
+//   FMRT_STAGE_LAP(PipelineStage::Evolve);  // time since the last mark -> Evolve
+//
+// Without FMRT_STAGE_PROFILING both expand to nothing: no clock reads,
+// no thread-local access, no code.
+//
+
+#include "fmrt_config.hpp"
+#include "fmrt_profile.hpp"
+
+#if FMRT_STAGE_PROFILING
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define FMRT_STAGE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#   define FMRT_STAGE_HAS_TSC 1
+#else
+#   include <chrono>
+#endif
+
+namespace fmrt
+{
+    namespace stage_profile
+    {
+        inline std::uint64_t now() noexcept
+        {
+#if defined(FMRT_STAGE_HAS_TSC)
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        // records t - since for stage s in this thread's histograms
+        void record(PipelineStage s, std::uint64_t ticks) noexcept;
+
+        inline std::uint64_t lap(PipelineStage s, std::uint64_t since) noexcept
+        {
+            const std::uint64_t t = now();
+            record(s, t - since);
+            return t;
+        }
+    } // namespace stage_profile
+} // namespace fmrt
+
+#define FMRT_STAGE_START() \
+    std::uint64_t fmrt_stage_mark_ = ::fmrt::stage_profile::now()
+#define FMRT_STAGE_LAP(stage) \
+    (fmrt_stage_mark_ = ::fmrt::stage_profile::lap((stage), fmrt_stage_mark_))
+
+#else
+
+#define FMRT_STAGE_START()      ((void)0)
+#define FMRT_STAGE_LAP(stage)   ((void)0)
+
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+//
+// FMRT Core V2.2
+// unroll.hpp
+//
+// Compile-time loop unrolling over Δ components.
+// forEachIndex<N>(f) calls f(0), f(1), ..., f(N-1) in this order.
+// For N <= UNROLL_LIMIT the calls are expanded at compile time, larger
+// N use a plain loop. The evaluation order is the same in both forms, so
+// accumulations round identically.
+//
+
+#include <cstddef>
+#include <utility>
+
+namespace fmrt
+{
+    constexpr std::size_t UNROLL_LIMIT = 16;
+
+    namespace detail
+    {
+        template <class F, std::size_t... I>
+        inline void unrolled(F& f, std::index_sequence<I...>) noexcept
+        {
+            (f(I), ...);
+        }
+    }
+
+    template <std::size_t N, class F>
+    inline void forEachIndex(F&& f) noexcept
+    {
+        if constexpr (N <= UNROLL_LIMIT)
+        {
+            detail::unrolled(f, std::make_index_sequence<N>{});
+        }
+        else
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                f(i);
+        }
+    }
+
+} // namespace fmrt
@@ -0,0 +1,477 @@
+//
+// FMRT Core V2.2
+// fmrt_event_log.cpp
+//
+// Writer, reader and CRC-32C behind fmrt_event_log.hpp.
+//
+// CRC-32C is computed slicing-by-8 (eight 256-entry tables, one 64-bit
+// word per step), about one byte per cycle without special instructions.
+//
+// Appending to an existing log walks its block headers with fread / fseek
+// (payloads are not read), keeps every block whose header is intact and
+// whose payload is complete, and truncates whatever follows.
+//
+
+#include "fmrt_event_log.hpp"
+
+#include <filesystem>
+#include <limits>
+
+namespace fmrt
+{
+    namespace
+    {
+        constexpr char          FILE_MAGIC[8] = { 'F', 'M', 'R', 'T', 'E', 'L', 'O', 'G' };
+        constexpr std::uint32_t ENDIAN_MARK   = 0x01020304u;
+        constexpr std::int64_t  MAX_DELTA     = std::numeric_limits<std::uint32_t>::max();
+
+        struct Crc32cTables
+        {
+            std::uint32_t t[8][256];
+
+            Crc32cTables() noexcept
+            {
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    std::uint32_t c = i;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c >> 1) ^ ((c & 1u) ? 0x82F63B78u : 0u);     // reflected Castagnoli
+                    t[0][i] = c;
+                }
+                for (std::uint32_t i = 0; i < 256; ++i)
+                    for (int s = 1; s < 8; ++s)
+                        t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFFu];
+            }
+        };
+
+        const Crc32cTables& crcTables() noexcept
+        {
+            static const Crc32cTables tables;
+            return tables;
+        }
+
+        bool validFileHeader(const EventLogFileHeader& h, std::string& why)
+        {
+            if (std::memcmp(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+                why = "not an FMRT event log";
+            else if (h.endian != ENDIAN_MARK)
+                why = "event log written with another byte order";
+            else if (h.version != EVENT_LOG_VERSION)
+                why = "unsupported event log version " + std::to_string(h.version);
+            else if (h.delta_dim != DELTA_DIM)
+                why = "event log has delta_dim " + std::to_string(h.delta_dim) +
+                      ", this build " + std::to_string(DELTA_DIM);
+            else
+                return true;
+            return false;
+        }
+
+        inline bool validType(unsigned char t) noexcept
+        {
+            return t <= static_cast<unsigned char>(EventType::Reset);
+        }
+    } // namespace
+
+std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc) noexcept
+{
+    const Crc32cTables&  T = crcTables();
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+
+    crc = ~crc;
+    for (; n >= 8; n -= 8, p += 8)
+    {
+        std::uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + 4, 4);
+        lo ^= crc;      // little-endian word order
+
+        crc = T.t[7][lo & 0xFFu]         ^ T.t[6][(lo >> 8) & 0xFFu] ^
+              T.t[5][(lo >> 16) & 0xFFu] ^ T.t[4][lo >> 24]          ^
+              T.t[3][hi & 0xFFu]         ^ T.t[2][(hi >> 8) & 0xFFu] ^
+              T.t[1][(hi >> 16) & 0xFFu] ^ T.t[0][hi >> 24];
+    }
+    for (; n > 0; --n, ++p)
+        crc = (crc >> 8) ^ T.t[0][(crc ^ *p) & 0xFFu];
+
+    return ~crc;
+}
+
+// ============================================================================
+// EventLogWriter
+// ============================================================================
+EventLogWriter::~EventLogWriter()
+{
+    close();
+}
+
+bool EventLogWriter::fail(const std::string& what)
+{
+    err = what;
+    return false;
+}
+
+bool EventLogWriter::open(const char* path, const EventLogOptions& options)
+{
+    if (file && !close())
+        return false;
+
+    opt = options;
+    if (opt.block_records == 0)
+        opt.block_records = 1;
+
+    block.clear();
+    out.clear();
+    block_count = 0;
+    next_record = 0;
+    dropped     = 0;
+    err.clear();
+
+    std::error_code ec;
+    const std::uintmax_t existing = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+
+    if (existing == 0)
+    {
+        file = std::fopen(path, "wb");
+        if (!file)
+            return fail(std::string("cannot create ") + path);
+
+        EventLogFileHeader h{};
+        std::memcpy(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        h.version   = EVENT_LOG_VERSION;
+        h.delta_dim = static_cast<std::uint16_t>(DELTA_DIM);
+        h.endian    = ENDIAN_MARK;
+
+        if (std::fwrite(&h, sizeof(h), 1, file) != 1 || std::fflush(file) != 0)
+        {
+            std::fclose(file);
+            file = nullptr;
+            return fail(std::string("cannot write ") + path);
+        }
+        block_first = 0;
+        return true;
+    }
+
+    // --- append: validate, find the end of the last intact block ------------
+    std::FILE* in = std::fopen(path, "rb");
+    if (!in)
+        return fail(std::string("cannot open ") + path);
+
+    EventLogFileHeader h;
+    std::string        why;
+    if (std::fread(&h, sizeof(h), 1, in) != 1)
+        why = "event log header is incomplete";
+    else
+        validFileHeader(h, why);
+
+    // Only a torn tail is cut: a partial block header, or a block shorter
+    // than its header declares. Any other bad header stops the append,
+    // since truncating there would drop the intact blocks behind it.
+    std::uintmax_t good = sizeof(EventLogFileHeader);
+    while (why.empty() && good < existing)
+    {
+        EventLogBlockHeader b;
+        if (existing - good < sizeof(b))
+            break;                                          // torn header
+        if (std::fread(&b, sizeof(b), 1, in) != 1)
+            why = std::string("cannot read ") + path;
+        else if (b.magic != EVENT_LOG_BLOCK_MAGIC || b.payload_bytes % 8 != 0)
+            why = "corrupt block header at byte " + std::to_string(good) + " of " + path +
+                  "; not appending";
+        else if (b.payload_bytes > existing - good - sizeof(b))
+            break;                                          // torn payload
+        else if (std::fseek(in, static_cast<long>(b.payload_bytes), SEEK_CUR) != 0)
+            why = std::string("cannot read ") + path;
+        else
+        {
+            good       += sizeof(b) + b.payload_bytes;
+            next_record = b.first_record + b.records;
+        }
+    }
+    std::fclose(in);
+
+    if (!why.empty())
+        return fail(why);
+
+    if (good < existing)
+    {
+        std::filesystem::resize_file(path, good, ec);
+        if (ec)
+            return fail(std::string("cannot truncate the torn tail of ") + path);
+        dropped = existing - good;
+    }
+
+    file = std::fopen(path, "ab");
+    if (!file)
+        return fail(std::string("cannot append to ") + path);
+
+    block_first = next_record;
+    return true;
+}
+
+bool EventLogWriter::append(std::int64_t time, const FleetEvent& e)
+{
+    if (!file)
+        return fail("event log is not open");
+
+    if (block_count > 0)
+    {
+        const bool fits = time >= last_time && time - last_time <= MAX_DELTA;
+        if (!fits || block_count >= opt.block_records)
+            if (!seal())
+                return false;
+    }
+
+    if (block_count == 0)
+    {
+        base_time   = time;
+        last_time   = time;
+        block_first = next_record;
+    }
+
+    const bool          update = e.type == EventType::Update;
+    const std::size_t   bytes  = update ? EVENT_LOG_RECORD_MAX : EVENT_LOG_RECORD_BASE;
+    const std::size_t   at     = block.size();
+    const std::uint32_t delta  = static_cast<std::uint32_t>(time - last_time);
+
+    block.resize(at + bytes, 0);
+    unsigned char* r = block.data() + at;
+
+    std::memcpy(r + EVENT_LOG_AT_ID, &e.id, 4);
+    std::memcpy(r + EVENT_LOG_AT_DELTA, &delta, 4);
+    r[EVENT_LOG_AT_TYPE] = static_cast<unsigned char>(e.type);
+    std::memcpy(r + EVENT_LOG_AT_DT, &e.dt, 8);
+    if (update)
+        std::memcpy(r + EVENT_LOG_AT_STIMULUS, e.stimulus, 8 * DELTA_DIM);
+
+    last_time = time;
+    ++block_count;
+    ++next_record;
+    return true;
+}
+
+bool EventLogWriter::append(const std::int64_t* time, const FleetEvent* e, std::size_t n)
+{
+    block.reserve(block.size() + n * EVENT_LOG_RECORD_MAX);
+    for (std::size_t j = 0; j < n; ++j)
+        if (!append(time[j], e[j]))
+            return false;
+    return true;
+}
+
+bool EventLogWriter::seal()
+{
+    if (block_count == 0)
+        return true;
+
+    block.resize((block.size() + 7) & ~std::size_t{7}, 0);     // next header 8-aligned
+
+    EventLogBlockHeader h;
+    h.magic         = EVENT_LOG_BLOCK_MAGIC;
+    h.records       = block_count;
+    h.payload_bytes = static_cast<std::uint32_t>(block.size());
+    h.checksum      = crc32c(block.data(), block.size());
+    h.base_time     = base_time;
+    h.first_record  = block_first;
+
+    const unsigned char* hp = reinterpret_cast<const unsigned char*>(&h);
+    out.insert(out.end(), hp, hp + sizeof(h));
+    out.insert(out.end(), block.begin(), block.end());
+
+    block.clear();
+    block_count = 0;
+
+    if (out.size() >= opt.flush_bytes)
+    {
+        if (std::fwrite(out.data(), 1, out.size(), file) != out.size())
+            return fail("event log write failed");
+        out.clear();
+    }
+    return true;
+}
+
+bool EventLogWriter::flush()
+{
+    if (!file)
+        return fail("event log is not open");
+    if (!seal())
+        return false;
+
+    if (!out.empty() && std::fwrite(out.data(), 1, out.size(), file) != out.size())
+        return fail("event log write failed");
+    out.clear();
+
+    if (std::fflush(file) != 0)
+        return fail("event log flush failed");
+    return true;
+}
+
+bool EventLogWriter::close()
+{
+    if (!file)
+        return true;
+
+    const bool ok = flush();
+    const bool closed = std::fclose(file) == 0;
+    file = nullptr;
+
+    if (!closed && ok)
+        return fail("event log close failed");
+    return ok;
+}
+
+// ============================================================================
+// EventLogRecordView
+// ============================================================================
+StructEvent EventLogRecordView::event() const noexcept
+{
+    StructEvent E;
+    E.type = type();
+    E.dt   = dt();
+    if (hasStimulus())
+        std::memcpy(E.stimulus.data(), p + EVENT_LOG_AT_STIMULUS, 8 * DELTA_DIM);
+    return E;
+}
+
+FleetEvent EventLogRecordView::fleetEvent() const noexcept
+{
+    FleetEvent e;
+    e.id   = id();
+    e.type = type();
+    e.dt   = dt();
+    if (hasStimulus())
+        std::memcpy(e.stimulus, p + EVENT_LOG_AT_STIMULUS, 8 * DELTA_DIM);
+    return e;
+}
+
+// ============================================================================
+// EventLogCursor
+// ============================================================================
+bool EventLogCursor::enter() noexcept
+{
+    const EventLogBlockHeader& h = log->blockHeader(b);
+    const unsigned char* payload = reinterpret_cast<const unsigned char*>(&h) + sizeof(h);
+
+    if (verify && crc32c(payload, h.payload_bytes) != h.checksum)
+        return false;
+
+    at      = payload;
+    end     = payload + h.payload_bytes;
+    left    = h.records;
+    t       = h.base_time;
+    entered = true;
+    return true;
+}
+
+EventLogStatus EventLogCursor::next(EventLogRecordView& r) noexcept
+{
+    while (state == EventLogStatus::Ok)
+    {
+        if (!entered)
+        {
+            if (b >= last)
+                return state = EventLogStatus::End;
+            if (!enter())
+                return state = EventLogStatus::Corrupt;
+        }
+
+        if (left == 0)
+        {
+            if (end - at >= 8)          // more than the padding left over
+                return state = EventLogStatus::Corrupt;
+            ++b;
+            entered = false;
+            continue;
+        }
+
+        if (static_cast<std::size_t>(end - at) < EVENT_LOG_RECORD_BASE || !validType(at[EVENT_LOG_AT_TYPE]))
+            return state = EventLogStatus::Corrupt;
+
+        r.p = at;
+        if (static_cast<std::size_t>(end - at) < r.bytes())
+            return state = EventLogStatus::Corrupt;
+
+        std::uint32_t delta;
+        std::memcpy(&delta, at + EVENT_LOG_AT_DELTA, 4);
+        t  += delta;
+        r.t = t;
+
+        at += r.bytes();
+        --left;
+        return EventLogStatus::Ok;
+    }
+    return state;
+}
+
+// ============================================================================
+// EventLogReader
+// ============================================================================
+EventLogReader::~EventLogReader()
+{
+    close();
+}
+
+bool EventLogReader::fail(const std::string& what)
+{
+    close();
+    err = what;
+    return false;
+}
+
+void EventLogReader::close() noexcept
+{
+    file.close();
+    data = nullptr;
+    size = 0;
+    index.clear();
+    total = 0;
+    torn  = false;
+}
+
+bool EventLogReader::open(const char* path)
+{
+    close();
+    err.clear();
+
+    std::string why;
+    if (!file.open(path, why))
+        return fail(why);
+    if (file.size() < sizeof(EventLogFileHeader))
+        return fail(std::string("not an FMRT event log: ") + path);
+
+    data = file.data();
+    size = file.size();
+
+    EventLogFileHeader h;
+    std::memcpy(&h, data, sizeof(h));
+
+    if (!validFileHeader(h, why))
+        return fail(why);
+
+    // --- block index -----------------------------------------------------------
+    std::size_t off = sizeof(EventLogFileHeader);
+    while (size - off >= sizeof(EventLogBlockHeader))
+    {
+        const EventLogBlockHeader* b = reinterpret_cast<const EventLogBlockHeader*>(data + off);
+        if (b->magic != EVENT_LOG_BLOCK_MAGIC || b->payload_bytes % 8 != 0 ||
+            b->payload_bytes > size - off - sizeof(EventLogBlockHeader))
+            break;
+
+        index.push_back(b);
+        total += b->records;
+        off   += sizeof(EventLogBlockHeader) + b->payload_bytes;
+    }
+    torn = off != size;
+    return true;
+}
+
+EventLogCursor EventLogReader::cursor(std::size_t first, std::size_t last, bool verify) const noexcept
+{
+    EventLogCursor c;
+    c.log    = this;
+    c.b      = first;
+    c.last   = last < blocks() ? last : blocks();
+    c.verify = verify;
+    return c;
+}
+
+} // namespace fmrt
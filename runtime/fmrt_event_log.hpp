@@ -0,0 +1,267 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_event_log.hpp
+//
+// Binary event log: compact, versioned, append-only record of FleetEvent
+// streams (organism id, event type, dt, stimulus, timestamp) for capture
+// and replay. StructEvent itself cannot be dumped raw: its `reason` is a
+// pointer.
+//
+// Layout (host byte order, checked through `endian`; all little-endian
+// targets read each other's logs):
+//
+//   file   EventLogFileHeader, then blocks back to back
+//   block  EventLogBlockHeader, then `records` records, zero-padded to a
+//          multiple of 8 bytes (payload_bytes, padding included)
+//   record id u32 | time_delta u32 | type u8 | dt f64 | stimulus
+//          f64[delta_dim], packed — the stimulus only for UPDATE, so a
+//          GAP / HEARTBEAT / RESET record is 17 bytes, an UPDATE 17 + 8N
+//
+// Timestamps are caller ticks (nanoseconds recommended), stored as the
+// difference to the previous record of the block; the first record of a
+// block sits at base_time. A record whose delta does not fit (negative
+// or >= 2^32) starts a new block. Every block carries the CRC-32C of its
+// payload.
+//
+// Writer: records collect in the open block; full blocks are sealed into
+// an output buffer written once flush_bytes have accumulated (and by
+// flush() / close(), which also seal a partial block). open() on an
+// existing log appends; a torn last block (crash during a write) is
+// truncated away first, a corrupt header earlier in the file is an error.
+//
+// Reader: maps the file (MappedFile: POSIX mmap; elsewhere the file is
+// read into memory) and indexes the block headers; a cursor walks records
+// in place — EventLogRecordView points into the mapping and loads fields
+// from it directly; nothing is copied until event() / fleetEvent()
+// assemble one. A torn tail is reported (truncated()), not read.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet_event.hpp"
+#include "fmrt_mapped_file.hpp"
+
+namespace fmrt
+{
+    constexpr std::uint16_t EVENT_LOG_VERSION = 1;
+
+    struct EventLogFileHeader
+    {
+        char          magic[8];         // "FMRTELOG"
+        std::uint16_t version;          // EVENT_LOG_VERSION
+        std::uint16_t delta_dim;        // stimulus components per UPDATE record
+        std::uint32_t endian;           // 0x01020304 as stored by the writer
+        std::uint64_t reserved[2];      // zero
+    };
+
+    struct EventLogBlockHeader
+    {
+        std::uint32_t magic;            // EVENT_LOG_BLOCK_MAGIC
+        std::uint32_t records;
+        std::uint32_t payload_bytes;
+        std::uint32_t checksum;         // CRC-32C of the payload
+        std::int64_t  base_time;        // timestamp of the first record
+        std::uint64_t first_record;     // index of the first record in the log
+    };
+
+    // record field offsets
+    constexpr std::size_t EVENT_LOG_AT_ID       = 0;
+    constexpr std::size_t EVENT_LOG_AT_DELTA    = 4;
+    constexpr std::size_t EVENT_LOG_AT_TYPE     = 8;
+    constexpr std::size_t EVENT_LOG_AT_DT       = 9;
+    constexpr std::size_t EVENT_LOG_AT_STIMULUS = 17;
+
+    constexpr std::uint32_t EVENT_LOG_BLOCK_MAGIC  = 0x4B4C4246u;     // "FBLK"
+    constexpr std::size_t   EVENT_LOG_RECORD_BASE  = 17;              // bytes without stimulus
+    constexpr std::size_t   EVENT_LOG_RECORD_MAX   = EVENT_LOG_RECORD_BASE + 8 * DELTA_DIM;
+
+    static_assert(sizeof(EventLogFileHeader) == 32, "event log file header is 32 bytes");
+    static_assert(sizeof(EventLogBlockHeader) == 32, "event log block header is 32 bytes");
+
+    // CRC-32C (Castagnoli), as used for the block checksums
+    std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc = 0) noexcept;
+
+    // -------------------------------------------------------------------------
+    // Writer
+    // -------------------------------------------------------------------------
+    struct EventLogOptions
+    {
+        std::size_t block_records = 4096;               // records per block
+        std::size_t flush_bytes   = std::size_t{1} << 20;
+    };
+
+    class EventLogWriter
+    {
+    public:
+        EventLogWriter() = default;
+        ~EventLogWriter();
+
+        EventLogWriter(const EventLogWriter&)            = delete;
+        EventLogWriter& operator=(const EventLogWriter&) = delete;
+
+        // Creates the log, or appends to an existing one (header checked,
+        // torn tail truncated: droppedBytes()). A corrupt block header
+        // before the tail fails the open and leaves the file untouched.
+        // false: see error().
+        bool open(const char* path, const EventLogOptions& options = EventLogOptions{});
+
+        bool append(std::int64_t time, const FleetEvent& e);
+        bool append(std::int64_t time, OrganismId id, const StructEvent& E)
+        {
+            return append(time, FleetEvent::make(id, E));
+        }
+
+        // n records; time[j] belongs to e[j]
+        bool append(const std::int64_t* time, const FleetEvent* e, std::size_t n);
+
+        // seals the open block and writes everything buffered (fflush)
+        bool flush();
+        bool close();
+
+        bool          isOpen() const noexcept { return file != nullptr; }
+        std::uint64_t records() const noexcept { return next_record; }  // in the log, incl. buffered
+        std::uint64_t droppedBytes() const noexcept { return dropped; }  // torn tail cut by open()
+        const std::string& error() const noexcept { return err; }
+
+    private:
+        bool seal();
+        bool fail(const std::string& what);
+
+        std::FILE*                 file = nullptr;
+        EventLogOptions            opt;
+        std::vector<unsigned char> block;           // open block payload
+        std::vector<unsigned char> out;             // sealed blocks not yet written
+        std::uint32_t              block_count = 0;
+        std::int64_t               base_time   = 0;
+        std::int64_t               last_time   = 0;
+        std::uint64_t              next_record = 0;
+        std::uint64_t              block_first = 0;
+        std::uint64_t              dropped     = 0;
+        std::string                err;
+    };
+
+    // -------------------------------------------------------------------------
+    // Reader
+    // -------------------------------------------------------------------------
+
+    // One record in place (valid while its reader is open)
+    class EventLogRecordView
+    {
+    public:
+        OrganismId   id() const noexcept   { return load<std::uint32_t>(EVENT_LOG_AT_ID); }
+        EventType    type() const noexcept { return static_cast<EventType>(p[EVENT_LOG_AT_TYPE]); }
+        std::int64_t time() const noexcept { return t; }
+        double       dt() const noexcept   { return load<double>(EVENT_LOG_AT_DT); }
+
+        bool   hasStimulus() const noexcept { return type() == EventType::Update; }
+        double stimulus(std::size_t k) const noexcept   // 0 unless UPDATE
+        {
+            return hasStimulus() ? load<double>(EVENT_LOG_AT_STIMULUS + 8 * k) : 0.0;
+        }
+
+        std::size_t bytes() const noexcept
+        {
+            return hasStimulus() ? EVENT_LOG_RECORD_MAX : EVENT_LOG_RECORD_BASE;
+        }
+
+        StructEvent event() const noexcept;
+        FleetEvent  fleetEvent() const noexcept;
+
+    private:
+        friend class EventLogCursor;
+
+        template <class T>
+        T load(std::size_t at) const noexcept
+        {
+            T v;
+            std::memcpy(&v, p + at, sizeof(T));
+            return v;
+        }
+
+        const unsigned char* p = nullptr;
+        std::int64_t         t = 0;
+    };
+
+    enum class EventLogStatus : std::uint8_t
+    {
+        Ok      = 0,    // a record was produced
+        End     = 1,    // no more records in the range
+        Corrupt = 2     // checksum or record layout mismatch in a block
+    };
+
+    class EventLogReader;
+
+    // Walks the records of blocks [first, last) of a reader
+    class EventLogCursor
+    {
+    public:
+        EventLogStatus next(EventLogRecordView& r) noexcept;
+
+        // block the last record came from, or where Corrupt was detected
+        std::size_t block() const noexcept { return b; }
+
+    private:
+        friend class EventLogReader;
+
+        bool enter() noexcept;
+
+        const EventLogReader* log = nullptr;
+        std::size_t          b    = 0;
+        std::size_t          last = 0;
+        bool                 verify = true;
+        bool                 entered = false;
+        const unsigned char* at  = nullptr;
+        const unsigned char* end = nullptr;
+        std::uint32_t        left = 0;
+        std::int64_t         t    = 0;
+        EventLogStatus       state = EventLogStatus::Ok;
+    };
+
+    class EventLogReader
+    {
+    public:
+        EventLogReader() = default;
+        ~EventLogReader();
+
+        EventLogReader(const EventLogReader&)            = delete;
+        EventLogReader& operator=(const EventLogReader&) = delete;
+
+        // maps the file, checks the header and indexes the blocks
+        bool open(const char* path);
+        void close() noexcept;
+
+        std::size_t   blocks() const noexcept  { return index.size(); }
+        std::uint64_t records() const noexcept { return total; }
+        bool          truncated() const noexcept { return torn; }   // torn last block ignored
+
+        const EventLogBlockHeader& blockHeader(std::size_t b) const noexcept { return *index[b]; }
+
+        // every block / blocks [first, last); verify: check each block's CRC
+        // before its records are produced
+        EventLogCursor cursor(bool verify = true) const noexcept { return cursor(0, blocks(), verify); }
+        EventLogCursor cursor(std::size_t first, std::size_t last, bool verify = true) const noexcept;
+
+        const std::string& error() const noexcept { return err; }
+
+    private:
+        friend class EventLogCursor;
+
+        bool fail(const std::string& what);
+
+        MappedFile                              file;
+        const unsigned char*                    data = nullptr;
+        std::size_t                             size = 0;
+        std::vector<const EventLogBlockHeader*> index;
+        std::uint64_t                           total = 0;
+        bool                                    torn  = false;
+        std::string                             err;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,553 @@
+//
+// FMRT Core V2.2
+// fmrt_fleet.cpp
+//
+// Shards, work ranges and the worker pool behind fmrt::Fleet.
+//
+// Scheduling: shard indices are split into one contiguous range per
+// worker. A worker claims shards from its own range with fetch_add and,
+// once that range is exhausted, claims from the other ranges the same
+// way (stealing). Every index is handed out exactly once per run(), so a
+// shard — and every organism in it — is stepped by a single thread.
+//
+// Events reach a shard through its MpscRing and are dequeued in batches
+// of DEQUEUE_BATCH by the worker that holds the shard. A broadcast()
+// event is applied by the same worker after the ring, as one
+// FMRT_StepBroadcastInPlace over the shard's active columns.
+//
+// Storage: local index (id / shards) -> OrganismHandle -> dense position
+// in the shard's OrganismPool. Dense positions [0, active) hold Active
+// organisms, [active, size) Frozen ones; park / revive swap an organism
+// across that boundary, Evict parks and then removes it from the end.
+//
+// The mutex / condition variables only start and finish a run(); shard
+// data written before run() and results written during it are published
+// through them. Nothing on the push or step path locks.
+//
+
+#include "fmrt_fleet.hpp"
+#include "fmrt_mpsc_ring.hpp"
+#include "fmrt_organism_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fmrt
+{
+    namespace
+    {
+        constexpr std::size_t SHARDS_PER_THREAD = 8;
+        constexpr std::size_t DEQUEUE_BATCH     = 64;
+    } // namespace
+
+struct Fleet::Impl
+{
+    struct alignas(64) Shard
+    {
+        MpscRing<FleetEvent>        queue;
+        OrganismPool                pool;
+        std::size_t                 active = 0;     // dense [0, active): Active
+        std::vector<OrganismHandle> handle;         // by local index
+        std::vector<StepStatus>     status;         // by local index
+        std::vector<std::uint32_t>  parked_events;  // by local index (AutoReset)
+        std::vector<std::uint32_t>  local_of;       // by pool slot (handle.index)
+        std::vector<StepStatus>     tick_status;    // by dense position, broadcast()
+        std::vector<double>         tick_loading;   // by dense position, broadcast()
+        FleetStats                  stats;
+    };
+
+    // shard indices [next, end) still to be claimed
+    struct alignas(64) Range
+    {
+        std::atomic<std::size_t> next{0};
+        std::size_t              begin = 0;
+        std::size_t              end   = 0;
+    };
+
+    std::size_t nthreads = 1;
+    std::size_t nshards  = 1;
+    std::atomic<std::size_t> count{0};
+
+    LifecyclePolicy lifecycle        = LifecyclePolicy::Keep;
+    std::uint32_t   auto_reset_after = 0;
+
+    const StructEvent* tick         = nullptr;  // broadcast() event of this run
+    const double*      tick_loading = nullptr;  // by OrganismId; null: unscaled
+
+    std::unique_ptr<Shard[]> shards;
+    std::unique_ptr<Range[]> ranges;
+
+    // --- worker pool (threads 1 .. nthreads-1) -------------------------------
+    std::vector<std::thread> workers;
+    std::mutex               m;
+    std::condition_variable  wake;
+    std::condition_variable  done;
+    std::uint64_t            epoch = 0;
+    std::size_t              busy  = 0;
+    bool                     stop  = false;
+
+    Shard& shardOf(OrganismId id) const noexcept { return shards[id % nshards]; }
+    static std::size_t localOf(OrganismId id, std::size_t n) noexcept { return id / n; }
+
+    // --- lifecycle ------------------------------------------------------------
+
+    // Active -> Frozen: swap with the last Active organism
+    static std::size_t park(Shard& s, std::size_t d) noexcept
+    {
+        --s.active;
+        s.pool.swapDense(d, s.active);
+        return s.active;
+    }
+
+    // Frozen -> Active: swap with the first Frozen organism
+    static std::size_t revive(Shard& s, std::size_t d) noexcept
+    {
+        s.pool.swapDense(d, s.active);
+        return s.active++;
+    }
+
+    static StepStatus stepDense(Shard& s, std::size_t d, const StructEvent& E)
+    {
+        StructuralState X = s.pool.loadDense(d);
+        const StepStatus st = FMRT_StepInPlace(X, E);
+        s.pool.storeDense(d, X);
+
+        ++s.stats.steps;
+        if (st == StepStatus::ERROR)
+            ++s.stats.errors;
+        return st;
+    }
+
+    static StepStatus autoReset(Shard& s, std::size_t local, std::size_t d)
+    {
+        StructEvent R;
+        R.type = EventType::Reset;
+
+        ++s.stats.auto_resets;
+        s.parked_events[local] = 0;
+        return stepDense(s, revive(s, d), R);
+    }
+
+    // applies the policy to an Active organism whose step left κ == 0
+    void onCollapse(Shard& s, std::size_t local, std::size_t d) const
+    {
+        const std::size_t p = park(s, d);
+        s.parked_events[local] = 0;
+
+        if (lifecycle == LifecyclePolicy::Evict)
+        {
+            // move to the very end so removal displaces nobody
+            s.pool.swapDense(p, s.pool.size() - 1);
+            s.pool.remove(s.handle[local]);
+            ++s.stats.evictions;
+        }
+        else if (lifecycle == LifecyclePolicy::AutoReset && auto_reset_after == 0)
+        {
+            s.status[local] = autoReset(s, local, p);
+        }
+    }
+
+    void stepEvent(Shard& s, const FleetEvent& fe) const
+    {
+        const std::size_t local = localOf(fe.id, nshards);
+        std::size_t       d     = s.pool.denseIndex(s.handle[local]);
+
+        if (d == s.pool.size())
+        {
+            ++s.stats.dropped;                          // evicted
+            return;
+        }
+
+        const StructEvent E = fe.event();
+
+        if (d >= s.active)                              // frozen
+        {
+            if (E.type != EventType::Reset)
+            {
+                ++s.stats.dead;
+                s.status[local] = StepStatus::DEAD;
+
+                if (lifecycle == LifecyclePolicy::AutoReset &&
+                    ++s.parked_events[local] >= auto_reset_after)
+                {
+                    s.status[local] = autoReset(s, local, d);
+                }
+                return;
+            }
+            d = revive(s, d);
+        }
+
+        s.status[local] = stepDense(s, d, E);
+
+        if (lifecycle != LifecyclePolicy::Keep && s.pool.kappaColumn()[d] == 0.0)
+            onCollapse(s, local, d);
+    }
+
+    std::size_t localAt(const Shard& s, std::size_t d) const noexcept
+    {
+        return s.local_of[s.pool.handleAt(d).index];
+    }
+
+    // E for every organism of the shard, with the outcome stepEvent would
+    // give one organism at a time
+    void broadcastShard(Shard& s, const StructEvent& E) const
+    {
+        s.stats.dropped += s.handle.size() - s.pool.size();    // evicted
+
+        if (E.type == EventType::Reset)
+        {
+            s.active = s.pool.size();                           // revive all
+        }
+        else
+        {
+            // frozen: not stepped; an AutoReset revives behind the active range
+            const std::size_t frozen_end = s.pool.size();
+            const std::size_t n          = s.active;
+
+            for (std::size_t d = n; d < frozen_end; ++d)
+            {
+                const std::size_t local = localAt(s, d);
+
+                ++s.stats.dead;
+                s.status[local] = StepStatus::DEAD;
+
+                if (lifecycle == LifecyclePolicy::AutoReset &&
+                    ++s.parked_events[local] >= auto_reset_after)
+                {
+                    s.status[local] = autoReset(s, local, d);
+                }
+            }
+
+            tickActive(s, n, E);
+            return;
+        }
+
+        tickActive(s, s.active, E);
+    }
+
+    // steps dense positions [0, n) with E in one column pass
+    void tickActive(Shard& s, std::size_t n, const StructEvent& E) const
+    {
+        if (n == 0)
+            return;
+
+        s.tick_status.resize(n);
+
+        EnvelopeColumns out;
+        out.status = s.tick_status.data();
+
+        const StateColumns cols = s.pool.columns();
+
+        if (tick_loading)
+        {
+            // gather the loadings into dense order
+            const std::size_t shard = static_cast<std::size_t>(&s - shards.get());
+
+            s.tick_loading.resize(n);
+            for (std::size_t d = 0; d < n; ++d)
+                s.tick_loading[d] = tick_loading[localAt(s, d) * nshards + shard];
+
+            FMRT_StepFactorBroadcastInPlace(cols, n, E, s.tick_loading.data(), out);
+        }
+        else
+        {
+            FMRT_StepBroadcastInPlace(cols, n, E, out);
+        }
+
+        s.stats.steps += n;
+        for (std::size_t d = 0; d < n; ++d)
+        {
+            s.status[localAt(s, d)] = s.tick_status[d];
+            if (s.tick_status[d] == StepStatus::ERROR)
+                ++s.stats.errors;
+        }
+
+        if (lifecycle == LifecyclePolicy::Keep)
+            return;
+
+        // back to front: park() only swaps with positions already checked
+        // (or with organisms revived behind [0, n), which were not stepped)
+        for (std::size_t d = n; d-- > 0;)
+            if (s.pool.kappaColumn()[d] == 0.0)
+                onCollapse(s, localAt(s, d), d);
+    }
+
+    // dequeues until the ring is empty, at most one capacity per run(),
+    // then applies the broadcast event, if any
+    void stepShard(Shard& s) const
+    {
+        FleetEvent batch[DEQUEUE_BATCH];
+
+        std::size_t budget = s.queue.capacity();
+        while (budget > 0)
+        {
+            const std::size_t n = s.queue.popBatch(batch, std::min(budget, DEQUEUE_BATCH));
+            if (n == 0)
+                break;
+            budget -= n;
+
+            for (std::size_t j = 0; j < n; ++j)
+                stepEvent(s, batch[j]);
+        }
+
+        if (tick)
+            broadcastShard(s, *tick);
+    }
+
+    // own range first, then steal from the others in ring order
+    void drain(std::size_t w)
+    {
+        for (std::size_t v = 0; v < nthreads; ++v)
+        {
+            Range& r = ranges[(w + v) % nthreads];
+            for (;;)
+            {
+                const std::size_t i = r.next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= r.end)
+                    break;
+                stepShard(shards[i]);
+            }
+        }
+    }
+
+    void workerLoop(std::size_t w)
+    {
+        std::uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                wake.wait(lock, [&] { return stop || epoch != seen; });
+                if (stop)
+                    return;
+                seen = epoch;
+            }
+
+            drain(w);
+
+            std::lock_guard<std::mutex> lock(m);
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+
+Fleet::Fleet(const FleetConfig& config)
+    : impl(std::make_unique<Impl>())
+{
+    std::size_t t = config.threads;
+    if (t == 0)
+        t = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    const std::size_t s = (config.shards != 0) ? config.shards : t * SHARDS_PER_THREAD;
+
+    impl->nthreads = t;
+    impl->nshards  = s;
+    impl->lifecycle        = config.lifecycle;
+    impl->auto_reset_after = config.auto_reset_after;
+    impl->shards   = std::make_unique<Impl::Shard[]>(s);
+    impl->ranges   = std::make_unique<Impl::Range[]>(t);
+
+    for (std::size_t i = 0; i < s; ++i)
+        impl->shards[i].queue.init(config.queue_capacity);
+
+    for (std::size_t w = 0; w < t; ++w)
+    {
+        impl->ranges[w].begin = s * w / t;
+        impl->ranges[w].end   = s * (w + 1) / t;
+    }
+
+    impl->workers.reserve(t - 1);
+    for (std::size_t w = 1; w < t; ++w)
+        impl->workers.emplace_back([this, w] { impl->workerLoop(w); });
+}
+
+Fleet::~Fleet()
+{
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->stop = true;
+    }
+    impl->wake.notify_all();
+
+    for (std::thread& th : impl->workers)
+        th.join();
+}
+
+// -----------------------------------------------------------------------------
+// Organisms
+// -----------------------------------------------------------------------------
+
+OrganismId Fleet::add()
+{
+    StructuralState X;
+    X.reset();
+    return add(X);
+}
+
+OrganismId Fleet::add(const StructuralState& X)
+{
+    const OrganismId id = static_cast<OrganismId>(impl->count.load(std::memory_order_relaxed));
+
+    Impl::Shard& s = impl->shardOf(id);
+    const OrganismHandle h = s.pool.insert(X);
+
+    if (h.index >= s.local_of.size())
+        s.local_of.resize(h.index + std::size_t{1});
+    s.local_of[h.index] = static_cast<std::uint32_t>(s.handle.size());
+
+    s.handle.push_back(h);
+    s.status.push_back(StepStatus::OK);
+    s.parked_events.push_back(0);
+
+    // new organisms are Active: move in front of the Frozen range
+    s.pool.swapDense(s.pool.size() - 1, s.active);
+    ++s.active;
+
+    // publishes the slot to producers on other threads
+    impl->count.store(id + std::size_t{1}, std::memory_order_release);
+    return id;
+}
+
+std::size_t Fleet::size() const noexcept    { return impl->count.load(std::memory_order_acquire); }
+std::size_t Fleet::threads() const noexcept { return impl->nthreads; }
+std::size_t Fleet::shards() const noexcept  { return impl->nshards; }
+
+std::size_t Fleet::active() const noexcept
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < impl->nshards; ++i)
+        n += impl->shards[i].active;
+    return n;
+}
+
+StructuralState Fleet::state(OrganismId id) const noexcept
+{
+    const Impl::Shard& s = impl->shardOf(id);
+
+    StructuralState X;
+    s.pool.load(s.handle[Impl::localOf(id, impl->nshards)], X);
+    return X;
+}
+
+OrganismPhase Fleet::phase(OrganismId id) const noexcept
+{
+    const Impl::Shard& s = impl->shardOf(id);
+    const std::size_t  d = s.pool.denseIndex(s.handle[Impl::localOf(id, impl->nshards)]);
+
+    if (d == s.pool.size()) return OrganismPhase::Evicted;
+    return (d < s.active) ? OrganismPhase::Active : OrganismPhase::Frozen;
+}
+
+StepStatus Fleet::lastStatus(OrganismId id) const noexcept
+{
+    return impl->shardOf(id).status[Impl::localOf(id, impl->nshards)];
+}
+
+// -----------------------------------------------------------------------------
+// Events
+// -----------------------------------------------------------------------------
+
+bool Fleet::push(const FleetEvent& E) noexcept
+{
+    if (E.id >= impl->count.load(std::memory_order_acquire))
+        return false;
+
+    return impl->shardOf(E.id).queue.tryPush(E);
+}
+
+bool Fleet::submit(OrganismId id, const StructEvent& E) noexcept
+{
+    return push(FleetEvent::make(id, E));
+}
+
+void Fleet::run()
+{
+    for (std::size_t w = 0; w < impl->nthreads; ++w)
+        impl->ranges[w].next.store(impl->ranges[w].begin, std::memory_order_relaxed);
+
+    if (impl->nthreads == 1)
+    {
+        impl->drain(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        ++impl->epoch;
+        impl->busy = impl->nthreads - 1;
+    }
+    impl->wake.notify_all();
+
+    impl->drain(0);
+
+    std::unique_lock<std::mutex> lock(impl->m);
+    impl->done.wait(lock, [&] { return impl->busy == 0; });
+}
+
+void Fleet::broadcast(const StructEvent& E)
+{
+    // published to the workers by run()'s epoch handshake
+    impl->tick = &E;
+    run();
+    impl->tick = nullptr;
+}
+
+void Fleet::broadcast(const StructEvent& E, const double* loading)
+{
+    impl->tick_loading = loading;
+    broadcast(E);
+    impl->tick_loading = nullptr;
+}
+
+FleetStats Fleet::stats() const noexcept
+{
+    FleetStats total;
+    for (std::size_t i = 0; i < impl->nshards; ++i)
+    {
+        const FleetStats& s = impl->shards[i].stats;
+        total.steps       += s.steps;
+        total.errors      += s.errors;
+        total.dead        += s.dead;
+        total.dropped     += s.dropped;
+        total.auto_resets += s.auto_resets;
+        total.evictions   += s.evictions;
+    }
+    return total;
+}
+
+FleetQueueStats Fleet::queueStats(std::size_t shard) const noexcept
+{
+    const MpscRing<FleetEvent>& q = impl->shards[shard].queue;
+
+    FleetQueueStats r;
+    r.depth      = q.depth();
+    r.high_water = q.highWater();
+    r.pushed     = q.pushed();
+    r.rejected   = q.rejectedPushes();
+    return r;
+}
+
+FleetQueueStats Fleet::queueStats() const noexcept
+{
+    FleetQueueStats total;
+    for (std::size_t i = 0; i < impl->nshards; ++i)
+    {
+        const FleetQueueStats s = queueStats(i);
+        total.depth     += s.depth;
+        total.high_water = std::max(total.high_water, s.high_water);
+        total.pushed    += s.pushed;
+        total.rejected  += s.rejected;
+    }
+    return total;
+}
+
+} // namespace fmrt
@@ -0,0 +1,173 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_fleet.hpp
+//
+// Fleet: many independent organisms stepped on a thread pool.
+//
+// FMRT Core itself never spawns threads; parallelism comes from running
+// independent organisms side by side (Design Document, Determinism &
+// Concurrency). The Fleet is that outer layer:
+//
+//   - organisms are identified by OrganismId and spread over shards
+//     (id % shards); a shard is stepped by exactly one thread at a time,
+//     so each organism sees its events strictly in submission order
+//   - events enter through one bounded lock-free MPSC ring per shard
+//     (fmrt_mpsc_ring.hpp) as FleetEvent records; any number of threads
+//     may submit / push at any time, including during run(), and a full
+//     ring is reported instead of waited on
+//   - run() hands the shards out to the workers (the calling thread is
+//     worker 0); a worker that runs out of its own shards steals from
+//     the others. Claims are single atomic increments — the step path
+//     takes no locks
+//   - every event goes through FMRT_StepInPlace, so each organism ends in
+//     exactly the state a serial FMRT_StepInPlace loop would produce,
+//     independent of thread count and scheduling
+//   - a shard stores its organisms in an OrganismPool (SoA columns); the
+//     active organisms occupy the front of the columns, organisms parked
+//     by the lifecycle policy the back, so column passes over the active
+//     range never touch collapsed organisms
+//   - broadcast() applies one event to every organism as such a column
+//     pass instead of one queued record per organism
+//
+// Lifecycle (FleetConfig::lifecycle), applied when a step leaves κ == 0:
+//   Keep       every event is stepped (plain FMRT_StepInPlace behaviour)
+//   Freeze     the organism is parked; its non-RESET events are not
+//              stepped (lastStatus DEAD, counted in FleetStats::dead).
+//              A collapsed state is a fixed point of every non-RESET
+//              step, so states stay bit-identical to Keep. RESET revives.
+//   AutoReset  as Freeze, and after auto_reset_after parked events the
+//              organism is RESET (through FMRT_StepInPlace) and revived
+//   Evict      the organism leaves its pool; later events for it are
+//              dropped (FleetStats::dropped) and phase() reports Evicted
+//
+// Ordering: events of one organism are applied in the order their pushes
+// took effect — for a single producer, its submission order. Events of
+// one organism pushed from several threads at once have no defined
+// relative order.
+//
+// add(), run(), broadcast() and the state / stats accessors belong to one
+// owning thread; add() and the accessors must not overlap run().
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet_event.hpp"
+
+namespace fmrt
+{
+    enum class LifecyclePolicy : std::uint8_t
+    {
+        Keep      = 0,
+        Freeze    = 1,
+        AutoReset = 2,
+        Evict     = 3
+    };
+
+    enum class OrganismPhase : std::uint8_t
+    {
+        Active  = 0,    // stepped by every event
+        Frozen  = 1,    // collapsed and parked; only RESET is stepped
+        Evicted = 2     // removed; events are dropped
+    };
+
+    struct FleetConfig
+    {
+        std::size_t threads = 0;    // 0: std::thread::hardware_concurrency()
+        std::size_t shards  = 0;    // 0: 8 per thread (granularity of stealing)
+        std::size_t queue_capacity = std::size_t{1} << 14;  // events per shard ring
+
+        LifecyclePolicy lifecycle        = LifecyclePolicy::Keep;
+        std::uint32_t   auto_reset_after = 0;   // AutoReset: parked events before the RESET
+    };
+
+    // Totals since construction (summed over shards when read)
+    struct FleetStats
+    {
+        std::uint64_t steps       = 0;  // events stepped (FMRT_StepInPlace / broadcast)
+        std::uint64_t errors      = 0;  // steps that returned StepStatus::ERROR
+        std::uint64_t dead        = 0;  // events of parked organisms, not stepped
+        std::uint64_t dropped     = 0;  // events of evicted organisms
+        std::uint64_t auto_resets = 0;  // RESETs issued by AutoReset
+        std::uint64_t evictions   = 0;  // organisms removed by Evict
+    };
+
+    // Shard ring counters (a snapshot while producers or run() are active)
+    struct FleetQueueStats
+    {
+        std::size_t   depth      = 0;   // events queued, not yet dequeued
+        std::size_t   high_water = 0;   // largest depth seen by a dequeue
+        std::uint64_t pushed     = 0;   // accepted pushes since construction
+        std::uint64_t rejected   = 0;   // pushes refused because the ring was full
+    };
+
+    class Fleet
+    {
+    public:
+        explicit Fleet(const FleetConfig& config = FleetConfig{});
+        ~Fleet();
+
+        Fleet(const Fleet&)            = delete;
+        Fleet& operator=(const Fleet&) = delete;
+
+        // New organism in the RESET state, or with state X. Ids are dense
+        // and assigned in order (0, 1, 2, ...).
+        OrganismId add();
+        OrganismId add(const StructuralState& X);
+
+        std::size_t size() const noexcept;
+        std::size_t active() const noexcept;    // organisms in the Active phase
+        std::size_t threads() const noexcept;
+        std::size_t shards() const noexcept;
+
+        // Current state / status of the last event of organism id
+        // (id must be < size(); state(): not Evicted)
+        StructuralState state(OrganismId id) const noexcept;
+        StepStatus lastStatus(OrganismId id) const noexcept;
+        OrganismPhase phase(OrganismId id) const noexcept;
+
+        // Queues an event for organism E.id (thread-safe, never blocks).
+        // Returns false, queueing nothing, for an unknown id or a full
+        // shard ring; the caller retries after the ring has been drained.
+        bool push(const FleetEvent& E) noexcept;
+
+        // push(FleetEvent::make(id, E)); E.reason is not carried
+        bool submit(OrganismId id, const StructEvent& E) noexcept;
+
+        // Applies queued events and returns when every shard is drained.
+        // Events of different organisms run concurrently. Events pushed
+        // while run() executes are applied by this run() or the next one;
+        // a shard takes at most one ring capacity of events per run().
+        void run();
+
+        // run(), then E applied to every organism — as if E had been
+        // submitted to each of them after the events this run() dequeues.
+        // E is validated once and stepped over the shard columns with
+        // FMRT_StepBroadcastInPlace (stimulus-free kernel for GAP /
+        // HEARTBEAT); parked and evicted organisms follow the lifecycle
+        // rules, and states, statuses and stats match the per-organism
+        // submit path.
+        void broadcast(const StructEvent& E);
+
+        // broadcast() of a common shock scaled per organism: organism id
+        // receives E with stimulus[k] = loading[id] * E.stimulus[k]
+        // (loading has size() entries), stepped with
+        // FMRT_StepFactorBroadcastInPlace — no per-organism event is built.
+        void broadcast(const StructEvent& E, const double* loading);
+
+        FleetStats stats() const noexcept;
+
+        // Ring counters of one shard / summed over all shards
+        // (high_water: the largest of the shards)
+        FleetQueueStats queueStats(std::size_t shard) const noexcept;
+        FleetQueueStats queueStats() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,58 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_fleet_event.hpp
+//
+// FleetEvent: fixed-size, trivially copyable event record addressed to
+// one organism. StructEvent carries a `const char* reason`, which must
+// not travel through shared buffers (the pointee may be gone by the time
+// the record is read); FleetEvent holds only values and drops the reason.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "fmrt_event.hpp"
+
+namespace fmrt
+{
+    using OrganismId = std::uint32_t;
+
+    struct FleetEvent
+    {
+        OrganismId   id = 0;
+        EventType    type = EventType::Heartbeat;
+        std::uint8_t reserved[3] = {};          // zero; keeps the layout explicit
+        double       dt = 0.0;
+        double       stimulus[DELTA_DIM] = {};
+
+        static FleetEvent make(OrganismId id, const StructEvent& E) noexcept
+        {
+            FleetEvent r;
+            r.id   = id;
+            r.type = E.type;
+            r.dt   = E.dt;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                r.stimulus[k] = E.stimulus[k];
+            return r;
+        }
+
+        // reason is left null
+        StructEvent event() const noexcept
+        {
+            StructEvent E;
+            E.type = type;
+            E.dt   = dt;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                E.stimulus[k] = stimulus[k];
+            return E;
+        }
+    };
+
+    static_assert(std::is_trivially_copyable<FleetEvent>::value,
+                  "FleetEvent is copied byte-wise through queues and files");
+    static_assert(sizeof(FleetEvent) == 16 + 8 * DELTA_DIM,
+                  "FleetEvent layout must not contain implicit padding");
+
+} // namespace fmrt
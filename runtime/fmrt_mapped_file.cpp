@@ -0,0 +1,105 @@
+//
+// FMRT Core V2.2
+// fmrt_mapped_file.cpp
+//
+// mmap / read-into-memory behind fmrt::MappedFile.
+//
+
+#include "fmrt_mapped_file.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define FMRT_MAPPED_FILE_MMAP 1
+#endif
+
+namespace fmrt
+{
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+void MappedFile::close() noexcept
+{
+#if defined(FMRT_MAPPED_FILE_MMAP)
+    if (mapped && ptr)
+        munmap(const_cast<unsigned char*>(ptr), len);
+#endif
+    ptr    = nullptr;
+    len    = 0;
+    mapped = false;
+    copy.clear();
+    copy.shrink_to_fit();
+}
+
+bool MappedFile::open(const char* path, std::string& err)
+{
+    close();
+
+#if defined(FMRT_MAPPED_FILE_MMAP)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        err = std::string("cannot open ") + path;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        err = std::string("cannot open ") + path;
+        return false;
+    }
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    void* m = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED)
+    {
+        err = std::string("cannot map ") + path;
+        return false;
+    }
+
+    madvise(m, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    ptr    = static_cast<const unsigned char*>(m);
+    len    = static_cast<std::size_t>(st.st_size);
+    mapped = true;
+#else
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f)
+    {
+        err = std::string("cannot open ") + path;
+        return false;
+    }
+
+    std::error_code ec;
+    copy.resize(static_cast<std::size_t>(std::filesystem::file_size(path, ec)));
+    const bool got = !ec && std::fread(copy.data(), 1, copy.size(), f) == copy.size();
+    std::fclose(f);
+    if (!got)
+    {
+        close();
+        err = std::string("cannot read ") + path;
+        return false;
+    }
+
+    ptr = copy.data();
+    len = copy.size();
+#endif
+    return true;
+}
+
+} // namespace fmrt
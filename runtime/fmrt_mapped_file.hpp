@@ -0,0 +1,40 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_mapped_file.hpp
+//
+// MappedFile: read-only view of a whole file, shared by the event log and
+// trajectory readers. POSIX: mmap (MADV_SEQUENTIAL); elsewhere the file
+// is read into memory. An empty file opens with size() == 0.
+//
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace fmrt
+{
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // false: nothing is open, err says why
+        bool open(const char* path, std::string& err);
+        void close() noexcept;
+
+        const unsigned char* data() const noexcept { return ptr; }
+        std::size_t          size() const noexcept { return len; }
+
+    private:
+        const unsigned char*       ptr    = nullptr;
+        std::size_t                len    = 0;
+        bool                       mapped = false;
+        std::vector<unsigned char> copy;    // without mmap
+    };
+
+} // namespace fmrt
@@ -0,0 +1,155 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_mpsc_ring.hpp
+//
+// MpscRing<T>: bounded lock-free queue, many producers / one consumer.
+//
+// Every cell carries a sequence number (bounded-queue scheme of
+// D. Vyukov): cell i is free for the producer holding position p when
+// seq == p, and readable by the consumer when seq == p + 1. Producers
+// claim positions with a CAS on `tail`; a full ring makes tryPush()
+// fail at once — producers never wait for the consumer, and the
+// consumer never waits for a producer (a claimed but unwritten cell
+// simply ends the current batch).
+//
+// Positions are 64-bit counters and never wrap in practice, so
+// `tail` doubles as the number of accepted pushes.
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace fmrt
+{
+    template <class T>
+    class MpscRing
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "MpscRing stores records by plain copy");
+
+    public:
+        MpscRing() = default;
+
+        MpscRing(const MpscRing&)            = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        // Allocates capacity cells (rounded up to a power of two, >= 2).
+        // Not thread-safe; call before the ring is shared.
+        void init(std::size_t capacity)
+        {
+            std::size_t c = 2;
+            while (c < capacity)
+                c <<= 1;
+
+            cells = std::make_unique<Cell[]>(c);
+            for (std::size_t i = 0; i < c; ++i)
+                cells[i].seq.store(i, std::memory_order_relaxed);
+
+            mask = c - 1;
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+            rejected.store(0, std::memory_order_relaxed);
+            high_water.store(0, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const noexcept { return mask + 1; }
+
+        // ---------------------------------------------------------------------
+        // Producers (any thread)
+        // ---------------------------------------------------------------------
+        bool tryPush(const T& value) noexcept
+        {
+            std::uint64_t pos = tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells[pos & mask];
+                const std::uint64_t seq  = cell.seq.load(std::memory_order_acquire);
+                const std::int64_t  diff = static_cast<std::int64_t>(seq - pos);
+
+                if (diff == 0)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = value;
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;                       // full
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // Consumer (one thread at a time)
+        // ---------------------------------------------------------------------
+
+        // Moves up to max records, oldest first, into out; returns the count.
+        std::size_t popBatch(T* out, std::size_t max) noexcept
+        {
+            const std::uint64_t pos = head.load(std::memory_order_relaxed);
+
+            const std::size_t depth = static_cast<std::size_t>(
+                tail.load(std::memory_order_relaxed) - pos);
+            if (depth > high_water.load(std::memory_order_relaxed))
+                high_water.store(depth, std::memory_order_relaxed);   // single writer
+
+            std::size_t n = 0;
+            for (; n < max; ++n)
+            {
+                Cell& cell = cells[(pos + n) & mask];
+                if (cell.seq.load(std::memory_order_acquire) != pos + n + 1)
+                    break;                              // empty or not yet written
+
+                out[n] = cell.value;
+                cell.seq.store(pos + n + mask + 1, std::memory_order_release);
+            }
+
+            head.store(pos + n, std::memory_order_release);
+            return n;
+        }
+
+        // ---------------------------------------------------------------------
+        // Monitoring (any thread; a snapshot, exact only when quiescent)
+        // ---------------------------------------------------------------------
+        std::size_t depth() const noexcept
+        {
+            const std::uint64_t h = head.load(std::memory_order_acquire);
+            const std::uint64_t t = tail.load(std::memory_order_acquire);
+            return (t > h) ? static_cast<std::size_t>(t - h) : 0;
+        }
+
+        std::uint64_t pushed() const noexcept   { return tail.load(std::memory_order_relaxed); }
+        std::uint64_t rejectedPushes() const noexcept { return rejected.load(std::memory_order_relaxed); }
+
+        // Largest depth seen at the start of a popBatch
+        std::size_t highWater() const noexcept { return high_water.load(std::memory_order_relaxed); }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::uint64_t> seq{0};
+            T                          value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t             mask = 0;
+
+        alignas(64) std::atomic<std::uint64_t> tail{0};      // producers
+        alignas(64) std::atomic<std::uint64_t> rejected{0};  // producers, full ring only
+        alignas(64) std::atomic<std::uint64_t> head{0};      // consumer
+        std::atomic<std::size_t>               high_water{0};    // consumer
+    };
+
+} // namespace fmrt
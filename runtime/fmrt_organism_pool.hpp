@@ -0,0 +1,263 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_organism_pool.hpp
+//
+// OrganismPoolT<N>: organisms stored column-wise (one array per field of
+// StructuralStateT<N>) behind generational handles (slot map).
+//
+//   - dense columns: organisms 0 .. size()-1 are contiguous in every
+//     column, so a pass that needs only κ reads only the κ array, and
+//     columns() feeds FMRT_StepBatch directly
+//   - insert / remove are O(1): remove moves the last organism into the
+//     freed dense position
+//   - a handle names a slot plus the slot's generation; removing bumps the
+//     generation, so every handle to a removed organism is detected as
+//     stale, also after the slot has been reused. A slot whose generation
+//     would wrap is retired instead of reused.
+//
+// Dense positions change on remove / swapDense; handles do not.
+// Pointers from columns() are invalidated by insert and reserve.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "fmrt_state.hpp"
+#include "fmrt_batch.hpp"
+
+namespace fmrt
+{
+    struct OrganismHandle
+    {
+        static constexpr std::uint32_t INVALID = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index      = INVALID;     // slot
+        std::uint32_t generation = 0;
+
+        bool operator==(const OrganismHandle& o) const noexcept
+        {
+            return index == o.index && generation == o.generation;
+        }
+        bool operator!=(const OrganismHandle& o) const noexcept { return !(*this == o); }
+    };
+
+    template <std::size_t N>
+    class OrganismPoolT
+    {
+    public:
+        static constexpr std::size_t DIM = N;
+
+        std::size_t size() const noexcept { return slot_of.size(); }
+        bool empty() const noexcept { return slot_of.empty(); }
+
+        void reserve(std::size_t n)
+        {
+            for (auto& c : delta) c.reserve(n);
+            phi.reserve(n);
+            m.reserve(n);
+            kappa.reserve(n);
+            regime_prev.reserve(n);
+            slot_of.reserve(n);
+        }
+
+        // ---------------------------------------------------------------------
+        // Handles
+        // ---------------------------------------------------------------------
+        OrganismHandle insert(const StructuralStateT<N>& X)
+        {
+            const std::uint32_t dense = static_cast<std::uint32_t>(size());
+
+            std::uint32_t s;
+            if (free_head != OrganismHandle::INVALID)
+            {
+                s         = free_head;
+                free_head = slots[s].dense;
+            }
+            else
+            {
+                s = static_cast<std::uint32_t>(slots.size());
+                slots.push_back(Slot{});
+            }
+
+            for (std::size_t k = 0; k < N; ++k)
+                delta[k].push_back(X.Delta[k]);
+            phi.push_back(X.Phi);
+            m.push_back(X.M);
+            kappa.push_back(X.Kappa);
+            regime_prev.push_back(X.RegimePrev);
+            slot_of.push_back(s);
+
+            slots[s].dense = dense;
+            return OrganismHandle{ s, slots[s].generation };
+        }
+
+        // false (nothing removed) for a stale or invalid handle
+        bool remove(OrganismHandle h) noexcept
+        {
+            if (!contains(h))
+                return false;
+
+            const std::uint32_t i    = slots[h.index].dense;
+            const std::uint32_t last = static_cast<std::uint32_t>(size() - 1);
+            if (i != last)
+                moveDense(last, i);
+
+            for (auto& c : delta) c.pop_back();
+            phi.pop_back();
+            m.pop_back();
+            kappa.pop_back();
+            regime_prev.pop_back();
+            slot_of.pop_back();
+
+            Slot& slot = slots[h.index];
+            if (slot.generation != std::numeric_limits<std::uint32_t>::max())
+            {
+                ++slot.generation;
+                slot.dense = free_head;
+                free_head  = h.index;
+            }
+            else
+            {
+                slot.dense = OrganismHandle::INVALID;   // retired: never reused
+            }
+            return true;
+        }
+
+        bool contains(OrganismHandle h) const noexcept
+        {
+            return h.index < slots.size() &&
+                   slots[h.index].generation == h.generation &&
+                   slots[h.index].dense < size() &&
+                   slot_of[slots[h.index].dense] == h.index;
+        }
+
+        // dense position of h; size() for a stale handle
+        std::size_t denseIndex(OrganismHandle h) const noexcept
+        {
+            return contains(h) ? slots[h.index].dense : size();
+        }
+
+        // handle of the organism at dense position i (i < size())
+        OrganismHandle handleAt(std::size_t i) const noexcept
+        {
+            const std::uint32_t s = slot_of[i];
+            return OrganismHandle{ s, slots[s].generation };
+        }
+
+        // ---------------------------------------------------------------------
+        // State access (false: stale handle, X untouched / nothing written)
+        // ---------------------------------------------------------------------
+        bool load(OrganismHandle h, StructuralStateT<N>& X) const noexcept
+        {
+            if (!contains(h))
+                return false;
+            X = loadDense(slots[h.index].dense);
+            return true;
+        }
+
+        bool store(OrganismHandle h, const StructuralStateT<N>& X) noexcept
+        {
+            if (!contains(h))
+                return false;
+            storeDense(slots[h.index].dense, X);
+            return true;
+        }
+
+        StructuralStateT<N> loadDense(std::size_t i) const noexcept
+        {
+            StructuralStateT<N> X;
+            for (std::size_t k = 0; k < N; ++k)
+                X.Delta[k] = delta[k][i];
+            X.Phi        = phi[i];
+            X.M          = m[i];
+            X.Kappa      = kappa[i];
+            X.RegimePrev = regime_prev[i];
+            return X;
+        }
+
+        void storeDense(std::size_t i, const StructuralStateT<N>& X) noexcept
+        {
+            for (std::size_t k = 0; k < N; ++k)
+                delta[k][i] = X.Delta[k];
+            phi[i]         = X.Phi;
+            m[i]           = X.M;
+            kappa[i]       = X.Kappa;
+            regime_prev[i] = X.RegimePrev;
+        }
+
+        // Exchanges dense positions i and j; handles follow their organisms
+        void swapDense(std::size_t i, std::size_t j) noexcept
+        {
+            if (i == j)
+                return;
+
+            for (auto& c : delta) std::swap(c[i], c[j]);
+            std::swap(phi[i], phi[j]);
+            std::swap(m[i], m[j]);
+            std::swap(kappa[i], kappa[j]);
+            std::swap(regime_prev[i], regime_prev[j]);
+            std::swap(slot_of[i], slot_of[j]);
+
+            slots[slot_of[i]].dense = static_cast<std::uint32_t>(i);
+            slots[slot_of[j]].dense = static_cast<std::uint32_t>(j);
+        }
+
+        // ---------------------------------------------------------------------
+        // Columns (dense positions 0 .. size()-1)
+        // ---------------------------------------------------------------------
+        StateColumnsT<N> columns() noexcept
+        {
+            StateColumnsT<N> c;
+            for (std::size_t k = 0; k < N; ++k)
+                c.Delta[k] = delta[k].data();
+            c.Phi        = phi.data();
+            c.M          = m.data();
+            c.Kappa      = kappa.data();
+            c.RegimePrev = regime_prev.data();
+            return c;
+        }
+
+        const double* deltaColumn(std::size_t k) const noexcept { return delta[k].data(); }
+        const double* phiColumn() const noexcept   { return phi.data(); }
+        const double* mColumn() const noexcept     { return m.data(); }
+        const double* kappaColumn() const noexcept { return kappa.data(); }
+        const Regime* regimePrevColumn() const noexcept { return regime_prev.data(); }
+
+    private:
+        struct Slot
+        {
+            std::uint32_t dense      = 0;   // dense position; next free slot while free
+            std::uint32_t generation = 0;
+        };
+
+        // copies dense position `from` over `to` and repoints its slot
+        void moveDense(std::uint32_t from, std::uint32_t to) noexcept
+        {
+            for (auto& c : delta) c[to] = c[from];
+            phi[to]         = phi[from];
+            m[to]           = m[from];
+            kappa[to]       = kappa[from];
+            regime_prev[to] = regime_prev[from];
+            slot_of[to]     = slot_of[from];
+
+            slots[slot_of[to]].dense = to;
+        }
+
+        std::vector<double> delta[N];
+        std::vector<double> phi;
+        std::vector<double> m;
+        std::vector<double> kappa;
+        std::vector<Regime> regime_prev;
+
+        std::vector<std::uint32_t> slot_of;     // dense position -> slot
+        std::vector<Slot>          slots;
+        std::uint32_t              free_head = OrganismHandle::INVALID;
+    };
+
+    using OrganismPool = OrganismPoolT<DELTA_DIM>;
+
+} // namespace fmrt
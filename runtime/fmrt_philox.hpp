@@ -0,0 +1,60 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_philox.hpp
+//
+// Philox4x32-10 counter-based random number generator (Salmon et al.,
+// "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011).
+//
+// A draw is a pure function of (counter, key): there is no sequential
+// state, so any position of any stream is computed directly — streams
+// split across threads or sliced at an offset need no replay. Output is
+// integer-only and therefore identical on every platform; it matches the
+// Random123 known-answer vectors (tests/test_workload.cpp).
+//
+
+#include <cstdint>
+
+namespace fmrt
+{
+    struct Philox4x32
+    {
+        struct Counter { std::uint32_t v[4]; };
+        struct Key     { std::uint32_t v[2]; };
+        using  Block = Counter;
+
+        static constexpr std::uint32_t M0 = 0xD2511F53u;
+        static constexpr std::uint32_t M1 = 0xCD9E8D57u;
+        static constexpr std::uint32_t W0 = 0x9E3779B9u;   // golden ratio
+        static constexpr std::uint32_t W1 = 0xBB67AE85u;   // sqrt(3) - 1
+        static constexpr int           ROUNDS = 10;
+
+        static Block generate(Counter c, Key k) noexcept
+        {
+            for (int r = 0; r < ROUNDS; ++r)
+            {
+                const std::uint64_t p0 = std::uint64_t{M0} * c.v[0];
+                const std::uint64_t p1 = std::uint64_t{M1} * c.v[2];
+
+                const std::uint32_t hi0 = static_cast<std::uint32_t>(p0 >> 32);
+                const std::uint32_t lo0 = static_cast<std::uint32_t>(p0);
+                const std::uint32_t hi1 = static_cast<std::uint32_t>(p1 >> 32);
+                const std::uint32_t lo1 = static_cast<std::uint32_t>(p1);
+
+                c = Counter{ { hi1 ^ c.v[1] ^ k.v[0], lo1, hi0 ^ c.v[3] ^ k.v[1], lo0 } };
+
+                k.v[0] += W0;
+                k.v[1] += W1;
+            }
+            return c;
+        }
+
+        // 53-bit uniform in (0, 1] from two words (never 0: safe to divide by)
+        static double uniform(std::uint32_t hi, std::uint32_t lo) noexcept
+        {
+            const std::uint64_t bits = (std::uint64_t{hi} << 21) ^ (lo >> 11);
+            return static_cast<double>(bits + 1) * (1.0 / 9007199254740992.0);
+        }
+    };
+
+} // namespace fmrt
@@ -0,0 +1,379 @@
+//
+// FMRT Core V2.2
+// fmrt_replay.cpp
+//
+// Log replay behind fmrt::LogReplay and fmrt::replayLogs().
+//
+// Sorted batches: records are copied out of the mapping into a FleetEvent
+// batch, ordered by SortedEventBatch::sort() and stepped one organism run
+// at a time. Digests are stored by arrival index and folded into the hash
+// after the batch, so the hash sees log order whatever the step order.
+//
+// Pacing: while reading a batch, a record that is not yet due ends the
+// batch; it is held back, the batch is stepped, and the replay sleeps
+// until the held record is due. Unpaced replays never read the clock.
+//
+
+#include "fmrt_replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace fmrt
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        inline std::uint64_t bits(double v) noexcept
+        {
+            std::uint64_t u;
+            std::memcpy(&u, &v, sizeof(u));
+            return u;
+        }
+
+        inline std::uint64_t fold(std::uint64_t d, std::uint64_t w) noexcept
+        {
+            d = (d ^ w) * 0x9E3779B97F4A7C15ULL;
+            return (d << 31) | (d >> 33);
+        }
+
+        // wall time at which log time t is due
+        inline Clock::time_point dueAt(const ReplayClock& clock, std::int64_t t, double scale) noexcept
+        {
+            const double s = static_cast<double>(t - clock.t0) * scale;
+            return clock.start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+        }
+
+        inline double seconds(Clock::duration d) noexcept
+        {
+            return std::chrono::duration<double>(d).count();
+        }
+    } // namespace
+
+std::uint64_t envelopeDigest(const StructuralState& X, StepStatus status, ErrorCategory category,
+                             const DerivedMetrics& metrics, const InvariantStatus& invariants) noexcept
+{
+    std::uint64_t w[DELTA_DIM + 9];
+    std::size_t   n = 0;
+
+    w[n++] = std::uint64_t{static_cast<std::uint8_t>(status)} |
+             std::uint64_t{static_cast<std::uint8_t>(category)} << 8 |
+             std::uint64_t{static_cast<std::uint8_t>(X.RegimePrev)} << 16;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        w[n++] = bits(X.Delta[k]);
+    w[n++] = bits(X.Phi);
+    w[n++] = bits(X.M);
+    w[n++] = bits(X.Kappa);
+
+    if (status != StepStatus::ERROR)
+    {
+        w[n++] = bits(metrics.curvature_R);
+        w[n++] = bits(metrics.det_g);
+        w[n++] = bits(metrics.tau);
+        w[n++] = bits(metrics.mu);
+        w[n++] = std::uint64_t{static_cast<std::uint8_t>(metrics.morph_class)} |
+                 std::uint64_t{static_cast<std::uint8_t>(metrics.regime)} << 8 |
+                 std::uint64_t{invariants.flags} << 16 |
+                 std::uint64_t{invariants.all_ok} << 48;
+    }
+
+    // four independent fold chains (a single chain is latency-bound)
+    std::uint64_t lane[4] = { REPLAY_HASH_SEED, REPLAY_HASH_SEED + 1, REPLAY_HASH_SEED + 2,
+                              REPLAY_HASH_SEED + 3 };
+    for (std::size_t i = 0; i < n; ++i)
+        lane[i & 3] = fold(lane[i & 3], w[i]);
+
+    return replayHashStep(fold(fold(fold(lane[0], lane[1]), lane[2]), lane[3]), n);
+}
+
+// -----------------------------------------------------------------------------
+// LogReplay
+// -----------------------------------------------------------------------------
+
+LogReplay::LogReplay(const ReplayConfig& config)
+    : cfg(config)
+{
+    cfg.batch_records = std::max<std::size_t>(cfg.batch_records, 1);
+}
+
+bool LogReplay::fail(const std::string& what)
+{
+    res.ok    = false;
+    res.error = what;
+    return false;
+}
+
+bool LogReplay::grow(OrganismId id)
+{
+    if (id < pool.size())
+        return true;
+    if (id >= cfg.max_organisms)
+        return fail("organism id " + std::to_string(id) + " exceeds max_organisms");
+
+    StructuralState X;
+    X.reset();
+    while (pool.size() <= id)
+        pool.insert(X);
+    cols = pool.columns();
+    return true;
+}
+
+void LogReplay::stepOrdered(const FleetEvent& e)
+{
+    StructuralState S = cols.load(e.id);
+    const bool      alive = S.Kappa > 0.0;
+
+    DerivedMetrics  m;
+    InvariantStatus inv;
+    ErrorCategory   cat = ErrorCategory::None;
+
+    const StepStatus st = FMRT_StepInPlace(S, e.event(), &m, &inv, &cat);
+    cols.store(e.id, S);
+
+    res.errors    += st == StepStatus::ERROR;
+    res.collapses += alive && S.Kappa == 0.0;
+    res.hash       = replayHashStep(res.hash, envelopeDigest(S, st, cat, m, inv));
+}
+
+void LogReplay::stepSorted(const FleetEvent* E, std::size_t n)
+{
+    batch.sort(E, n);
+    digest.resize(n);
+
+    const FleetEvent*    G = batch.sorted();
+    const std::uint32_t* a = batch.order();
+
+    std::size_t j = 0;
+    while (j < n)
+    {
+        const OrganismId id = G[j].id;
+        StructuralState  S  = cols.load(id);
+        CarriedMetrics   carry;
+
+        for (; j < n && G[j].id == id; ++j)
+        {
+            const bool alive = S.Kappa > 0.0;
+
+            DerivedMetrics  m;
+            InvariantStatus inv;
+            ErrorCategory   cat = ErrorCategory::None;
+
+            const StepStatus st = FMRT_StepInPlace(S, G[j].event(), carry, &m, &inv, &cat);
+
+            res.errors    += st == StepStatus::ERROR;
+            res.collapses += alive && S.Kappa == 0.0;
+            digest[a[j]]   = envelopeDigest(S, st, cat, m, inv);
+        }
+
+        cols.store(id, S);
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+        res.hash = replayHashStep(res.hash, digest[i]);
+}
+
+bool LogReplay::run(const EventLogReader& log, const ReplayClock* clock)
+{
+    res      = ReplayResult{};
+    res.hash = REPLAY_HASH_SEED;
+
+    const Clock::time_point begin = Clock::now();
+    const bool              paced = cfg.speed > 0.0;
+    const double            scale = cfg.tick_seconds / (paced ? cfg.speed : 1.0);
+
+    ReplayClock origin;
+    bool        have_origin = clock != nullptr;
+    if (clock)
+        origin = *clock;
+
+    // paced: true when log time t is due (after sleeping if `wait`)
+    auto due = [&](std::int64_t t, bool wait) -> bool
+    {
+        if (!have_origin)
+        {
+            origin.t0    = t;
+            origin.start = Clock::now();
+            have_origin  = true;
+        }
+
+        const Clock::time_point at  = dueAt(origin, t, scale);
+        Clock::time_point       now = Clock::now();
+        if (now < at)
+        {
+            if (!wait)
+                return false;
+            std::this_thread::sleep_until(at);
+            now = Clock::now();
+        }
+        res.max_lag = std::max(res.max_lag, seconds(now - at));
+        return true;
+    };
+
+    auto note = [&](std::int64_t t)
+    {
+        if (res.records == 0)
+            res.first_time = t;
+        res.last_time = t;
+        ++res.records;
+    };
+
+    EventLogCursor     c = log.cursor(cfg.verify);
+    EventLogRecordView r;
+    EventLogStatus     st = EventLogStatus::Ok;
+    bool               ok = true;
+
+    if (cfg.mode == ReplayMode::Ordered)
+    {
+        while (ok && (st = c.next(r)) == EventLogStatus::Ok)
+        {
+            if (paced)
+                due(r.time(), true);
+            ok = grow(r.id());
+            if (ok)
+            {
+                stepOrdered(r.fleetEvent());
+                note(r.time());
+            }
+        }
+    }
+    else
+    {
+        events.resize(cfg.batch_records);
+
+        FleetEvent   held;
+        std::int64_t held_time = 0;
+        bool         have_held = false;
+
+        while (ok)
+        {
+            std::size_t n = 0;
+
+            if (have_held)
+            {
+                due(held_time, true);
+                have_held = false;
+                ok = grow(held.id);
+                if (ok)
+                {
+                    events[n++] = held;
+                    note(held_time);
+                }
+            }
+
+            while (ok && n < cfg.batch_records && (st = c.next(r)) == EventLogStatus::Ok)
+            {
+                if (paced && !due(r.time(), false))
+                {
+                    held      = r.fleetEvent();
+                    held_time = r.time();
+                    have_held = true;
+                    break;
+                }
+                ok = grow(r.id());
+                if (ok)
+                {
+                    events[n++] = r.fleetEvent();
+                    note(r.time());
+                }
+            }
+
+            if (n > 0)
+                stepSorted(events.data(), n);
+
+            if (!have_held && st != EventLogStatus::Ok)
+                break;
+        }
+    }
+
+    res.organisms = pool.size();
+    res.seconds   = seconds(Clock::now() - begin);
+
+    if (!ok)
+        return false;
+    if (st == EventLogStatus::Corrupt)
+        return fail("corrupt block " + std::to_string(c.block()));
+    if (log.truncated())
+    {
+        res.truncated = true;
+        return fail("log truncated at block " + std::to_string(log.blocks()) +
+                    " (torn or corrupt block header); " + std::to_string(res.records) +
+                    " records replayed");
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// replayLogs
+// -----------------------------------------------------------------------------
+
+std::vector<ReplayResult> replayLogs(const std::vector<std::string>& paths, const ReplayConfig& config)
+{
+    const std::size_t files = paths.size();
+
+    std::vector<ReplayResult>   out(files);
+    std::vector<EventLogReader> logs(files);
+    std::vector<char>           opened(files, 0);
+
+    // open everything first: paced replays share the earliest timestamp
+    ReplayClock clock;
+    bool        have_t0 = false;
+
+    for (std::size_t i = 0; i < files; ++i)
+    {
+        out[i].path = paths[i];
+        if (!logs[i].open(paths[i].c_str()))
+        {
+            out[i].ok    = false;
+            out[i].error = logs[i].error();
+            continue;
+        }
+        opened[i] = 1;
+
+        if (logs[i].blocks() > 0)
+        {
+            const std::int64_t t = logs[i].blockHeader(0).base_time;
+            clock.t0 = have_t0 ? std::min(clock.t0, t) : t;
+            have_t0  = true;
+        }
+    }
+
+    // paced replays mostly sleep: by default every file gets its thread
+    std::size_t threads = config.threads;
+    if (threads == 0)
+        threads = config.speed > 0.0 ? files : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, files));
+
+    std::atomic<std::size_t> next{0};
+    clock.start = std::chrono::steady_clock::now();
+
+    auto work = [&]()
+    {
+        for (;;)
+        {
+            const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= files)
+                return;
+            if (!opened[i])
+                continue;
+
+            LogReplay replay(config);
+            replay.run(logs[i], config.speed > 0.0 ? &clock : nullptr);
+            out[i]      = replay.result();
+            out[i].path = paths[i];
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t)
+        workers.emplace_back(work);
+    work();
+    for (std::thread& th : workers)
+        th.join();
+
+    return out;
+}
+
+} // namespace fmrt
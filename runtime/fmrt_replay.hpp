@@ -0,0 +1,161 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_replay.hpp
+//
+// Replay of recorded event logs (fmrt_event_log.hpp) through the step
+// path, for backtests and incident reproduction.
+//
+//   - LogReplay owns the organisms of one replay (OrganismPool columns,
+//     dense ids: the log's organism id is the column index; organisms
+//     are created in the RESET state on first sight) and applies the
+//     records of an EventLogReader to them in log order
+//   - ReplayMode::Ordered steps record by record; ReplayMode::Sorted
+//     reads up to batch_records records at a time and steps them grouped
+//     by organism (SortedEventBatch::sort), chaining CarriedMetrics within
+//     each organism's run. Both give bit-identical states and hashes.
+//     Sorted pays when the fleet's states do not fit in cache (scattered
+//     ids become one ascending pass per batch). For cache-resident fleets
+//     Ordered is faster: steps of interleaved organisms overlap in the
+//     core, while one organism's run is a single dependency chain.
+//   - replayLogs() replays several logs side by side, one LogReplay per
+//     file, on a pool of threads (the calling thread is worker 0); files
+//     are independent, so each result equals a single-threaded replay
+//   - speed > 0 paces the replay to speed x real time: a record is not
+//     stepped before (time - t0) * tick_seconds / speed has elapsed.
+//     replayLogs() gives all files one origin, so cross-file timing is
+//     kept (given one thread per file, the default when paced).
+//
+// Every step runs with FMRT_StepInPlace semantics (a rejected step leaves
+// the state unchanged) and is folded into a rolling hash of its envelope
+// in log order:
+//
+//   h = REPLAY_HASH_SEED;  for each record:  h = replayHashStep(h, d)
+//   d = envelopeDigest(state after the step, status, error category,
+//                      metrics, invariants)
+//
+// so two replays — or a replay and a plain FMRT_StepInPlace loop — agree
+// on the hash exactly when every envelope agrees. The hash is a checksum,
+// not a cryptographic digest.
+//
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_event_log.hpp"
+#include "fmrt_fleet_event.hpp"
+#include "fmrt_organism_pool.hpp"
+#include "fmrt_sorted_batch.hpp"
+
+namespace fmrt
+{
+    enum class ReplayMode : std::uint8_t
+    {
+        Ordered = 0,    // record by record, in log order
+        Sorted  = 1     // batches grouped by organism (SortedEventBatch)
+    };
+
+    struct ReplayConfig
+    {
+        ReplayMode  mode          = ReplayMode::Ordered;
+        std::size_t batch_records = 4096;           // Sorted: records per batch
+        std::size_t threads       = 0;              // replayLogs(), at most one per file; 0: hardware_concurrency()
+                                                    // (paced: one per file)
+        double      speed         = 0.0;            // 0: as fast as possible; s: s x real time
+        double      tick_seconds  = 1e-9;           // unit of the log timestamps
+        bool        verify        = true;           // check block CRCs
+        std::size_t max_organisms = std::size_t{1} << 24;   // ids beyond: replay fails
+    };
+
+    struct ReplayResult
+    {
+        std::string   path;                         // replayLogs() only
+        bool          ok = true;
+        std::string   error;                        // !ok: why the replay stopped
+        bool          truncated = false;            // the log ends in a torn or corrupt block
+                                                    // header: only its intact prefix was replayed
+                                                    // (then also !ok)
+
+        std::uint64_t records   = 0;                // records stepped
+        std::uint64_t errors    = 0;                // steps that returned ERROR
+        std::uint64_t collapses = 0;                // steps that left κ == 0
+        std::size_t   organisms = 0;                // organisms after the replay
+        std::uint64_t hash      = 0;                // rolling envelope hash
+
+        std::int64_t  first_time = 0;               // log time span replayed
+        std::int64_t  last_time  = 0;
+        double        seconds    = 0.0;             // wall time of the replay
+        double        max_lag    = 0.0;             // paced: largest delay behind schedule (s)
+    };
+
+    // Pacing origin: log time t0 is due at wall time start
+    struct ReplayClock
+    {
+        std::int64_t                          t0 = 0;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    constexpr std::uint64_t REPLAY_HASH_SEED = 0x46524D5452504C59ULL;     // "FRMTRPLY"
+
+    // splitmix64 finalizer of h ^ d: order-sensitive fold of one digest
+    inline std::uint64_t replayHashStep(std::uint64_t h, std::uint64_t d) noexcept
+    {
+        std::uint64_t z = h ^ d;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Digest of one FMRT_StepInPlace envelope. Metrics and invariants
+    // enter only for accepted steps (on ERROR they are not meaningful).
+    std::uint64_t envelopeDigest(const StructuralState& X, StepStatus status, ErrorCategory category,
+                                 const DerivedMetrics& metrics, const InvariantStatus& invariants) noexcept;
+
+    // -------------------------------------------------------------------------
+    // One replay
+    // -------------------------------------------------------------------------
+    class LogReplay
+    {
+    public:
+        explicit LogReplay(const ReplayConfig& config = ReplayConfig{});
+
+        // Applies every record of log to this replay's organisms (states
+        // carry over from earlier runs; the counters and hash restart).
+        // clock: pacing origin when speed > 0; null: the first record is
+        // due now. false: see result().error — records before the failure
+        // have been applied and counted. A log the reader reports
+        // truncated() replays its intact blocks and then fails
+        // (result().truncated).
+        bool run(const EventLogReader& log, const ReplayClock* clock = nullptr);
+
+        const ReplayResult& result() const noexcept { return res; }
+
+        std::size_t     organisms() const noexcept { return pool.size(); }
+        StructuralState state(OrganismId id) const noexcept { return pool.loadDense(id); }
+
+    private:
+        bool fail(const std::string& what);
+        bool grow(OrganismId id);
+
+        void stepOrdered(const FleetEvent& e);
+        void stepSorted(const FleetEvent* E, std::size_t n);
+
+        ReplayConfig               cfg;
+        OrganismPool               pool;
+        StateColumns               cols;
+        SortedEventBatch           batch;
+        std::vector<FleetEvent>    events;          // Sorted: the batch being read
+        std::vector<std::uint64_t> digest;          // Sorted: by arrival index
+        ReplayResult               res;
+    };
+
+    // Replays each file on its own LogReplay, side by side; results in
+    // the order of paths
+    std::vector<ReplayResult> replayLogs(const std::vector<std::string>& paths,
+                                         const ReplayConfig& config = ReplayConfig{});
+
+} // namespace fmrt
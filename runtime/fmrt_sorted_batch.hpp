@@ -0,0 +1,60 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_sorted_batch.hpp
+//
+// SortedEventBatch: applies a batch of FleetEvent records to organisms
+// stored in columns (E.id is the column index), grouped by organism.
+//
+// Events that arrive interleaved across many organisms touch a different
+// state on almost every event; in arrival order nearly every step starts
+// with a cache miss. step() instead
+//
+//   - stably radix-sorts the batch by organism id (LSD, 8-bit digits;
+//     digits equal across the whole batch are skipped), so the events of
+//     one organism keep their arrival order
+//   - steps each organism's run of events back to back on one loaded
+//     copy of its state, chaining CarriedMetrics between the steps, and
+//     stores it once
+//   - prefetches the state of the next organism while the current run
+//     is stepped
+//
+// Organisms are independent, so every state and status is bit-identical
+// to applying FMRT_StepInPlace in arrival order.
+//
+// The scratch buffers grow to the largest batch seen and are reused; one
+// SortedEventBatch per thread.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet_event.hpp"
+
+namespace fmrt
+{
+    class SortedEventBatch
+    {
+    public:
+        // Stable sort of E[0 .. n) by id into internal storage: sorted()[j]
+        // is the j-th event in (id, arrival) order and order()[j] its
+        // arrival index (both valid until the next sort / step)
+        void sort(const FleetEvent* E, std::size_t n);
+        const FleetEvent*    sorted() const noexcept { return events.data(); }
+        const std::uint32_t* order() const noexcept  { return arrival.data(); }
+
+        // sort(E, n), then every event stepped with FMRT_StepInPlace on
+        // column E[j].id of X (ids must be column indices). status, when
+        // non-null, receives the status of E[j] at status[j].
+        void step(const StateColumns& X, const FleetEvent* E, std::size_t n,
+                  StepStatus* status = nullptr);
+
+    private:
+        std::vector<std::uint64_t> keys[2];     // id << 32 | arrival index; passes ping-pong
+        std::vector<FleetEvent>    events;      // sorted
+        std::vector<std::uint32_t> arrival;     // sorted
+    };
+
+} // namespace fmrt
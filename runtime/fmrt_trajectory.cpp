@@ -0,0 +1,899 @@
+//
+// FMRT Core V2.2
+// fmrt_trajectory.cpp
+//
+// Codecs, writer and reader behind fmrt_trajectory.hpp.
+//
+// Bit streams are LSB-first: the first bit of a column is bit 0 of its
+// first byte. The reader refills a 64-bit buffer with one unaligned
+// 8-byte load where at least 8 bytes remain (little-endian hosts), byte
+// by byte otherwise; fields longer than 56 bits are read in two parts.
+//
+// Real columns are encoded from their bit patterns, so every double —
+// NaN payloads, signed zeros, denormals — comes back bit for bit.
+//
+
+#include "fmrt_trajectory.hpp"
+#include "fmrt_errors.hpp"
+#include "fmrt_event_log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace fmrt
+{
+    namespace
+    {
+        constexpr char          FILE_MAGIC[8] = { 'F', 'M', 'R', 'T', 'T', 'R', 'A', 'J' };
+        constexpr std::uint32_t ENDIAN_MARK   = 0x01020304u;
+
+        constexpr std::size_t DIRECTORY_BYTES = sizeof(TrajectoryColumnEntry) * TRAJ_COLUMNS;
+        constexpr std::size_t BLOCK_PREFIX    = sizeof(TrajectoryBlockStats) + DIRECTORY_BYTES;
+
+        constexpr std::uint8_t FLAG_COLLAPSE = 1u;
+        constexpr std::uint8_t FLAG_ALL_OK   = 2u;
+
+        bool validFileHeader(const TrajectoryFileHeader& h, std::string& why)
+        {
+            if (std::memcmp(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+                why = "not an FMRT trajectory file";
+            else if (h.endian != ENDIAN_MARK)
+                why = "trajectory file written with another byte order";
+            else if (h.version != TRAJECTORY_VERSION)
+                why = "unsupported trajectory version " + std::to_string(h.version);
+            else if (h.delta_dim != DELTA_DIM)
+                why = "trajectory file has delta_dim " + std::to_string(h.delta_dim) +
+                      ", this build " + std::to_string(DELTA_DIM);
+            else
+                return true;
+            return false;
+        }
+
+        inline std::uint64_t bits(double v) noexcept
+        {
+            std::uint64_t u;
+            std::memcpy(&u, &v, sizeof(u));
+            return u;
+        }
+
+        inline std::uint64_t zigzag(std::uint64_t d) noexcept
+        {
+            return (d << 1) ^ (0 - (d >> 63));
+        }
+
+        inline std::uint64_t unzigzag(std::uint64_t z) noexcept
+        {
+            return (z >> 1) ^ (0 - (z & 1));
+        }
+
+        inline unsigned leadingZeros(std::uint64_t x) noexcept     // x != 0
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_clzll(x));
+#else
+            unsigned n = 0;
+            while (!(x & (std::uint64_t{1} << 63))) { x <<= 1; ++n; }
+            return n;
+#endif
+        }
+
+        inline unsigned trailingZeros(std::uint64_t x) noexcept    // x != 0
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+            unsigned n = 0;
+            while (!(x & 1)) { x >>= 1; ++n; }
+            return n;
+#endif
+        }
+
+        // ---------------------------------------------------------------------
+        // LEB128
+        // ---------------------------------------------------------------------
+        void putVarint(std::vector<unsigned char>& out, std::uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<unsigned char>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<unsigned char>(v));
+        }
+
+        bool getVarint(const unsigned char*& p, const unsigned char* end, std::uint64_t& v) noexcept
+        {
+            v = 0;
+            for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                const unsigned char b = *p++;
+                v |= std::uint64_t{b & 0x7Fu} << shift;
+                if (!(b & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        // ---------------------------------------------------------------------
+        // Bit streams
+        // ---------------------------------------------------------------------
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<unsigned char>& o) noexcept : out(o) {}
+
+            // n bits (n <= 64); v < 2^n
+            void put(std::uint64_t v, unsigned n)
+            {
+                acc |= v << fill;
+                if (fill + n < 64)
+                {
+                    fill += n;
+                    return;
+                }
+                emit(8);
+                acc   = fill ? v >> (64 - fill) : 0;
+                fill += n - 64;
+            }
+
+            void finish()
+            {
+                emit((fill + 7) / 8);
+                acc  = 0;
+                fill = 0;
+            }
+
+        private:
+            void emit(unsigned bytes)
+            {
+                unsigned char w[8];
+                for (unsigned i = 0; i < 8; ++i)
+                    w[i] = static_cast<unsigned char>(acc >> (8 * i));
+                out.insert(out.end(), w, w + bytes);
+            }
+
+            std::vector<unsigned char>& out;
+            std::uint64_t               acc  = 0;
+            unsigned                    fill = 0;   // bits in acc, < 64
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const unsigned char* begin, const unsigned char* end) noexcept : p(begin), e(end) {}
+
+            // n <= 56; false once the stream is exhausted
+            bool get(unsigned n, std::uint64_t& v) noexcept
+            {
+                if (avail < n)
+                {
+                    refill();
+                    if (avail < n)
+                        return false;
+                }
+                v      = buf & ((std::uint64_t{1} << n) - 1);
+                buf  >>= n;
+                avail -= n;
+                return true;
+            }
+
+            bool getWide(unsigned n, std::uint64_t& v) noexcept       // n <= 64
+            {
+                if (n <= 56)
+                    return get(n, v);
+                std::uint64_t lo, hi;
+                if (!get(32, lo) || !get(n - 32, hi))
+                    return false;
+                v = lo | (hi << 32);
+                return true;
+            }
+
+        private:
+            void refill() noexcept
+            {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                if (e - p >= 8)
+                {
+                    std::uint64_t w;
+                    std::memcpy(&w, p, sizeof(w));
+                    buf   |= w << avail;
+                    p     += (63 - avail) >> 3;
+                    avail |= 56;
+                    return;
+                }
+#endif
+                while (avail <= 56 && p < e)
+                {
+                    buf   |= std::uint64_t{*p++} << avail;
+                    avail += 8;
+                }
+            }
+
+            const unsigned char* p;
+            const unsigned char* e;
+            std::uint64_t        buf   = 0;
+            unsigned             avail = 0;
+        };
+
+        // ---------------------------------------------------------------------
+        // Integer columns: zigzag deltas, runs of equal deltas merged
+        // ---------------------------------------------------------------------
+        void encodeDeltaRuns(const std::uint64_t* v, std::size_t n, std::vector<unsigned char>& out)
+        {
+            std::uint64_t prev = 0, delta = 0, run = 0;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                const std::uint64_t d = v[j] - prev;
+                prev = v[j];
+                if (run > 0 && d == delta)
+                {
+                    ++run;
+                    continue;
+                }
+                if (run > 0)
+                {
+                    putVarint(out, zigzag(delta));
+                    putVarint(out, run);
+                }
+                delta = d;
+                run   = 1;
+            }
+            if (run > 0)
+            {
+                putVarint(out, zigzag(delta));
+                putVarint(out, run);
+            }
+        }
+
+        template <class T>
+        bool decodeDeltaRuns(const unsigned char* p, const unsigned char* end, T* out, std::size_t n) noexcept
+        {
+            std::uint64_t prev = 0;
+            std::size_t   j    = 0;
+            while (j < n)
+            {
+                std::uint64_t z, run;
+                if (!getVarint(p, end, z) || !getVarint(p, end, run) || run == 0 || run > n - j)
+                    return false;
+                const std::uint64_t d = unzigzag(z);
+                for (const std::size_t stop = j + static_cast<std::size_t>(run); j < stop; ++j)
+                {
+                    prev  += d;
+                    out[j] = static_cast<T>(prev);
+                }
+            }
+            return p == end;
+        }
+
+        // ---------------------------------------------------------------------
+        // Real columns: XOR with the previous value (Gorilla)
+        // ---------------------------------------------------------------------
+        void encodeXor(const std::uint64_t* x, std::size_t n, std::vector<unsigned char>& out)
+        {
+            if (n == 0)
+                return;
+
+            BitWriter w(out);
+            w.put(x[0], 64);
+
+            std::uint64_t prev = x[0];
+            unsigned      lead = 65, trail = 0;     // window; lead 65: none yet
+
+            for (std::size_t j = 1; j < n; ++j)
+            {
+                const std::uint64_t d = x[j] ^ prev;
+                prev = x[j];
+
+                if (d == 0)
+                {
+                    w.put(0, 1);
+                    continue;
+                }
+
+                const unsigned lz = std::min(leadingZeros(d), 31u);
+                const unsigned tz = trailingZeros(d);
+
+                if (lead <= 64 && lz >= lead && tz >= trail)
+                {
+                    const unsigned m = 64 - lead - trail;
+                    if (m <= 62)
+                        w.put(1 | (d >> trail) << 2, m + 2);       // '1', '0', bits
+                    else
+                    {
+                        w.put(1, 2);
+                        w.put(d >> trail, m);
+                    }
+                }
+                else
+                {
+                    const unsigned m = 64 - lz - tz;
+                    w.put(3 | lz << 2 | (m & 63u) << 7, 13);       // '1', '1', lz, m (64 as 0)
+                    w.put(d >> tz, m);
+                    lead  = lz;
+                    trail = tz;
+                }
+            }
+            w.finish();
+        }
+
+        bool decodeXor(const unsigned char* p, const unsigned char* end, std::uint64_t* x, std::size_t n) noexcept
+        {
+            if (n == 0)
+                return p == end;
+
+            BitReader r(p, end);
+            std::uint64_t prev;
+            if (!r.getWide(64, prev))
+                return false;
+            x[0] = prev;
+
+            unsigned lead = 65, trail = 0;
+
+            for (std::size_t j = 1; j < n; ++j)
+            {
+                std::uint64_t c;
+                if (!r.get(1, c))
+                    return false;
+                if (c == 0)
+                {
+                    x[j] = prev;
+                    continue;
+                }
+
+                if (!r.get(1, c))
+                    return false;
+                if (c == 1)
+                {
+                    std::uint64_t lz, m;
+                    if (!r.get(5, lz) || !r.get(6, m))
+                        return false;
+                    if (m == 0)
+                        m = 64;
+                    if (lz + m > 64)
+                        return false;
+                    lead  = static_cast<unsigned>(lz);
+                    trail = static_cast<unsigned>(64 - lz - m);
+                }
+                else if (lead > 64)
+                    return false;
+
+                std::uint64_t d;
+                if (!r.getWide(64 - lead - trail, d))
+                    return false;
+                prev ^= d << trail;
+                x[j]  = prev;
+            }
+            return true;
+        }
+
+        // ---------------------------------------------------------------------
+        // Code columns: (value, run)
+        // ---------------------------------------------------------------------
+        template <class T>
+        void encodeRuns(const T* v, std::size_t n, std::vector<unsigned char>& out)
+        {
+            for (std::size_t j = 0; j < n; )
+            {
+                std::size_t k = j + 1;
+                while (k < n && v[k] == v[j])
+                    ++k;
+                putVarint(out, v[j]);
+                putVarint(out, k - j);
+                j = k;
+            }
+        }
+
+        template <class T>
+        bool decodeRuns(const unsigned char* p, const unsigned char* end, T* out, std::size_t n) noexcept
+        {
+            std::size_t j = 0;
+            while (j < n)
+            {
+                std::uint64_t v, run;
+                if (!getVarint(p, end, v) || !getVarint(p, end, run) || run == 0 || run > n - j ||
+                    v > std::numeric_limits<T>::max())
+                    return false;
+                std::fill(out + j, out + j + run, static_cast<T>(v));
+                j += static_cast<std::size_t>(run);
+            }
+            return p == end;
+        }
+
+        inline std::uint32_t presenceBit(std::uint8_t v) noexcept
+        {
+            return std::uint32_t{1} << (v < 31 ? v : 31);
+        }
+    } // namespace
+
+const char* trajectoryColumnName(std::size_t column) noexcept
+{
+    static const char* const DELTA[] = { "delta0", "delta1", "delta2", "delta3", "delta4", "delta5",
+                                         "delta6", "delta7", "delta8", "delta9", "delta10", "delta11",
+                                         "delta12", "delta13", "delta14", "delta15" };
+    static const char* const OTHER[] = { "phi", "m", "kappa", "curvature_R", "det_g", "tau", "mu",
+                                         "collapse_distance", "collapse_speed", "collapse_intensity",
+                                         "regime_prev", "regime", "morph_class", "status",
+                                         "error_category", "event_type", "flags", "invariants" };
+
+    if (column == TRAJ_ID)   return "id";
+    if (column == TRAJ_STEP) return "step";
+    if (column < TRAJ_PHI)
+        return column - TRAJ_DELTA < 16 ? DELTA[column - TRAJ_DELTA] : "delta";
+    if (column < TRAJ_COLUMNS)
+        return OTHER[column - TRAJ_PHI];
+    return "?";
+}
+
+// ============================================================================
+// TrajectoryBlock
+// ============================================================================
+StateEnvelope TrajectoryBlock::envelope(std::size_t row) const noexcept
+{
+    StateEnvelope env;
+
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        env.state.Delta[k] = real[k][row];
+    env.state.Phi        = reals(TRAJ_PHI)[row];
+    env.state.M          = reals(TRAJ_M)[row];
+    env.state.Kappa      = reals(TRAJ_KAPPA)[row];
+    env.state.RegimePrev = static_cast<Regime>(codes(TRAJ_REGIME_PREV)[row]);
+
+    DerivedMetrics& m    = env.metrics;
+    m.curvature_R        = reals(TRAJ_CURVATURE_R)[row];
+    m.det_g              = reals(TRAJ_DET_G)[row];
+    m.tau                = reals(TRAJ_TAU)[row];
+    m.mu                 = reals(TRAJ_MU)[row];
+    m.morph_class        = static_cast<MorphologyClass>(codes(TRAJ_MORPH_CLASS)[row]);
+    m.regime             = static_cast<Regime>(codes(TRAJ_REGIME)[row]);
+    m.is_collapse        = (codes(TRAJ_FLAGS)[row] & FLAG_COLLAPSE) != 0;
+    m.collapse_distance  = reals(TRAJ_COLLAPSE_DISTANCE)[row];
+    m.collapse_speed     = reals(TRAJ_COLLAPSE_SPEED)[row];
+    m.collapse_intensity = reals(TRAJ_COLLAPSE_INTENSITY)[row];
+
+    env.invariants.flags  = invariants[row];
+    env.invariants.all_ok = (codes(TRAJ_FLAGS)[row] & FLAG_ALL_OK) != 0;
+
+    env.status         = static_cast<StepStatus>(codes(TRAJ_STATUS)[row]);
+    env.error_category = static_cast<ErrorCategory>(codes(TRAJ_ERROR_CATEGORY)[row]);
+    env.error_reason   = errorCategoryToString(env.error_category);
+    env.event_type     = static_cast<EventType>(codes(TRAJ_EVENT_TYPE)[row]);
+    return env;
+}
+
+// ============================================================================
+// TrajectoryWriter
+// ============================================================================
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+
+bool TrajectoryWriter::fail(const std::string& what)
+{
+    err = what;
+    return false;
+}
+
+bool TrajectoryWriter::open(const char* path, const TrajectoryOptions& options)
+{
+    if (file && !close())
+        return false;
+
+    opt = options;
+    opt.block_rows = std::min<std::size_t>(std::max<std::size_t>(opt.block_rows, 1),
+                                           std::numeric_limits<std::uint32_t>::max());
+
+    open_block = TrajectoryBlock{};
+    next_row   = 0;
+    block_first = 0;
+    written    = 0;
+    for (std::uint64_t& b : column_bytes)
+        b = 0;
+    err.clear();
+
+    file = std::fopen(path, "wb");
+    if (!file)
+        return fail(std::string("cannot create ") + path);
+
+    TrajectoryFileHeader h{};
+    std::memcpy(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    h.version   = TRAJECTORY_VERSION;
+    h.delta_dim = static_cast<std::uint16_t>(DELTA_DIM);
+    h.endian    = ENDIAN_MARK;
+
+    if (std::fwrite(&h, sizeof(h), 1, file) != 1)
+    {
+        std::fclose(file);
+        file = nullptr;
+        return fail(std::string("cannot write ") + path);
+    }
+    written = sizeof(h);
+    return true;
+}
+
+bool TrajectoryWriter::append(OrganismId id, std::uint64_t step, const StateEnvelope& env)
+{
+    if (!file)
+        return fail("trajectory file is not open");
+
+    TrajectoryBlock& B = open_block;
+
+    B.id.push_back(id);
+    B.step.push_back(step);
+
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        B.real[k].push_back(env.state.Delta[k]);
+    B.real[TRAJ_PHI - TRAJ_DELTA].push_back(env.state.Phi);
+    B.real[TRAJ_M - TRAJ_DELTA].push_back(env.state.M);
+    B.real[TRAJ_KAPPA - TRAJ_DELTA].push_back(env.state.Kappa);
+    B.real[TRAJ_CURVATURE_R - TRAJ_DELTA].push_back(env.metrics.curvature_R);
+    B.real[TRAJ_DET_G - TRAJ_DELTA].push_back(env.metrics.det_g);
+    B.real[TRAJ_TAU - TRAJ_DELTA].push_back(env.metrics.tau);
+    B.real[TRAJ_MU - TRAJ_DELTA].push_back(env.metrics.mu);
+    B.real[TRAJ_COLLAPSE_DISTANCE - TRAJ_DELTA].push_back(env.metrics.collapse_distance);
+    B.real[TRAJ_COLLAPSE_SPEED - TRAJ_DELTA].push_back(env.metrics.collapse_speed);
+    B.real[TRAJ_COLLAPSE_INTENSITY - TRAJ_DELTA].push_back(env.metrics.collapse_intensity);
+
+    B.code[TRAJ_REGIME_PREV - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.state.RegimePrev));
+    B.code[TRAJ_REGIME - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.metrics.regime));
+    B.code[TRAJ_MORPH_CLASS - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.metrics.morph_class));
+    B.code[TRAJ_STATUS - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.status));
+    B.code[TRAJ_ERROR_CATEGORY - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.error_category));
+    B.code[TRAJ_EVENT_TYPE - TRAJ_REGIME_PREV].push_back(static_cast<std::uint8_t>(env.event_type));
+    B.code[TRAJ_FLAGS - TRAJ_REGIME_PREV].push_back(
+        static_cast<std::uint8_t>((env.metrics.is_collapse ? FLAG_COLLAPSE : 0) |
+                                  (env.invariants.all_ok ? FLAG_ALL_OK : 0)));
+    B.invariants.push_back(env.invariants.flags);
+
+    ++B.rows;
+    ++next_row;
+
+    return B.rows < opt.block_rows || seal();
+}
+
+bool TrajectoryWriter::seal()
+{
+    TrajectoryBlock& B = open_block;
+    const std::size_t n = B.rows;
+    if (n == 0)
+        return true;
+
+    TrajectoryBlockStats s{};
+    s.id_min = *std::min_element(B.id.begin(), B.id.end());
+    s.id_max = *std::max_element(B.id.begin(), B.id.end());
+
+    // --- grouped order: stable by organism -----------------------------------
+    // counting sort when the block's id range is dense, merge sort otherwise
+    order.resize(n);
+    const std::size_t span = std::size_t{s.id_max} - s.id_min + 1;
+    if (std::is_sorted(B.id.begin(), B.id.end()))
+        std::iota(order.begin(), order.end(), 0u);
+    else if (span <= 2 * n)
+    {
+        slot.assign(span + 1, 0);
+        for (const OrganismId id : B.id)
+            ++slot[id - s.id_min + 1];
+        std::partial_sum(slot.begin(), slot.end(), slot.begin());
+        for (std::size_t r = 0; r < n; ++r)
+            order[slot[B.id[r] - s.id_min]++] = static_cast<std::uint32_t>(r);
+    }
+    else
+    {
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::uint32_t a, std::uint32_t b) { return B.id[a] < B.id[b]; });
+    }
+
+    // --- statistics --------------------------------------------------------------
+    s.step_min = *std::min_element(B.step.begin(), B.step.end());
+    s.step_max = *std::max_element(B.step.begin(), B.step.end());
+
+    for (std::size_t f = 0; f < TRAJ_REALS; ++f)
+    {
+        // four lanes: independent min / max chains
+        const double* v = B.real[f].data();
+        double lo[4], hi[4];
+        std::fill(lo, lo + 4, std::numeric_limits<double>::infinity());
+        std::fill(hi, hi + 4, -std::numeric_limits<double>::infinity());
+        std::size_t j = 0;
+        for (; j + 4 <= n; j += 4)
+            for (std::size_t l = 0; l < 4; ++l)
+            {
+                lo[l] = v[j + l] < lo[l] ? v[j + l] : lo[l];   // NaN compares false: ignored
+                hi[l] = v[j + l] > hi[l] ? v[j + l] : hi[l];
+            }
+        for (; j < n; ++j)
+        {
+            lo[0] = v[j] < lo[0] ? v[j] : lo[0];
+            hi[0] = v[j] > hi[0] ? v[j] : hi[0];
+        }
+        s.min[f] = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+        s.max[f] = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+    }
+    for (std::size_t c = 0; c < TRAJ_CODES; ++c)
+        for (const std::uint8_t v : B.code[c])
+            s.present[c] |= presenceBit(v);
+
+    s.invariants_all = ~std::uint32_t{0};
+    for (const std::uint32_t v : B.invariants)
+    {
+        s.invariants_any |= v;
+        s.invariants_all &= v;
+    }
+
+    // --- columns -------------------------------------------------------------------
+    std::vector<std::uint64_t> tmp(n);
+
+    auto gather = [&](auto get)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+            tmp[j] = get(order[j]);
+    };
+
+    for (std::vector<unsigned char>& c : column_out)
+        c.clear();
+
+    gather([&](std::uint32_t r) { return std::uint64_t{B.id[r]}; });
+    encodeDeltaRuns(tmp.data(), n, column_out[TRAJ_ID]);
+    gather([&](std::uint32_t r) { return B.step[r]; });
+    encodeDeltaRuns(tmp.data(), n, column_out[TRAJ_STEP]);
+
+    for (std::size_t f = 0; f < TRAJ_REALS; ++f)
+    {
+        const std::vector<double>& col = B.real[f];
+        gather([&](std::uint32_t r) { return bits(col[r]); });
+        encodeXor(tmp.data(), n, column_out[TRAJ_DELTA + f]);
+    }
+
+    std::vector<std::uint8_t> codes(n);
+    for (std::size_t c = 0; c < TRAJ_CODES; ++c)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+            codes[j] = B.code[c][order[j]];
+        encodeRuns(codes.data(), n, column_out[TRAJ_REGIME_PREV + c]);
+    }
+
+    std::vector<std::uint32_t> inv(n);
+    for (std::size_t j = 0; j < n; ++j)
+        inv[j] = B.invariants[order[j]];
+    encodeRuns(inv.data(), n, column_out[TRAJ_INVARIANTS]);
+
+    // --- block -------------------------------------------------------------------------
+    TrajectoryColumnEntry directory[TRAJ_COLUMNS];
+    std::size_t           bytes = BLOCK_PREFIX;
+    for (std::size_t c = 0; c < TRAJ_COLUMNS; ++c)
+    {
+        directory[c].bytes    = static_cast<std::uint32_t>(column_out[c].size());
+        directory[c].checksum = crc32c(column_out[c].data(), column_out[c].size());
+        bytes                += column_out[c].size();
+    }
+    bytes = (bytes + 7) & ~std::size_t{7};
+
+    out.assign(sizeof(TrajectoryBlockHeader) + bytes, 0);
+    unsigned char* p = out.data() + sizeof(TrajectoryBlockHeader);
+    std::memcpy(p, &s, sizeof(s));
+    std::memcpy(p + sizeof(s), directory, sizeof(directory));
+    p += BLOCK_PREFIX;
+    for (std::size_t c = 0; c < TRAJ_COLUMNS; ++c)
+    {
+        if (!column_out[c].empty())
+            std::memcpy(p, column_out[c].data(), column_out[c].size());
+        p += column_out[c].size();
+        column_bytes[c] += column_out[c].size();
+    }
+
+    TrajectoryBlockHeader h{};
+    h.magic     = TRAJECTORY_BLOCK_MAGIC;
+    h.rows      = static_cast<std::uint32_t>(n);
+    h.bytes     = static_cast<std::uint32_t>(bytes);
+    h.checksum  = crc32c(out.data() + sizeof(h), BLOCK_PREFIX);
+    h.first_row = block_first;
+    std::memcpy(out.data(), &h, sizeof(h));
+
+    // --- reset the open block (capacity kept) -------------------------------------
+    B.rows = 0;
+    B.id.clear();
+    B.step.clear();
+    for (std::vector<double>& c : B.real) c.clear();
+    for (std::vector<std::uint8_t>& c : B.code) c.clear();
+    B.invariants.clear();
+    block_first += n;
+
+    if (std::fwrite(out.data(), 1, out.size(), file) != out.size())
+        return fail("trajectory write failed");
+    written += out.size();
+    return true;
+}
+
+bool TrajectoryWriter::flush()
+{
+    if (!file)
+        return fail("trajectory file is not open");
+    if (!seal())
+        return false;
+    if (std::fflush(file) != 0)
+        return fail("trajectory flush failed");
+    return true;
+}
+
+bool TrajectoryWriter::close()
+{
+    if (!file)
+        return true;
+
+    const bool ok = flush();
+    if (std::fclose(file) != 0 && ok)
+    {
+        file = nullptr;
+        return fail("trajectory close failed");
+    }
+    file = nullptr;
+    return ok;
+}
+
+// ============================================================================
+// TrajectoryReader
+// ============================================================================
+TrajectoryReader::~TrajectoryReader()
+{
+    close();
+}
+
+bool TrajectoryReader::fail(const std::string& what)
+{
+    close();
+    err = what;
+    return false;
+}
+
+void TrajectoryReader::close() noexcept
+{
+    file.close();
+    data = nullptr;
+    size = 0;
+    index.clear();
+    total = 0;
+    torn  = false;
+}
+
+bool TrajectoryReader::open(const char* path)
+{
+    close();
+    err.clear();
+
+    std::string why;
+    if (!file.open(path, why))
+        return fail(why);
+    if (file.size() < sizeof(TrajectoryFileHeader))
+        return fail(std::string("not an FMRT trajectory file: ") + path);
+
+    data = file.data();
+    size = file.size();
+
+    TrajectoryFileHeader h;
+    std::memcpy(&h, data, sizeof(h));
+    if (!validFileHeader(h, why))
+        return fail(why);
+
+    // --- block index -----------------------------------------------------------
+    std::size_t off = sizeof(TrajectoryFileHeader);
+    while (size - off >= sizeof(TrajectoryBlockHeader))
+    {
+        const TrajectoryBlockHeader* b = reinterpret_cast<const TrajectoryBlockHeader*>(data + off);
+        if (b->magic != TRAJECTORY_BLOCK_MAGIC || b->bytes % 8 != 0 || b->bytes < BLOCK_PREFIX ||
+            b->bytes > size - off - sizeof(TrajectoryBlockHeader))
+            break;
+
+        index.push_back(b);
+        total += b->rows;
+        off   += sizeof(TrajectoryBlockHeader) + b->bytes;
+    }
+    torn = off != size;
+    return true;
+}
+
+bool TrajectoryReader::mayContain(std::size_t b, std::size_t column, double lo, double hi) const noexcept
+{
+    const TrajectoryBlockStats& s = blockStats(b);
+
+    if (column == TRAJ_ID)
+        return !(hi < s.id_min || lo > s.id_max);
+    if (column == TRAJ_STEP)
+        return !(hi < static_cast<double>(s.step_min) || lo > static_cast<double>(s.step_max));
+    if (column < TRAJ_REGIME_PREV)
+        return !(hi < s.min[column - TRAJ_DELTA] || lo > s.max[column - TRAJ_DELTA]);
+    if (column < TRAJ_INVARIANTS)
+    {
+        const std::uint32_t present = s.present[column - TRAJ_REGIME_PREV];
+        for (unsigned v = 0; v < 32; ++v)       // bit 31: some value >= 31
+            if ((present >> v & 1u) && v <= hi && (v >= lo || v == 31))
+                return true;
+        return false;
+    }
+    return true;
+}
+
+bool TrajectoryReader::decode(std::size_t b, TrajectoryBlock& out, std::uint64_t columns, bool verify)
+{
+    const TrajectoryBlockHeader& h = *index[b];
+    const unsigned char*         p = reinterpret_cast<const unsigned char*>(&h) + sizeof(h);
+
+    if (verify && crc32c(p, BLOCK_PREFIX) != h.checksum)
+    {
+        err = "block " + std::to_string(b) + ": checksum mismatch";
+        return false;
+    }
+
+    TrajectoryColumnEntry directory[TRAJ_COLUMNS];
+    std::memcpy(directory, p + sizeof(TrajectoryBlockStats), sizeof(directory));
+
+    const std::size_t n = h.rows;
+    out.rows    = n;
+    out.columns = columns & TRAJ_ALL;
+
+    const unsigned char* col = p + BLOCK_PREFIX;
+    const unsigned char* end = p + h.bytes;
+    std::vector<std::uint64_t> tmp;
+
+    for (std::size_t c = 0; c < TRAJ_COLUMNS; ++c)
+    {
+        const unsigned char* at = col;
+        if (directory[c].bytes > static_cast<std::size_t>(end - col))
+        {
+            err = "block " + std::to_string(b) + ": column directory exceeds the block";
+            return false;
+        }
+        col += directory[c].bytes;
+
+        if (!(columns & trajColumn(c)))
+            continue;
+
+        if (verify && crc32c(at, directory[c].bytes) != directory[c].checksum)
+        {
+            err = "block " + std::to_string(b) + ": column " + trajectoryColumnName(c) + " checksum mismatch";
+            return false;
+        }
+
+        bool ok;
+        if (c == TRAJ_ID)
+        {
+            out.id.resize(n);
+            ok = decodeDeltaRuns(at, col, out.id.data(), n);
+        }
+        else if (c == TRAJ_STEP)
+        {
+            out.step.resize(n);
+            ok = decodeDeltaRuns(at, col, out.step.data(), n);
+        }
+        else if (c < TRAJ_REGIME_PREV)
+        {
+            std::vector<double>& v = out.real[c - TRAJ_DELTA];
+            v.resize(n);
+            tmp.resize(n);
+            ok = decodeXor(at, col, tmp.data(), n);
+            if (ok)
+                std::memcpy(v.data(), tmp.data(), n * sizeof(double));
+        }
+        else if (c < TRAJ_INVARIANTS)
+        {
+            out.code[c - TRAJ_REGIME_PREV].resize(n);
+            ok = decodeRuns(at, col, out.code[c - TRAJ_REGIME_PREV].data(), n);
+        }
+        else
+        {
+            out.invariants.resize(n);
+            ok = decodeRuns(at, col, out.invariants.data(), n);
+        }
+
+        if (!ok)
+        {
+            err = "block " + std::to_string(b) + ": column " + trajectoryColumnName(c) + " does not decode";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace fmrt
@@ -0,0 +1,263 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_trajectory.hpp
+//
+// Trajectory store: compressed, columnar record of StateEnvelope rows
+// (organism id, step index, envelope) for audit and analysis.
+//
+// Layout (host byte order, checked through `endian`, like the event log):
+//
+//   file   TrajectoryFileHeader, then blocks back to back
+//   block  TrajectoryBlockHeader, TrajectoryBlockStats, the column
+//          directory (TrajectoryColumnEntry[TRAJ_COLUMNS]: byte length and
+//          CRC-32C of each column), the columns, zero padding to a multiple
+//          of 8 bytes. The header checksum covers stats and directory, so
+//          a decode verifies only what it reads.
+//
+// Rows are collected into blocks of block_rows; a block stores its rows
+// grouped by organism (stable: one organism's rows keep their order), so
+// each column holds runs of one organism's consecutive values. Codecs:
+//
+//   id, step            delta to the previous row, zigzag, with runs of
+//                       equal deltas merged: (delta, run) as LEB128 pairs
+//   real columns        XOR with the previous value (Gorilla): '0' for a
+//                       repeat, '10' + bits inside the previous window of
+//                       leading / trailing zeros, '11' + 5-bit leading
+//                       zeros, 6-bit length and the bits otherwise
+//   code columns        run-length (value, run); invariant flags as
+//                       (LEB128 value, run)
+//
+// TrajectoryBlockStats holds min / max of every real column, id and step
+// ranges and a bit per code value present, so a query can skip blocks
+// (mayContain) without decoding or checksumming them. decode() expands
+// only the requested columns.
+//
+// error_reason is not stored; envelope() restores
+// errorCategoryToString(error_category), the step path's reason for every
+// category but explicit reject reasons.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet_event.hpp"
+#include "fmrt_mapped_file.hpp"
+
+namespace fmrt
+{
+    constexpr std::uint16_t TRAJECTORY_VERSION = 1;
+
+    // -------------------------------------------------------------------------
+    // Columns
+    // -------------------------------------------------------------------------
+    constexpr std::size_t TRAJ_ID                  = 0;
+    constexpr std::size_t TRAJ_STEP                = 1;
+    constexpr std::size_t TRAJ_DELTA               = 2;     // + k, k < DELTA_DIM
+    constexpr std::size_t TRAJ_PHI                 = TRAJ_DELTA + DELTA_DIM;
+    constexpr std::size_t TRAJ_M                   = TRAJ_PHI + 1;
+    constexpr std::size_t TRAJ_KAPPA               = TRAJ_PHI + 2;
+    constexpr std::size_t TRAJ_CURVATURE_R         = TRAJ_PHI + 3;
+    constexpr std::size_t TRAJ_DET_G               = TRAJ_PHI + 4;
+    constexpr std::size_t TRAJ_TAU                 = TRAJ_PHI + 5;
+    constexpr std::size_t TRAJ_MU                  = TRAJ_PHI + 6;
+    constexpr std::size_t TRAJ_COLLAPSE_DISTANCE   = TRAJ_PHI + 7;
+    constexpr std::size_t TRAJ_COLLAPSE_SPEED      = TRAJ_PHI + 8;
+    constexpr std::size_t TRAJ_COLLAPSE_INTENSITY  = TRAJ_PHI + 9;
+    constexpr std::size_t TRAJ_REGIME_PREV         = TRAJ_PHI + 10;  // state.RegimePrev
+    constexpr std::size_t TRAJ_REGIME              = TRAJ_PHI + 11;  // metrics.regime
+    constexpr std::size_t TRAJ_MORPH_CLASS         = TRAJ_PHI + 12;
+    constexpr std::size_t TRAJ_STATUS              = TRAJ_PHI + 13;
+    constexpr std::size_t TRAJ_ERROR_CATEGORY      = TRAJ_PHI + 14;
+    constexpr std::size_t TRAJ_EVENT_TYPE          = TRAJ_PHI + 15;
+    constexpr std::size_t TRAJ_FLAGS               = TRAJ_PHI + 16;  // is_collapse | all_ok << 1
+    constexpr std::size_t TRAJ_INVARIANTS          = TRAJ_PHI + 17;  // invariants.flags
+    constexpr std::size_t TRAJ_COLUMNS             = TRAJ_PHI + 18;
+
+    constexpr std::size_t TRAJ_REALS = TRAJ_REGIME_PREV - TRAJ_DELTA;    // double columns
+    constexpr std::size_t TRAJ_CODES = TRAJ_INVARIANTS - TRAJ_REGIME_PREV;  // byte columns
+
+    constexpr std::uint64_t TRAJ_ALL = (std::uint64_t{1} << TRAJ_COLUMNS) - 1;
+
+    constexpr std::uint64_t trajColumn(std::size_t c) noexcept { return std::uint64_t{1} << c; }
+
+    static_assert(TRAJ_COLUMNS <= 64, "column masks are 64-bit");
+
+    // column name ("kappa", "delta0", ...)
+    const char* trajectoryColumnName(std::size_t column) noexcept;
+
+    // -------------------------------------------------------------------------
+    // File format
+    // -------------------------------------------------------------------------
+    struct TrajectoryFileHeader
+    {
+        char          magic[8];         // "FMRTTRAJ"
+        std::uint16_t version;          // TRAJECTORY_VERSION
+        std::uint16_t delta_dim;
+        std::uint32_t endian;           // 0x01020304 as stored by the writer
+        std::uint64_t reserved[2];      // zero
+    };
+
+    struct TrajectoryBlockHeader
+    {
+        std::uint32_t magic;            // TRAJECTORY_BLOCK_MAGIC
+        std::uint32_t rows;
+        std::uint32_t bytes;            // after this header, padding included
+        std::uint32_t checksum;         // CRC-32C of stats and column directory
+        std::uint64_t first_row;        // index of the block's first row in the file
+        std::uint64_t reserved;         // zero
+    };
+
+    struct TrajectoryBlockStats
+    {
+        double        min[TRAJ_REALS];  // by column - TRAJ_DELTA; NaNs ignored
+        double        max[TRAJ_REALS];
+        std::uint64_t step_min;
+        std::uint64_t step_max;
+        std::uint32_t id_min;
+        std::uint32_t id_max;
+        std::uint32_t present[TRAJ_CODES];      // bit v: code value v occurs (>= 31: bit 31)
+        std::uint32_t invariants_any;           // OR of the invariant flags
+        std::uint32_t invariants_all;           // AND of the invariant flags
+        std::uint32_t reserved;
+    };
+
+    struct TrajectoryColumnEntry
+    {
+        std::uint32_t bytes;
+        std::uint32_t checksum;         // CRC-32C of the column
+    };
+
+    constexpr std::uint32_t TRAJECTORY_BLOCK_MAGIC = 0x4B4C4254u;   // "TBLK"
+
+    static_assert(sizeof(TrajectoryFileHeader) == 32, "trajectory file header is 32 bytes");
+    static_assert(sizeof(TrajectoryBlockHeader) == 32, "trajectory block header is 32 bytes");
+    static_assert(sizeof(TrajectoryBlockStats) % 8 == 0, "trajectory block stats keep 8-byte alignment");
+
+    // -------------------------------------------------------------------------
+    // Decoded block (structure of arrays; only decoded columns are filled)
+    // -------------------------------------------------------------------------
+    struct TrajectoryBlock
+    {
+        std::size_t                rows = 0;
+        std::uint64_t              columns = 0;         // mask of the decoded columns
+        std::vector<OrganismId>    id;
+        std::vector<std::uint64_t> step;
+        std::vector<double>        real[TRAJ_REALS];    // by column - TRAJ_DELTA
+        std::vector<std::uint8_t>  code[TRAJ_CODES];    // by column - TRAJ_REGIME_PREV
+        std::vector<std::uint32_t> invariants;
+
+        const double*       reals(std::size_t column) const noexcept { return real[column - TRAJ_DELTA].data(); }
+        const std::uint8_t* codes(std::size_t column) const noexcept { return code[column - TRAJ_REGIME_PREV].data(); }
+
+        // row as an envelope (every column decoded)
+        StateEnvelope envelope(std::size_t row) const noexcept;
+    };
+
+    // -------------------------------------------------------------------------
+    // Writer
+    // -------------------------------------------------------------------------
+    struct TrajectoryOptions
+    {
+        std::size_t block_rows = 4096;
+    };
+
+    class TrajectoryWriter
+    {
+    public:
+        TrajectoryWriter() = default;
+        ~TrajectoryWriter();
+
+        TrajectoryWriter(const TrajectoryWriter&)            = delete;
+        TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+        // creates (truncates) the file; false: see error()
+        bool open(const char* path, const TrajectoryOptions& options = TrajectoryOptions{});
+
+        bool append(OrganismId id, std::uint64_t step, const StateEnvelope& env);
+
+        // seals the open block and writes it (fflush)
+        bool flush();
+        bool close();
+
+        bool          isOpen() const noexcept { return file != nullptr; }
+        std::uint64_t rows() const noexcept { return next_row; }        // incl. buffered
+        std::uint64_t bytes() const noexcept { return written; }        // written to the file
+        const std::string& error() const noexcept { return err; }
+
+        // encoded bytes per column so far (sealed blocks)
+        const std::uint64_t* columnBytes() const noexcept { return column_bytes; }
+
+    private:
+        bool seal();
+        bool fail(const std::string& what);
+
+        std::FILE*                 file = nullptr;
+        TrajectoryOptions          opt;
+        TrajectoryBlock            open_block;      // rows of the open block, arrival order
+        std::vector<std::uint32_t> order;           // grouped row order of the block
+        std::vector<std::uint32_t> slot;            // counting sort: first slot per id
+        std::vector<unsigned char> out;             // encoded block
+        std::vector<unsigned char> column_out[TRAJ_COLUMNS];
+        std::uint64_t              next_row    = 0;
+        std::uint64_t              block_first = 0;
+        std::uint64_t              written     = 0;
+        std::uint64_t              column_bytes[TRAJ_COLUMNS] = {};
+        std::string                err;
+    };
+
+    // -------------------------------------------------------------------------
+    // Reader
+    // -------------------------------------------------------------------------
+    class TrajectoryReader
+    {
+    public:
+        TrajectoryReader() = default;
+        ~TrajectoryReader();
+
+        TrajectoryReader(const TrajectoryReader&)            = delete;
+        TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+        // maps the file, checks the header and indexes the blocks
+        bool open(const char* path);
+        void close() noexcept;
+
+        std::size_t   blocks() const noexcept    { return index.size(); }
+        std::uint64_t rows() const noexcept      { return total; }
+        bool          truncated() const noexcept { return torn; }       // torn last block ignored
+
+        const TrajectoryBlockHeader& blockHeader(std::size_t b) const noexcept { return *index[b]; }
+        const TrajectoryBlockStats&  blockStats(std::size_t b) const noexcept
+        {
+            return *reinterpret_cast<const TrajectoryBlockStats*>(index[b] + 1);
+        }
+
+        // false: no row of block b has column in [lo, hi] (id, step, real
+        // columns: value range; code columns: value present). true: some
+        // row may. Invariant flags are not indexed (always true).
+        bool mayContain(std::size_t b, std::size_t column, double lo, double hi) const noexcept;
+
+        // Decodes the columns in `columns` (TRAJ_ALL: all) of block b.
+        // false on a checksum (verify) or codec mismatch: see error().
+        bool decode(std::size_t b, TrajectoryBlock& out, std::uint64_t columns = TRAJ_ALL,
+                    bool verify = true);
+
+        const std::string& error() const noexcept { return err; }
+
+    private:
+        bool fail(const std::string& what);
+
+        MappedFile                                file;
+        const unsigned char*                      data = nullptr;
+        std::size_t                               size = 0;
+        std::vector<const TrajectoryBlockHeader*> index;
+        std::uint64_t                             total = 0;
+        bool                                      torn  = false;
+        std::string                               err;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,196 @@
+//
+// FMRT Core V2.2
+// fmrt_workload.cpp
+//
+// Event synthesis behind fmrt::MarketWorkload.
+//
+// Philox counter of a draw: { index lo, index hi, organism id, tag } under
+// the key { seed lo, seed hi }. Tags keep the draws of one index apart:
+//   TAG_EVENT        kind (halt / heartbeat / update) and dt
+//   TAG_STIMULUS + j stimulus components 2j and 2j + 1
+//   TAG_BLOCK        block kind; `index` is then the block number
+//
+// Uniforms are 53-bit values in (0, 1]; Lomax variates use the inverse
+// CDF λ (u^(-1/α) - 1) with α = 2 (one sqrt) or α = 4 (two sqrts), which
+// keeps every operation correctly rounded and the streams portable.
+//
+
+#include "fmrt_workload.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fmrt
+{
+    namespace
+    {
+        constexpr std::uint32_t TAG_EVENT    = 0;
+        constexpr std::uint32_t TAG_STIMULUS = 1;
+        constexpr std::uint32_t TAG_BLOCK    = 0x80000000u;
+
+        // Lomax inter-arrivals may round to exactly 0; every non-RESET
+        // event needs dt > 0, so dt starts at this fraction of its mean
+        constexpr double DT_FLOOR = 1e-6;
+
+        inline double uniformA(const Philox4x32::Block& r) noexcept
+        {
+            return Philox4x32::uniform(r.v[0], r.v[1]);
+        }
+
+        inline double uniformB(const Philox4x32::Block& r) noexcept
+        {
+            return Philox4x32::uniform(r.v[2], r.v[3]);
+        }
+
+        // Lomax, tail index 2, mean m
+        inline double lomax2(double u, double m) noexcept
+        {
+            return m * (DT_FLOOR + (1.0 / std::sqrt(u) - 1.0));
+        }
+
+        // Lomax, tail index 4, mean m (λ = 3m)
+        inline double lomax4(double u, double m) noexcept
+        {
+            return 3.0 * m * (1.0 / std::sqrt(std::sqrt(u)) - 1.0);
+        }
+    } // namespace
+
+MarketWorkload::MarketWorkload(const WorkloadConfig& config) noexcept
+    : cfg(config)
+{
+    key.v[0] = static_cast<std::uint32_t>(cfg.seed);
+    key.v[1] = static_cast<std::uint32_t>(cfg.seed >> 32);
+
+    cfg.block_events = std::max<std::uint32_t>(cfg.block_events, 1);
+}
+
+Philox4x32::Block MarketWorkload::draw(OrganismId id, std::uint64_t index, std::uint32_t tag) const noexcept
+{
+    const Philox4x32::Counter c = { {
+        static_cast<std::uint32_t>(index),
+        static_cast<std::uint32_t>(index >> 32),
+        id,
+        tag
+    } };
+    return Philox4x32::generate(c, key);
+}
+
+MarketWorkload::Block MarketWorkload::block(OrganismId id, std::uint64_t b) const noexcept
+{
+    const double u = uniformA(draw(id, b, TAG_BLOCK));
+
+    if (u <= cfg.flood_probability)
+        return Block::Flood;
+    if (u <= cfg.flood_probability + cfg.burst_probability)
+        return Block::Burst;
+    return Block::Calm;
+}
+
+StructEvent MarketWorkload::event(OrganismId id, std::uint64_t index) const noexcept
+{
+    StructEvent E;
+    generate(id, index, 1, &E);
+    return E;
+}
+
+void MarketWorkload::generate(OrganismId id, std::uint64_t first, std::size_t n, StructEvent* out) const noexcept
+{
+    std::uint64_t block_no   = ~std::uint64_t{0};
+    Block         block_kind = Block::Calm;
+
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        const std::uint64_t index = first + j;
+        StructEvent&        E     = out[j];
+
+        E = StructEvent{};
+
+        // --- session open ------------------------------------------------
+        const std::uint64_t pos = cfg.session_events ? index % cfg.session_events : index;
+        const Philox4x32::Block r = draw(id, index, TAG_EVENT);
+
+        if (cfg.session_events && index > 0 && pos == 0)
+        {
+            E.type = EventType::Gap;
+            E.dt   = cfg.overnight_dt * (0.5 + uniformB(r));
+            continue;
+        }
+
+        // --- block kind (drawn once per block) ---------------------------
+        if (index / cfg.block_events != block_no)
+        {
+            block_no   = index / cfg.block_events;
+            block_kind = block(id, block_no);
+        }
+
+        const double kind = uniformA(r);
+
+        if (kind <= cfg.halt_probability)
+        {
+            E.type = EventType::Gap;
+            E.dt   = cfg.halt_dt * (0.5 + uniformB(r));
+            continue;
+        }
+
+        if (block_kind == Block::Flood || kind <= cfg.halt_probability + cfg.heartbeat_share)
+        {
+            E.type = EventType::Heartbeat;
+            E.dt   = cfg.heartbeat_dt;
+            continue;
+        }
+
+        // --- UPDATE ------------------------------------------------------
+        double mean = cfg.mean_dt;
+        if (cfg.session_events)
+        {
+            const double x = 2.0 * static_cast<double>(pos) / static_cast<double>(cfg.session_events) - 1.0;
+            mean /= 1.0 + cfg.open_close_boost * x * x;
+        }
+        if (block_kind == Block::Burst)
+            mean /= cfg.burst_multiplier;
+
+        E.type = EventType::Update;
+        E.dt   = lomax2(uniformB(r), mean);
+
+        for (std::size_t k = 0; k < DELTA_DIM; k += 2)
+        {
+            const Philox4x32::Block s = draw(id, index, TAG_STIMULUS + static_cast<std::uint32_t>(k / 2));
+
+            const double a = std::min(lomax4(uniformA(s), cfg.stimulus_scale), cfg.stimulus_cap);
+            E.stimulus[k] = (s.v[1] & 1u) ? -a : a;
+
+            if (k + 1 < DELTA_DIM)
+            {
+                const double b = std::min(lomax4(uniformB(s), cfg.stimulus_scale), cfg.stimulus_cap);
+                E.stimulus[k + 1] = (s.v[3] & 1u) ? -b : b;
+            }
+        }
+    }
+}
+
+void MarketWorkload::generate(OrganismId id, std::uint64_t first, std::size_t n, FleetEvent* out) const noexcept
+{
+    // in chunks through a small StructEvent buffer (blocks drawn once per chunk)
+    constexpr std::size_t CHUNK = 64;
+    StructEvent buf[CHUNK];
+
+    for (std::size_t done = 0; done < n; )
+    {
+        const std::size_t m = std::min(CHUNK, n - done);
+        generate(id, first + done, m, buf);
+        for (std::size_t j = 0; j < m; ++j)
+            out[done + j] = FleetEvent::make(id, buf[j]);
+        done += m;
+    }
+}
+
+void MarketWorkload::round(std::uint64_t index, OrganismId first_id, std::size_t n, FleetEvent* out) const noexcept
+{
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        const OrganismId id = first_id + static_cast<OrganismId>(j);
+        out[j] = FleetEvent::make(id, event(id, index));
+    }
+}
+
+} // namespace fmrt
@@ -0,0 +1,97 @@
+#pragma once
+//
+// FMRT Core V2.2
+// fmrt_workload.hpp
+//
+// MarketWorkload: deterministic synthetic event streams for benchmarks
+// and soak tests, one stream per organism.
+//
+// Event `index` of organism `id` is a pure function of (seed, id, index)
+// through Philox4x32-10 (fmrt_philox.hpp): streams are generated in
+// parallel per organism and sliced at any offset without replaying what
+// came before. Every transform uses only + - * / and sqrt, so a stream is
+// bit-identical on every platform and compiler.
+//
+// Stream structure:
+//   - sessions of session_events events; the first event of every
+//     session but the first is an overnight GAP (dt ~ overnight_dt),
+//     and any event may be an intraday halt GAP (halt_probability)
+//   - activity is U-shaped over a session: inter-arrival times shrink by
+//     up to 1 + open_close_boost at the open and the close
+//   - the stream is cut into blocks of block_events events; a block is
+//     calm, a burst (inter-arrival times / burst_multiplier) or a
+//     heartbeat flood (only HEARTBEATs, dt = heartbeat_dt)
+//   - outside floods an event is a HEARTBEAT with heartbeat_share, else an
+//     UPDATE
+//   - UPDATE dt: Lomax (Pareto II, tail index 2) with mean mean_dt —
+//     mostly short waits with occasional long pauses
+//   - UPDATE stimulus: independent signs, magnitudes Lomax with tail index
+//     4 (finite variance, fat tails like return distributions) and mean
+//     stimulus_scale, capped at stimulus_cap
+//
+// No RESETs are generated.
+//
+
+#include <cstddef>
+#include <cstdint>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet_event.hpp"
+#include "fmrt_philox.hpp"
+
+namespace fmrt
+{
+    struct WorkloadConfig
+    {
+        std::uint64_t seed = 0;
+
+        // --- sessions ---------------------------------------------------------
+        std::uint32_t session_events   = 4096;  // 0: one endless session
+        double        overnight_dt     = 16.0;  // mean dt of the session-open GAP
+        double        halt_probability = 0.0005;
+        double        halt_dt          = 0.5;   // mean dt of a halt GAP
+        double        open_close_boost = 2.0;   // activity x (1 + boost) at open / close
+
+        // --- arrivals ---------------------------------------------------------
+        std::uint32_t block_events      = 64;   // granularity of bursts / floods
+        double        burst_probability = 0.1;  // share of burst blocks
+        double        burst_multiplier  = 10.0;
+        double        flood_probability = 0.02; // share of heartbeat-flood blocks
+        double        heartbeat_share   = 0.05;
+        double        heartbeat_dt      = 0.01;
+        double        mean_dt           = 0.05; // calm UPDATE inter-arrival mean
+
+        // --- stimulus ---------------------------------------------------------
+        double        stimulus_scale = 0.2;     // mean |stimulus[k]|
+        double        stimulus_cap   = 5.0;
+    };
+
+    class MarketWorkload
+    {
+    public:
+        explicit MarketWorkload(const WorkloadConfig& config = WorkloadConfig{}) noexcept;
+
+        const WorkloadConfig& config() const noexcept { return cfg; }
+
+        // event `index` of organism `id` (reason is null)
+        StructEvent event(OrganismId id, std::uint64_t index) const noexcept;
+
+        // events first .. first + n - 1 of organism id
+        void generate(OrganismId id, std::uint64_t first, std::size_t n, StructEvent* out) const noexcept;
+        void generate(OrganismId id, std::uint64_t first, std::size_t n, FleetEvent* out) const noexcept;
+
+        // event `index` of organisms first_id .. first_id + n - 1, in id
+        // order: one round of an interleaved fleet stream
+        void round(std::uint64_t index, OrganismId first_id, std::size_t n, FleetEvent* out) const noexcept;
+
+    private:
+        enum class Block : std::uint8_t { Calm, Burst, Flood };
+
+        Block block(OrganismId id, std::uint64_t b) const noexcept;
+        Philox4x32::Block draw(OrganismId id, std::uint64_t index, std::uint32_t tag) const noexcept;
+
+        WorkloadConfig   cfg;
+        Philox4x32::Key  key;
+    };
+
+} // namespace fmrt
@@ -0,0 +1,519 @@
+//
+// FMRT Core V2.2
+// batch_kernel.cpp
+//
+// Every helper below reproduces the scalar expression from
+// evolution_engine.cpp / invariant_validator.cpp with the same operand
+// order. std::max / std::min are expanded to their exact comparison
+// semantics so signed zeros and NaNs propagate identically.
+//
+
+#include "internal/batch_kernel.hpp"
+#include "fmrt_constants.hpp"
+#include "fmrt_invariants.hpp"
+#include "internal/unroll.hpp"
+#include "internal/det_exp.hpp"
+
+#include <cfloat>
+#include <cmath>
+
+namespace fmrt
+{
+using simd::VecD;
+using simd::MaskD;
+using simd::set1;
+using simd::load;
+using simd::add;
+using simd::sub;
+using simd::mul;
+using simd::div;
+using simd::lt;
+using simd::le;
+using simd::gt;
+using simd::ge;
+using simd::eq;
+using simd::ne;
+using simd::select;
+
+namespace
+{
+    // engineExp per lane: the vector kernel when it is deterministic,
+    // otherwise std::exp lane by lane (no vector form with identical rounding)
+    inline VecD expLanes(VecD x) noexcept
+    {
+        if constexpr (DETERMINISTIC_EXP)
+        {
+            return simd::detExp(x);
+        }
+        else
+        {
+            alignas(64) double v[simd::LANES];
+            simd::store(v, x);
+            for (auto& e : v) e = std::exp(e);
+            return load(v);
+        }
+    }
+
+    // std::max(a, b) == (a < b) ? b : a
+    inline VecD stdMax(VecD a, VecD b) noexcept { return select(lt(a, b), b, a); }
+
+    // std::min(a, b) == (b < a) ? b : a
+    inline VecD stdMin(VecD a, VecD b) noexcept { return select(lt(b, a), b, a); }
+
+    inline MaskD finite(VecD x) noexcept
+    {
+        return le(simd::abs(x), set1(DBL_MAX));
+    }
+
+    // Same acceptance as FMRT_Step numeric reject: finite and not subnormal.
+    inline MaskD numericSafe(VecD x) noexcept
+    {
+        return ~(simd::nonFinite(x) | simd::subnormal(x));
+    }
+
+    template <std::size_t N>
+    inline VecD computeCurvature(const VecD* delta, VecD phi, VecD m, VecD kappa) noexcept
+    {
+        VecD norm2 = set1(0.0);
+        forEachIndex<N>([&](std::size_t k) { norm2 = add(norm2, mul(delta[k], delta[k])); });
+
+        const VecD denom = add(set1(1.0), kappa);
+        const VecD mem   = div(m, denom);
+
+        return add(add(mul(set1(CURV_A1), norm2),
+                       mul(set1(CURV_A2), phi)),
+                   mul(set1(CURV_A3), mem));
+    }
+
+    inline VecD computeDetG(VecD R, VecD kappa) noexcept
+    {
+        const VecD zero = set1(0.0);
+        const VecD eps  = set1(EPS_METRIC);
+
+        const VecD raw = mul(mul(set1(METRIC_C1), expLanes(mul(set1(-METRIC_C2), R))), kappa);
+
+        VecD det = select(lt(raw, eps), eps, raw);
+        det = select(le(raw, zero), eps, det);
+        return select(le(kappa, zero), zero, det);
+    }
+
+    inline VecD computeTau(VecD kappa) noexcept
+    {
+        const VecD zero = set1(0.0);
+        const VecD tmin = set1(TAU_MIN);
+
+        const VecD tau = add(tmin, mul(set1(TAU_SCALE), expLanes(mul(set1(-LAMBDA_K), kappa))));
+
+        return select(le(kappa, zero), zero, select(lt(tau, tmin), tmin, tau));
+    }
+
+    inline VecD computeMu(VecD R) noexcept
+    {
+        const VecD zero  = set1(0.0);
+        const VecD denom = add(R, set1(MORPH_BETA));
+        const VecD raw   = div(R, denom);
+
+        VecD mu = stdMin(stdMax(raw, zero), set1(1.0));
+        mu = select(le(denom, set1(EPS)), zero, mu);
+        return select(le(R, zero), zero, mu);
+    }
+
+    // MorphologyClass encoded as 0..3 (Elastic .. NearCollapse)
+    inline VecD classifyMorphology(VecD mu) noexcept
+    {
+        VecD mc = set1(3.0);
+        mc = select(lt(mu, set1(0.75)), set1(2.0), mc);
+        mc = select(lt(mu, set1(0.50)), set1(1.0), mc);
+        mc = select(lt(mu, set1(0.25)), set1(0.0), mc);
+        return mc;
+    }
+
+    // Regime encoded as 0..3 (ACC .. COL)
+    inline VecD computeRegime(VecD previous, VecD mc, VecD kappa) noexcept
+    {
+        const VecD rel = set1(static_cast<double>(Regime::REL));
+
+        VecD candidate = select(lt(mc, rel), mc, rel);
+        candidate = select(le(kappa, set1(0.0)),
+                           set1(static_cast<double>(Regime::COL)),
+                           candidate);
+
+        return select(lt(candidate, previous), previous, candidate);
+    }
+
+    inline bool laneSet(unsigned mask, std::size_t l) noexcept
+    {
+        return ((mask >> l) & 1u) != 0;
+    }
+
+    // Where stepLanes takes the events of its lanes from
+    enum class LaneSource
+    {
+        PerLane,    // step():   one canonical event per lane (LaneEvents)
+        Tick,       // tick():   one GAP / HEARTBEAT of duration dt
+        Factor      // factor(): one UPDATE, stimulus loading[i] * shock
+    };
+
+    // The event parts shared by all lanes (Tick / Factor)
+    struct SharedEvent
+    {
+        double        dt      = 0.0;
+        const double* shock   = nullptr;    // N values
+        const double* loading = nullptr;    // one per organism
+    };
+
+    // -------------------------------------------------------------------------
+    // stepLanes:
+    //   Body of BatchKernel::step, tick and factor.
+    //
+    //   Tick: for a GAP / HEARTBEAT the scalar pipeline still evaluates
+    //   Δ + 0·dt and Φ + TENSION_A·0; both products are +0.0, so the tick
+    //   keeps the additions (they turn -0.0 into +0.0) but drops the
+    //   stimulus loads, the deformation norm and the Update selects.
+    //
+    //   Factor: the stimulus loading[i] * shock[k] is formed per lane with
+    //   the rounding of the materialized event and screened like one
+    //   (lanes with a non-finite or subnormal product go back to the
+    //   caller); every lane is an UPDATE, so no Update selects.
+    // -------------------------------------------------------------------------
+    template <std::size_t N, LaneSource SRC>
+    unsigned stepLanes(
+        const StateColumnsT<N>& X,
+        std::size_t             i,
+        const LaneEventsT<N>*   E,
+        const SharedEvent&      U,
+        unsigned                eligible,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    ) noexcept
+    {
+        constexpr std::size_t LANES = simd::LANES;
+
+        const VecD zero = set1(0.0);
+        const VecD one  = set1(1.0);
+        const VecD col  = set1(static_cast<double>(Regime::COL));
+
+        // === LOAD X(t) ====================================================
+        VecD delta[N];
+        for (std::size_t k = 0; k < N; ++k)
+            delta[k] = load(X.Delta[k] + i);
+
+        const VecD phi   = load(X.Phi + i);
+        const VecD m     = load(X.M + i);
+        const VecD kappa = load(X.Kappa + i);
+
+        alignas(64) double regime_prev[LANES];
+        for (std::size_t l = 0; l < LANES; ++l)
+            regime_prev[l] = static_cast<double>(X.RegimePrev[i + l]);
+
+        const VecD prev = load(regime_prev);
+
+        // === STATE SCREEN (numeric reject + living organism) ==============
+        MaskD accept = numericSafe(phi) & numericSafe(m) & numericSafe(kappa)
+                     & gt(kappa, set1(EPS_KAPPA));
+
+        for (std::size_t k = 0; k < N; ++k)
+            accept = accept & numericSafe(delta[k]);
+
+        // === STIMULUS =====================================================
+        VecD stim[N];
+        if constexpr (SRC == LaneSource::PerLane)
+        {
+            for (std::size_t k = 0; k < N; ++k)
+                stim[k] = load(E->stimulus[k]);
+        }
+        else if constexpr (SRC == LaneSource::Factor)
+        {
+            const VecD beta = load(U.loading + i);
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                stim[k] = mul(beta, set1(U.shock[k]));
+                accept  = accept & numericSafe(stim[k]);
+            }
+        }
+
+        const unsigned handled = eligible & simd::bits(accept);
+        if (handled == 0)
+            return 0;
+
+        const VecD dt = (SRC == LaneSource::PerLane) ? load(E->dt) : set1(U.dt);
+
+        // === PRE-COMPUTE ==================================================
+        const VecD R_prev  = computeCurvature<N>(delta, phi, m, kappa);
+        const VecD mu_prev = computeMu(R_prev);
+        const VecD tau     = computeTau(kappa);
+
+        // === 1) Δ UPDATE ==================================================
+        const VecD max_delta = set1(10.0);
+        const VecD min_delta = set1(-10.0);
+
+        VecD delta_next[N];
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            VecD stim_dt = zero;
+            if constexpr (SRC != LaneSource::Tick)
+                stim_dt = mul(stim[k], dt);
+
+            VecD next = sub(add(delta[k], stim_dt),
+                            mul(mul(set1(LAMBDA_RELAX), delta[k]), dt));
+
+            next = select(gt(next, max_delta), max_delta, next);
+            next = select(lt(next, min_delta), min_delta, next);
+
+            delta_next[k] = next;
+        }
+
+        // === 2) Φ UPDATE ==================================================
+        MaskD update{};
+        VecD  tension = zero;
+
+        if constexpr (SRC != LaneSource::Tick)
+        {
+            VecD deformation = zero;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                const VecD diff = sub(delta_next[k], delta[k]);
+                deformation = add(deformation, mul(diff, diff));
+            }
+            deformation = simd::sqrt(deformation);
+
+            if constexpr (SRC == LaneSource::PerLane)
+            {
+                update      = ne(load(E->update), zero);
+                deformation = select(update, deformation, zero);
+            }
+            tension = mul(set1(TENSION_A), deformation);
+        }
+
+        const VecD phi_local = sub(add(phi, tension), mul(set1(TENSION_B), dt));
+        const VecD phi_next  = select(lt(phi_local, zero), zero, phi_local);
+
+        // === 3) M UPDATE ==================================================
+        VecD m_next = add(m, mul(select(lt(zero, tau), tau, zero), dt));
+        m_next = select(lt(m_next, m), m, m_next);
+
+        // === 4) κ UPDATE ==================================================
+        const VecD R_new  = computeCurvature<N>(delta_next, phi_next, m_next, kappa);
+        const VecD mu_new = computeMu(R_new);
+
+        const VecD a4 = set1(DECAY_A4);
+        VecD D = a4;
+
+        if constexpr (SRC != LaneSource::Tick)
+        {
+            D = add(add(add(mul(set1(DECAY_A1), R_new),
+                            mul(set1(DECAY_A2), phi)),
+                        mul(set1(DECAY_A3), mu_new)),
+                    a4);
+
+            if constexpr (SRC == LaneSource::PerLane)
+                D = select(update, D, a4);
+        }
+
+        VecD kappa_next = sub(kappa, mul(dt, D));
+        kappa_next = select(lt(kappa_next, zero), zero, kappa_next);
+
+        // === METRICS ======================================================
+        VecD det_g = computeDetG(R_new, kappa_next);
+        VecD tau_n = computeTau(kappa_next);
+        VecD mu_n  = mu_new;
+        VecD morph = classifyMorphology(mu_new);
+
+        const MaskD collapse = le(kappa_next, set1(EPS_KAPPA));
+        tau_n = select(collapse, zero, tau_n);
+
+        VecD regime = computeRegime(
+            computeRegime(zero, classifyMorphology(mu_prev), kappa),
+            morph,
+            kappa_next
+        );
+
+        // FINAL COLLAPSE OVERRIDE (processCollapse)
+        kappa_next = select(collapse, zero, kappa_next);
+        det_g      = select(collapse, zero, det_g);
+        tau_n      = select(collapse, zero, tau_n);
+        mu_n       = select(collapse, one, mu_n);
+        morph      = select(collapse, set1(static_cast<double>(MorphologyClass::NearCollapse)), morph);
+        regime     = select(collapse, col, regime);
+
+        // === INVARIANTS ===================================================
+        const MaskD alive = gt(kappa_next, set1(EPS_KAPPA));
+        const MaskD dead  = le(kappa_next, set1(EPS_KAPPA));
+
+        const MaskD inv_memory = finite(m_next) & ge(m_next, m);
+        const MaskD inv_kappa  = finite(kappa_next) & ge(kappa_next, zero);
+        const MaskD inv_metric = (alive & finite(det_g) & gt(det_g, zero))
+                               | (~alive & eq(det_g, zero));
+        const MaskD inv_tau    = finite(tau_n)
+                               & ((alive & gt(tau_n, zero)) | (~alive & eq(tau_n, zero)));
+        const MaskD inv_morph  = finite(mu_n) & ge(mu_n, zero) & le(mu_n, one);
+        const MaskD inv_regime = ge(regime, prev);
+        const MaskD inv_coll   = ~dead
+                               | (eq(det_g, zero) & eq(tau_n, zero) & eq(mu_n, one) & eq(regime, col));
+
+        MaskD state_finite = finite(phi_next) & finite(m_next) & finite(kappa_next);
+        for (std::size_t k = 0; k < N; ++k)
+            state_finite = state_finite & finite(delta_next[k]);
+
+        // collapse_distance / speed / intensity are always 0.0 here
+        const MaskD inv_forbid = state_finite
+                               & finite(R_new) & finite(det_g) & finite(tau_n) & finite(mu_n)
+                               & ge(kappa_next, zero)
+                               & (~alive | (gt(det_g, zero) & gt(tau_n, zero)));
+
+        const MaskD all_ok = inv_memory & inv_kappa & inv_metric & inv_tau
+                           & inv_morph & inv_regime & inv_coll & inv_forbid;
+
+        // === STORE X(t+1) (rejected lanes keep X(t)) ======================
+        const MaskD store_mask = simd::fromBits(handled);
+
+        for (std::size_t k = 0; k < N; ++k)
+            simd::storeMasked(X_next.Delta[k] + i, store_mask, select(all_ok, delta_next[k], delta[k]));
+
+        simd::storeMasked(X_next.Phi + i,   store_mask, select(all_ok, phi_next, phi));
+        simd::storeMasked(X_next.M + i,     store_mask, select(all_ok, m_next, m));
+        simd::storeMasked(X_next.Kappa + i, store_mask, select(all_ok, kappa_next, kappa));
+
+        // === PER-LANE DIAGNOSTICS =========================================
+        alignas(64) double lane_R[LANES];
+        alignas(64) double lane_det[LANES];
+        alignas(64) double lane_tau[LANES];
+        alignas(64) double lane_mu[LANES];
+        alignas(64) double lane_morph[LANES];
+        alignas(64) double lane_regime[LANES];
+
+        simd::store(lane_R, R_new);
+        simd::store(lane_det, det_g);
+        simd::store(lane_tau, tau_n);
+        simd::store(lane_mu, mu_n);
+        simd::store(lane_morph, morph);
+        simd::store(lane_regime, regime);
+
+        const unsigned ok_bits = simd::bits(all_ok);
+        const unsigned collapse_bits = simd::bits(collapse);
+
+        const unsigned check_bits[] = {
+            simd::bits(inv_memory), simd::bits(inv_kappa), simd::bits(inv_metric),
+            simd::bits(inv_tau),    simd::bits(inv_regime), simd::bits(inv_morph),
+            simd::bits(inv_coll),   simd::bits(inv_forbid)
+        };
+        const uint32_t check_flags[] = {
+            INV_MEMORY, INV_KAPPA, INV_METRIC,
+            INV_TAU,    INV_REGIME, INV_MORPHOLOGY,
+            INV_COLLAPSE, INV_FORBIDDEN
+        };
+
+        for (std::size_t l = 0; l < LANES; ++l)
+        {
+            if (!laneSet(handled, l))
+                continue;
+
+            const std::size_t idx = i + l;
+            const bool ok = laneSet(ok_bits, l);
+
+            X_next.RegimePrev[idx] = ok
+                ? static_cast<Regime>(static_cast<int>(lane_regime[l]))
+                : static_cast<Regime>(static_cast<int>(regime_prev[l]));
+
+            if (out.metrics)
+            {
+                DerivedMetrics metrics{};
+                if (ok)
+                {
+                    metrics.curvature_R = lane_R[l];
+                    metrics.det_g       = lane_det[l];
+                    metrics.tau         = lane_tau[l];
+                    metrics.mu          = lane_mu[l];
+                    metrics.morph_class = static_cast<MorphologyClass>(static_cast<int>(lane_morph[l]));
+                    metrics.regime      = static_cast<Regime>(static_cast<int>(lane_regime[l]));
+                    metrics.is_collapse = laneSet(collapse_bits, l);
+                }
+                out.metrics[idx] = metrics;
+            }
+
+            if (out.invariants)
+            {
+                InvariantStatus st{};
+                st.clear();
+                for (std::size_t c = 0; c < sizeof(check_flags) / sizeof(check_flags[0]); ++c)
+                    if (laneSet(check_bits[c], l))
+                        st.set(check_flags[c]);
+
+                st.all_ok = ok;
+                out.invariants[idx] = st;
+            }
+
+            if (out.status)
+                out.status[idx] = ok ? StepStatus::OK : StepStatus::ERROR;
+
+            if (out.error_category)
+                out.error_category[idx] = ok ? ErrorCategory::None : ErrorCategory::InvariantViolation;
+        }
+
+        return handled;
+    }
+} // namespace
+
+template <std::size_t N>
+unsigned BatchKernel::step(
+    const StateColumnsT<N>& X,
+    std::size_t             i,
+    const LaneEventsT<N>&   E,
+    unsigned                eligible,
+    const StateColumnsT<N>& X_next,
+    const EnvelopeColumns&  out
+) const noexcept
+{
+    return stepLanes<N, LaneSource::PerLane>(X, i, &E, SharedEvent{}, eligible, X_next, out);
+}
+
+template <std::size_t N>
+unsigned BatchKernel::tick(
+    const StateColumnsT<N>& X,
+    std::size_t             i,
+    double                  dt,
+    unsigned                eligible,
+    const StateColumnsT<N>& X_next,
+    const EnvelopeColumns&  out
+) const noexcept
+{
+    SharedEvent U;
+    U.dt = dt;
+    return stepLanes<N, LaneSource::Tick>(X, i, nullptr, U, eligible, X_next, out);
+}
+
+template <std::size_t N>
+unsigned BatchKernel::factor(
+    const StateColumnsT<N>& X,
+    std::size_t             i,
+    double                  dt,
+    const double*           shock,
+    const double*           loading,
+    unsigned                eligible,
+    const StateColumnsT<N>& X_next,
+    const EnvelopeColumns&  out
+) const noexcept
+{
+    SharedEvent U;
+    U.dt      = dt;
+    U.shock   = shock;
+    U.loading = loading;
+    return stepLanes<N, LaneSource::Factor>(X, i, nullptr, U, eligible, X_next, out);
+}
+
+#define FMRT_INSTANTIATE_KERNEL(N)                                          \
+    template unsigned BatchKernel::step<N>(                                 \
+        const StateColumnsT<N>&, std::size_t, const LaneEventsT<N>&,        \
+        unsigned, const StateColumnsT<N>&, const EnvelopeColumns&) const noexcept; \
+    template unsigned BatchKernel::tick<N>(                                 \
+        const StateColumnsT<N>&, std::size_t, double,                       \
+        unsigned, const StateColumnsT<N>&, const EnvelopeColumns&) const noexcept; \
+    template unsigned BatchKernel::factor<N>(                               \
+        const StateColumnsT<N>&, std::size_t, double, const double*,        \
+        const double*, unsigned, const StateColumnsT<N>&,                   \
+        const EnvelopeColumns&) const noexcept;
+
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_KERNEL)
+#undef FMRT_INSTANTIATE_KERNEL
+
+} // namespace fmrt
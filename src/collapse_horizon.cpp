@@ -0,0 +1,251 @@
+//
+// FMRT Core V2.2
+// collapse_horizon.cpp
+//
+// Steps until κ crosses EPS_KAPPA for a repeated event.
+//
+// GAP / HEARTBEAT:
+//   κ_{j+1} = max(0, fl(κ_j − fl(dt·A4))) does not depend on Δ, Φ or M,
+//   so the horizon is exact. BinadeRun (binade_run.hpp) covers each binade
+//   of κ in O(1); the cost is the number of binades crossed.
+//
+// UPDATE (constant stimulus):
+//   κ_{j+1} = κ_j − dt·D_j,  D_j = A1·R_j + A2·Φ_j + A3·μ(R_j) + A4
+//   with R_j the curvature after the Δ / Φ / M update of step j.
+//   Along the run
+//     |Δ_i|        ≤ min(MAX_DELTA, max(|δ_i|, |s_i| / λ))   (λ·dt ≤ 1)
+//     Φ_j          ≤ Φ_0 + j·max(0, A·g − B·dt)   (g bounds |Δ_{j+1} − Δ_j|)
+//     M_{j+1}      ∈ M_0 + (j+1)·dt·[τ(κ_0), TAU_MIN + TAU_SCALE]
+//     M / (1 + κ)  ∈ [M / (1 + κ_0), M]
+//   which give D_j ≤ D_hi(j) and D_j ≥ D_lo(j) (Φ, |Δ| ≥ 0), both monotone
+//   in j. Σ D_hi reaching κ_0 − EPS_KAPPA bounds the collapse step from
+//   below, Σ D_lo from above. Rounding of the scalar steps is covered by a
+//   relative slack of 16·J·2^-53 plus J ulps of κ_0.
+//
+
+#include "internal/evolution_engine.hpp"
+#include "internal/binade_run.hpp"
+#include "internal/unroll.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fmrt
+{
+    namespace
+    {
+        constexpr double U_ROUND = 0x1p-53;
+
+        // longest run the bounds are evaluated for (slack stays below 1/2)
+        constexpr std::uint64_t MAX_BOUND_STEPS = std::uint64_t{1} << 47;
+
+        // smallest J in [1, MAX_BOUND_STEPS] with reached(J); NEVER if none
+        template <class F>
+        inline std::uint64_t firstReached(F&& reached) noexcept
+        {
+            if (!reached(MAX_BOUND_STEPS))
+                return CollapseHorizon::NEVER;
+
+            std::uint64_t hi = 1;
+            while (!reached(hi))
+                hi <<= 1;
+
+            std::uint64_t lo = hi >> 1;             // reached(lo) fails (or lo == 0)
+            while (hi - lo > 1)
+            {
+                const std::uint64_t mid = lo + (hi - lo) / 2;
+                if (reached(mid)) hi = mid; else lo = mid;
+            }
+            return hi;
+        }
+    } // namespace
+
+template <std::size_t N>
+void EvolutionEngineT<N>::collapseHorizon(
+    const StructuralStateT<N>& X,
+    const StructEventT<N>&    E,
+    CollapseHorizon&      out
+) const noexcept
+{
+    out.exact     = false;
+    out.steps_min = 0;
+    out.steps_max = 0;
+
+    if (!(X.Kappa > EPS_KAPPA))
+    {
+        out.exact = true;                       // already collapsed
+        return;
+    }
+
+    if (E.type == EventType::Reset || !(E.dt > 0.0))
+    {
+        out.exact     = true;
+        out.steps_min = out.steps_max = CollapseHorizon::NEVER;
+        return;
+    }
+
+    const double dt = E.dt;
+
+    // === GAP / HEARTBEAT: exact ===========================================
+    if (E.type != EventType::Update)
+    {
+        const double c = dt * DECAY_A4;         // same rounding as updateKappa
+
+        std::uint64_t steps = 0;
+        double        k     = X.Kappa;
+
+        out.exact = true;
+        out.steps_min = out.steps_max = CollapseHorizon::NEVER;
+
+        while (k > EPS_KAPPA)
+        {
+            const BinadeRun run = makeBinadeRun(k, c);
+
+            if (run.length == 0)
+            {
+                // step leaves the binade: plain scalar step
+                double next = k - c;
+                if (next < 0.0) next = 0.0;
+
+                if (next == k)
+                    return;                     // κ stalls above EPS_KAPPA
+                k = next;
+                ++steps;
+                continue;
+            }
+
+            if (run.length == binade::UNBOUNDED)
+            {
+                if (!(run.value(1) <= EPS_KAPPA))
+                    return;                     // κ stalls after one step
+                ++steps;
+                break;
+            }
+
+            if (run.value(run.length) > EPS_KAPPA)
+            {
+                k      = run.value(run.length);
+                steps += run.length;
+                continue;
+            }
+
+            // first j in the run with κ_j <= EPS_KAPPA
+            std::uint64_t lo = 0, hi = run.length;
+            while (hi - lo > 1)
+            {
+                const std::uint64_t mid = lo + (hi - lo) / 2;
+                if (run.value(mid) <= EPS_KAPPA) hi = mid; else lo = mid;
+            }
+            steps += hi;
+            break;
+        }
+
+        out.steps_min = out.steps_max = steps;
+        return;
+    }
+
+    // === UPDATE: bounds ===================================================
+    const double kappa0 = X.Kappa;
+    const double target = kappa0 - EPS_KAPPA;
+    const double ldt    = LAMBDA_RELAX * dt;
+
+    bool outside = false;
+    forEachIndex<N>([&](std::size_t i) { outside |= !(std::fabs(X.Delta[i]) <= MAX_DELTA); });
+
+    double norm2_hi = 0.0;      // ‖Δ_{j+1}‖²
+    double dev2_hi  = 0.0;      // ‖Δ_{j+1} − Δ_j‖²
+    forEachIndex<N>([&](std::size_t i)
+    {
+        const double s  = std::fabs(E.stimulus[i]);
+        const double d0 = std::fabs(X.Delta[i]);
+
+        // Δ_{j+1} = (1 − λdt)·Δ_j + λdt·(s / λ), clipped
+        const double b  = (ldt <= 1.0)
+                        ? std::min(MAX_DELTA, std::max(d0, s / LAMBDA_RELAX))
+                        : MAX_DELTA;
+        const double in = std::max(d0, b);      // |Δ_j| entering any step
+
+        // clipping only shortens the step when the input is inside the box
+        const double g  = outside ? b + in
+                                  : std::min(b + in, dt * (s + LAMBDA_RELAX * in));
+
+        norm2_hi += b * b;
+        dev2_hi  += g * g;
+    });
+
+    const double phi_rate = std::max(0.0, TENSION_A * std::sqrt(dev2_hi) - TENSION_B * dt);
+    const double tau_hi   = TAU_MIN + TAU_SCALE;
+    const double tau_lo   = computeTau(kappa0);
+
+    // R_hi(j) = r0 + r1·(j+1),  R_lo(j) = p0 + p1·(j+1)
+    const double r0 = CURV_A1 * norm2_hi + CURV_A2 * X.Phi + CURV_A3 * X.M;
+    const double r1 = CURV_A2 * phi_rate + CURV_A3 * dt * tau_hi;
+    const double p0 = CURV_A3 * X.M / (1.0 + kappa0);
+    const double p1 = CURV_A3 * dt * tau_lo / (1.0 + kappa0);
+
+    // Σ_{j<J} (j+1) and Σ_{j<J} j
+    auto tri1 = [](double J) noexcept { return 0.5 * J * (J + 1.0); };
+    auto tri0 = [](double J) noexcept { return 0.5 * J * (J - 1.0); };
+
+    // μ is monotone in R: split the run at h = J/2 and bound each half
+    // by the μ at its far (upper sum) or near (lower sum) end
+    auto sum_hi = [&](std::uint64_t J) noexcept
+    {
+        const double Jd = static_cast<double>(J);
+        const double h  = static_cast<double>(J / 2);
+
+        const double mu_sum = h * computeMu(r0 + r1 * h)
+                            + (Jd - h) * computeMu(r0 + r1 * Jd);
+
+        return DECAY_A1 * (Jd * r0 + r1 * tri1(Jd))
+             + DECAY_A2 * (Jd * X.Phi + phi_rate * tri0(Jd))
+             + DECAY_A3 * mu_sum
+             + DECAY_A4 * Jd;
+    };
+
+    auto sum_lo = [&](std::uint64_t J) noexcept
+    {
+        const double Jd = static_cast<double>(J);
+        const double h  = static_cast<double>(J / 2);
+
+        const double mu_sum = std::max(Jd * computeMu(p0 + p1),
+                                       (Jd - h) * computeMu(p0 + p1 * (h + 1.0)));
+
+        return DECAY_A1 * (Jd * p0 + p1 * tri1(Jd))
+             + DECAY_A3 * mu_sum
+             + DECAY_A4 * Jd;
+    };
+
+    auto slack = [&](std::uint64_t J) noexcept
+    {
+        return 16.0 * static_cast<double>(J) * U_ROUND;
+    };
+
+    // κ_J ≥ κ_0 − dt·Σ D_hi − rounding:  collapse needs this ≤ EPS_KAPPA
+    out.steps_min = firstReached([&](std::uint64_t J) noexcept
+    {
+        const double used = dt * sum_hi(J) * (1.0 + slack(J))
+                          + static_cast<double>(J) * kappa0 * 2.0 * U_ROUND;
+        return used >= target;
+    });
+
+    // κ_J ≤ κ_0 − dt·Σ D_lo + rounding:  collapse guaranteed once ≤ EPS_KAPPA
+    out.steps_max = firstReached([&](std::uint64_t J) noexcept
+    {
+        const double used = dt * sum_lo(J) * (1.0 - slack(J))
+                          - static_cast<double>(J) * kappa0 * 2.0 * U_ROUND;
+        return used >= target;
+    });
+
+    out.steps_min = std::min(out.steps_min, out.steps_max);
+}
+
+#define FMRT_INSTANTIATE_COLLAPSE_HORIZON(N)                                \
+    template void EvolutionEngineT<N>::collapseHorizon(                     \
+        const StructuralStateT<N>&, const StructEventT<N>&,                 \
+        CollapseHorizon&) const noexcept;
+
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_COLLAPSE_HORIZON)
+#undef FMRT_INSTANTIATE_COLLAPSE_HORIZON
+
+} // namespace fmrt
@@ -3,53 +3,40 @@
 namespace fmrt
 {
 
-bool EventHandler::validate(const StructEvent& E, StateEnvelope& out_env) const noexcept
+template <std::size_t N>
+ErrorCategory EventHandlerT<N>::check(const StructEventT<N>& E) const noexcept
 {
     // ---------------------------------------------------------------------
-    // RESET bypasses all stimulus checks. Only dt must be finite.
+    // Finite check (RESET: only dt must be finite)
     // ---------------------------------------------------------------------
-    if (E.type == EventType::Reset)
-    {
-        if (!is_finite(E.dt))
-        {
-            out_env.status = StepStatus::ERROR;
-            out_env.error_category = ErrorCategory::InvalidEvent;
-            out_env.error_reason = ERR_INVALID_EVENT;
-            return false;
-        }
-
-        return true; // RESET always valid
-    }
+    if (!E.isFinite())
+        return ErrorCategory::InvalidEvent;
 
+    return checkScreened(E);
+}
+
+template <std::size_t N>
+ErrorCategory EventHandlerT<N>::checkScreened(const StructEventT<N>& E) const noexcept
+{
     // ---------------------------------------------------------------------
-    // 1) Finite check for UPDATE / GAP / HEARTBEAT
+    // RESET bypasses all stimulus checks.
     // ---------------------------------------------------------------------
-    if (!E.isFinite())
-    {
-        out_env.status = StepStatus::ERROR;
-        out_env.error_category = ErrorCategory::InvalidEvent;
-        out_env.error_reason = ERR_INVALID_EVENT;
-        return false;
-    }
+    if (E.type == EventType::Reset)
+        return ErrorCategory::None; // RESET always valid
 
     // ---------------------------------------------------------------------
-    // 2) dt rules
+    // 1) dt rules
     // ---------------------------------------------------------------------
     if (!E.hasValidDt())
-    {
-        out_env.status = StepStatus::ERROR;
-        out_env.error_category = ErrorCategory::InvalidEvent;
-        out_env.error_reason = ERR_INVALID_EVENT;
-        return false;
-    }
+        return ErrorCategory::InvalidEvent;
 
     // ---------------------------------------------------------------------
-    // 3) Event semantics
+    // 2) Event semantics
     // ---------------------------------------------------------------------
     switch (E.type)
     {
         case EventType::Update:
-            // stimulus already validated by isFinite()
+            // stimulus already checked for finiteness
             break;
 
         case EventType::Gap:
@@ -58,16 +45,27 @@ bool EventHandler::validate(const StructEvent& E, StateEnvelope& out_env) const
             break;
 
         default:
-            out_env.status = StepStatus::ERROR;
-            out_env.error_category = ErrorCategory::UnsupportedOperation;
-            out_env.error_reason = ERR_UNSUPPORTED;
-            return false;
+            return ErrorCategory::UnsupportedOperation;
     }
 
-    return true;
+    return ErrorCategory::None;
 }
 
-void EventHandler::canonicalize(StructEvent& E) const noexcept
+template <std::size_t N>
+bool EventHandlerT<N>::validate(const StructEventT<N>& E, StateEnvelopeT<N>& out_env) const noexcept
+{
+    const ErrorCategory cat = check(E);
+    if (cat == ErrorCategory::None)
+        return true;
+
+    out_env.status         = StepStatus::ERROR;
+    out_env.error_category = cat;
+    out_env.error_reason   = errorCategoryToString(cat);
+    return false;
+}
+
+template <std::size_t N>
+void EventHandlerT<N>::canonicalize(StructEventT<N>& E) const noexcept
 {
     // GAP & HEARTBEAT → zero stimulus
     if (E.type == EventType::Gap || E.type == EventType::Heartbeat)
@@ -88,4 +86,8 @@ void EventHandler::canonicalize(StructEvent& E) const noexcept
     if (E.dt > 1e6)  E.dt = 1e6;
 }
 
+#define FMRT_INSTANTIATE_HANDLER(N) template class EventHandlerT<N>;
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_HANDLER)
+#undef FMRT_INSTANTIATE_HANDLER
+
 } // namespace fmrt
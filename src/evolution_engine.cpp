@@ -1,4 +1,6 @@
 #include "internal/evolution_engine.hpp"
+#include "internal/unroll.hpp"
+#include "internal/det_exp.hpp"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -9,11 +11,13 @@ namespace fmrt
 // ============================================================================
 // evolve — Main FMT 3.1 / FMRT V2.2 update step
 // ============================================================================
-void EvolutionEngine::evolve(
-    const StructuralState& X,
-    const StructEvent&    E,
-    StructuralState&      out,
-    DerivedMetrics&       M
+template <std::size_t N>
+void EvolutionEngineT<N>::evolve(
+    const StructuralStateT<N>& X,
+    const StructEventT<N>&    E,
+    StructuralStateT<N>&      out,
+    DerivedMetrics&       M,
+    CarriedMetricsT<N>*   carry
 ) const noexcept
 {
     out = X;     // start from current state
@@ -30,6 +34,7 @@ void EvolutionEngine::evolve(
         M.morph_class = MorphologyClass::Elastic;
         M.regime      = Regime::ACC;
         M.is_collapse = false;
+        if (carry) carry->invalidate();
         return;
     }
 
@@ -39,6 +44,7 @@ if (out.Kappa <= EPS_KAPPA)
 {
     processCollapse(out, M);
     out.RegimePrev = M.regime;   // <-- ДОБАВИТЬ
+    if (carry) carry->invalidate();
     return;
 }
 
@@ -46,10 +52,11 @@ if (out.Kappa <= EPS_KAPPA)
 out.RegimePrev = M.regime;       // <-- ДОБАВИТЬ
 
 
-    // === PRE-COMPUTE ======================================================
-    const double R_prev  = computeCurvature(X);
-    const double mu_prev = computeMu(R_prev);
-    const double tau     = computeTau(X.Kappa);
+    // === PRE-COMPUTE (carried from the previous step when valid) ==========
+    const bool   carried = carry && carry->matches(X);
+    const double R_prev  = carried ? carry->curvature_R : computeCurvature(X);
+    const double mu_prev = carried ? carry->mu          : computeMu(R_prev);
+    const double tau     = carried ? carry->tau         : computeTau(X.Kappa);
 
     // === 1) Δ UPDATE ======================================================
     updateDelta(X, E, mu_prev, out);
@@ -61,7 +68,8 @@ out.RegimePrev = M.regime;       // <-- ДОБАВИТЬ
     updateMemory(X, tau, E, out);
 
     // === 4) κ UPDATE ======================================================
-    const double R_new  = computeCurvature(out);
+    const double norm2  = deltaNorm2(out);
+    const double R_new  = curvatureFrom(norm2, out);
     const double mu_new = computeMu(R_new);
 
     updateKappa(X, R_new, mu_new, E, out);
@@ -85,6 +93,24 @@ M.regime = computeRegime(
     out.Kappa
 );
 
+// === CARRY =============================================================
+// R_new was taken before κ moved: only the memory term of R(X(t+1))
+// differs, and τ(κ_next) is M.tau
+if (carry)
+{
+    if (out.Kappa <= EPS_KAPPA)
+    {
+        carry->invalidate();
+    }
+    else
+    {
+        carry->curvature_R = curvatureFrom(norm2, out);
+        carry->mu          = computeMu(carry->curvature_R);
+        carry->tau         = M.tau;
+        carry->bind(out);
+    }
+}
+
 // FINAL COLLAPSE OVERRIDE
 if (out.Kappa <= EPS_KAPPA)
     processCollapse(out, M);
@@ -94,17 +120,17 @@ if (out.Kappa <= EPS_KAPPA)
 // ============================================================================
 // Δ update — FLEXION DIFFERENTIATION EQUATION (FDE)
 // ============================================================================
-void EvolutionEngine::updateDelta(
-    const StructuralState& X,
-    const StructEvent&    E,
+template <std::size_t N>
+void EvolutionEngineT<N>::updateDelta(
+    const StructuralStateT<N>& X,
+    const StructEventT<N>&    E,
     double                mu,
-    StructuralState&      out
+    StructuralStateT<N>&      out
 ) const noexcept
 {
     const double dt = E.dt;
-    constexpr double MAX_DELTA = 10.0; // жёсткий предел деформации
 
-    for (size_t i = 0; i < DELTA_DIM; ++i)
+    forEachIndex<N>([&](std::size_t i)
     {
         const double δ    = X.Delta[i];
         const double stim = (E.type == EventType::Update) ? E.stimulus[i] : 0.0;
@@ -118,18 +144,19 @@ void EvolutionEngine::updateDelta(
         if (next < -MAX_DELTA) next = -MAX_DELTA;
 
         out.Delta[i] = next;
-    }
+    });
 }
 
 
 // ============================================================================
 // Φ update — deformation-driven tension
 // ============================================================================
-void EvolutionEngine::updatePhi(
-    const StructuralState& X,
-    const StructEvent& E,
-    const StructuralState& X_next,
-    StructuralState& out
+template <std::size_t N>
+void EvolutionEngineT<N>::updatePhi(
+    const StructuralStateT<N>& X,
+    const StructEventT<N>& E,
+    const StructuralStateT<N>& X_next,
+    StructuralStateT<N>& out
 ) const noexcept
 {
     const double dt = E.dt;
@@ -138,11 +165,11 @@ void EvolutionEngine::updatePhi(
     // Вычисляем модуль деформации Δ_next - Δ
     if (E.type == EventType::Update)
     {
-        for (size_t i = 0; i < DELTA_DIM; ++i)
+        forEachIndex<N>([&](std::size_t i)
         {
             const double diff = X_next.Delta[i] - X.Delta[i];
             deformation += diff * diff;
-        }
+        });
         deformation = std::sqrt(deformation);
     }
 
@@ -160,11 +187,12 @@ void EvolutionEngine::updatePhi(
 // ============================================================================
 // M update — τ-weighted accumulation
 // ============================================================================
-void EvolutionEngine::updateMemory(
-    const StructuralState& X,
+template <std::size_t N>
+void EvolutionEngineT<N>::updateMemory(
+    const StructuralStateT<N>& X,
     double                 tau,
-    const StructEvent&     E,
-    StructuralState&       out
+    const StructEventT<N>&     E,
+    StructuralStateT<N>&       out
 ) const noexcept
 {
     if (E.type == EventType::Reset)
@@ -182,12 +210,13 @@ void EvolutionEngine::updateMemory(
 // ============================================================================
 // κ update — viability decay equation
 // ============================================================================
-void EvolutionEngine::updateKappa(
-    const StructuralState& X,
+template <std::size_t N>
+void EvolutionEngineT<N>::updateKappa(
+    const StructuralStateT<N>& X,
     double                 R,
     double                 mu,
-    const StructEvent&     E,
-    StructuralState&       out
+    const StructEventT<N>&     E,
+    StructuralStateT<N>&       out
 ) const noexcept
 {
     if (E.type == EventType::Reset)
@@ -220,11 +249,23 @@ out.Kappa = (κ < 0.0 ? 0.0 : κ);
 // ============================================================================
 // METRICS
 // ============================================================================
-double EvolutionEngine::computeCurvature(const StructuralState& X) const noexcept
+template <std::size_t N>
+double EvolutionEngineT<N>::computeCurvature(const StructuralStateT<N>& X) const noexcept
+{
+    return curvatureFrom(deltaNorm2(X), X);
+}
+
+template <std::size_t N>
+double EvolutionEngineT<N>::deltaNorm2(const StructuralStateT<N>& X) const noexcept
 {
     double norm2 = 0.0;
-    for (double v : X.Delta) norm2 += v * v;
+    forEachIndex<N>([&](std::size_t i) { norm2 += X.Delta[i] * X.Delta[i]; });
+    return norm2;
+}
 
+template <std::size_t N>
+double EvolutionEngineT<N>::curvatureFrom(double norm2, const StructuralStateT<N>& X) const noexcept
+{
     const double denom = 1.0 + X.Kappa;
     const double mem   = X.M / denom;
 
@@ -233,25 +274,28 @@ double EvolutionEngine::computeCurvature(const StructuralState& X) const noexcep
          + CURV_A3 * mem;
 }
 
-double EvolutionEngine::computeDetG(double R, double kappa) const noexcept
+template <std::size_t N>
+double EvolutionEngineT<N>::computeDetG(double R, double kappa) const noexcept
 {
     if (kappa <= 0.0) return 0.0;
 
-    const double raw = METRIC_C1 * std::exp(-METRIC_C2 * R) * kappa;
+    const double raw = METRIC_C1 * engineExp(-METRIC_C2 * R) * kappa;
 
     if (raw <= 0.0) return EPS_METRIC;
     return std::max(raw, EPS_METRIC);
 }
 
-double EvolutionEngine::computeTau(double kappa) const noexcept
+template <std::size_t N>
+double EvolutionEngineT<N>::computeTau(double kappa) const noexcept
 {
     if (kappa <= 0.0) return 0.0;
 
-    const double tau = TAU_MIN + TAU_SCALE * std::exp(-LAMBDA_K * kappa);
+    const double tau = TAU_MIN + TAU_SCALE * engineExp(-LAMBDA_K * kappa);
     return (tau < TAU_MIN ? TAU_MIN : tau);
 }
 
-double EvolutionEngine::computeMu(double R) const noexcept
+template <std::size_t N>
+double EvolutionEngineT<N>::computeMu(double R) const noexcept
 {
     if (R <= 0.0) return 0.0;
 
@@ -262,7 +306,8 @@ double EvolutionEngine::computeMu(double R) const noexcept
     return std::min(std::max(raw, 0.0), 1.0);
 }
 
-MorphologyClass EvolutionEngine::classifyMorphology(double mu) const noexcept
+template <std::size_t N>
+MorphologyClass EvolutionEngineT<N>::classifyMorphology(double mu) const noexcept
 {
     if (mu < 0.25) return MorphologyClass::Elastic;
     if (mu < 0.50) return MorphologyClass::Plastic;
@@ -270,7 +315,8 @@ MorphologyClass EvolutionEngine::classifyMorphology(double mu) const noexcept
     return MorphologyClass::NearCollapse;
 }
 
-Regime EvolutionEngine::computeRegime(
+template <std::size_t N>
+Regime EvolutionEngineT<N>::computeRegime(
     Regime previous,
     MorphologyClass mc,
     double kappa
@@ -310,8 +356,9 @@ Regime EvolutionEngine::computeRegime(
 
 
 
-void EvolutionEngine::processCollapse(
-    StructuralState& X,
+template <std::size_t N>
+void EvolutionEngineT<N>::processCollapse(
+    StructuralStateT<N>& X,
     DerivedMetrics&  M
 ) const noexcept
 {
@@ -326,4 +373,11 @@ void EvolutionEngine::processCollapse(
     M.regime      = Regime::COL;
 }
 
+// ============================================================================
+// Explicit instantiations (one per supported Δ-dimension)
+// ============================================================================
+#define FMRT_INSTANTIATE_ENGINE(N) template class EvolutionEngineT<N>;
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_ENGINE)
+#undef FMRT_INSTANTIATE_ENGINE
+
 } // namespace fmrt
@@ -0,0 +1,210 @@
+//
+// FMRT Core V2.2
+// fast_forward.cpp
+//
+// Closed-form evolution for runs of identical GAP / HEARTBEAT events.
+//
+// Without stimulus the update rules of evolution_engine.cpp reduce to
+//   Δ_{j+1} = Δ_j − λ·Δ_j·dt          (geometric decay, q = 1 − λ·dt)
+//   Φ_{j+1} = max(0, Φ_j − B·dt)      (linear)
+//   κ_{j+1} = max(0, κ_j − A4·dt)     (linear)
+//   M_{j+1} = M_j + τ(κ_j)·dt         (τ summed over the κ progression)
+//
+// κ and Φ are reproduced bit for bit (BinadeRun, binade_run.hpp).
+// Δ and M use pow / expm1 and carry only the rounding of the closed
+// form (relative error ~ j·2^-52).
+//
+// A run stops before any discrete event of the scalar pipeline: binade
+// change of κ or Φ, κ ≤ EPS_KAPPA, Φ floor, Δ clipping, subnormal Δ or
+// a change of the regime candidate. The caller takes a scalar step there.
+//
+
+#include "internal/evolution_engine.hpp"
+#include "internal/binade_run.hpp"
+#include "internal/unroll.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace fmrt
+{
+    namespace
+    {
+        // shortest run worth a closed-form jump
+        constexpr std::uint64_t MIN_JUMP = 2;
+
+        // relative slack for the closed-form (approximate) quantities
+        constexpr double MARGIN = 1e-6;
+
+        // Σ_{j<J} exp(−L·κ_j) for κ_j linear from κ_0 to κ_J (exclusive)
+        inline double sumDecay(double k0, double kJ, std::uint64_t J) noexcept
+        {
+            const double Jd = static_cast<double>(J);
+            const double e0 = std::exp(-LAMBDA_K * k0);
+            const double r  = (k0 - kJ) / Jd;
+
+            if (!(r > 0.0))
+                return Jd * e0;
+
+            const double lr = LAMBDA_K * r;
+            if (lr * Jd < 700.0)
+                return e0 * std::expm1(lr * Jd) / std::expm1(lr);
+
+            return (std::exp(-LAMBDA_K * kJ) - e0) / std::expm1(lr);
+        }
+    } // namespace
+
+template <std::size_t N>
+std::uint64_t EvolutionEngineT<N>::fastForward(
+    const StructuralStateT<N>& X,
+    const StructEventT<N>&    E,
+    std::uint64_t         max_steps,
+    StructuralStateT<N>&      out
+) const noexcept
+{
+    if (max_steps < MIN_JUMP)
+        return 0;
+
+    if (E.type != EventType::Gap && E.type != EventType::Heartbeat)
+        return 0;
+
+    if (!(X.Kappa > EPS_KAPPA))
+        return 0;
+
+    // === Δ: geometric decay, no clipping ==================================
+    const double dt  = E.dt;
+    const double ldt = LAMBDA_RELAX * dt;
+    const double q   = 1.0 - ldt;
+
+    if (!(q > -1.0 && q < 1.0) || q == 0.0)
+        return 0;
+
+    bool clip = false;
+    forEachIndex<N>([&](std::size_t i) { clip |= !(std::fabs(X.Delta[i]) <= MAX_DELTA); });
+    if (clip)
+        return 0;
+
+    // |q|^J = exp(J·log|q|), sign alternates for q < 0
+    const double log_q = (q > 0.0) ? std::log1p(-ldt) : std::log(ldt - 1.0);
+
+    auto deltaScale = [&](std::uint64_t J) noexcept
+    {
+        const double s = std::exp(static_cast<double>(J) * log_q);
+        return (q < 0.0 && (J & 1u)) ? -s : s;
+    };
+
+    // === κ and Φ: exact runs inside the current binade ====================
+    const BinadeRun kappa_run = makeBinadeRun(X.Kappa, dt * DECAY_A4);
+
+    std::uint64_t limit = std::min(max_steps, kappa_run.length);
+
+    BinadeRun phi_run;
+    const bool phi_zero = (X.Phi == 0.0);
+    if (!phi_zero)
+    {
+        phi_run = makeBinadeRun(X.Phi, TENSION_B * dt);
+        limit   = std::min(limit, phi_run.length);
+    }
+
+    if (limit < MIN_JUMP)
+        return 0;
+
+    // === State after J steps ==============================================
+    auto advance = [&](std::uint64_t J, StructuralStateT<N>& Y) noexcept
+    {
+        const double s = deltaScale(J);
+        forEachIndex<N>([&](std::size_t i)
+        {
+            // zero stays +0 (δ + 0·dt normalizes −0)
+            Y.Delta[i] = (X.Delta[i] == 0.0) ? 0.0 : X.Delta[i] * s;
+        });
+
+        Y.Kappa = kappa_run.value(J);
+        Y.Phi   = phi_zero ? 0.0 : phi_run.value(J);
+
+        const double tau_sum =
+            static_cast<double>(J) * TAU_MIN +
+            TAU_SCALE * sumDecay(X.Kappa, Y.Kappa, J);
+
+        Y.M = X.M + tau_sum * dt;
+    };
+
+    auto curvature = [](double norm2, double phi, double m, double kappa) noexcept
+    {
+        return CURV_A1 * norm2 + CURV_A2 * phi + CURV_A3 * (m / (1.0 + kappa));
+    };
+
+    auto candidate = [&](double R) noexcept
+    {
+        return computeRegime(Regime::ACC, classifyMorphology(computeMu(R)), X.Kappa);
+    };
+
+    double norm2_0 = 0.0;
+    forEachIndex<N>([&](std::size_t i) { norm2_0 += X.Delta[i] * X.Delta[i]; });
+
+    const Regime regime = candidate(computeCurvature(X));
+    if ((int)regime < (int)X.RegimePrev)
+        return 0;                               // first step violates INV_REGIME
+
+    // ---------------------------------------------------------------------
+    // ok(J): steps 1..J stay free of discrete events. Every term of R is
+    // monotone (|Δ|, Φ fall; M / (1 + κ) rises), so R over the run lies in
+    // [R_lo, R_hi] built from the run end points.
+    // ---------------------------------------------------------------------
+    StructuralStateT<N> Y = X;
+
+    auto ok = [&](std::uint64_t J) noexcept
+    {
+        advance(J, Y);
+
+        if (!(Y.Kappa > EPS_KAPPA))
+            return false;
+
+        double norm2_J = 0.0;
+        bool   tiny    = false;
+        forEachIndex<N>([&](std::size_t i)
+        {
+            norm2_J += Y.Delta[i] * Y.Delta[i];
+            tiny    |= (X.Delta[i] != 0.0) &&
+                       !(std::fabs(Y.Delta[i]) >= DBL_MIN * (1.0 + MARGIN));
+        });
+        if (tiny)
+            return false;
+
+        const double R_lo = curvature(norm2_J, Y.Phi, X.M, X.Kappa) * (1.0 - MARGIN);
+        const double R_hi = curvature(norm2_0, X.Phi, Y.M, Y.Kappa) * (1.0 + MARGIN);
+
+        return candidate(R_lo) == regime && candidate(R_hi) == regime;
+    };
+
+    // === Longest admissible run (bisection) ===============================
+    std::uint64_t J = limit;
+    if (!ok(J))
+    {
+        std::uint64_t lo = 0, hi = J;          // ok(lo) holds, ok(hi) fails
+        while (hi - lo > 1)
+        {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            if (ok(mid)) lo = mid; else hi = mid;
+        }
+        J = lo;
+    }
+
+    if (J < MIN_JUMP)
+        return 0;
+
+    advance(J, out);
+    out.RegimePrev = regime;
+    return J;
+}
+
+#define FMRT_INSTANTIATE_FAST_FORWARD(N)                                    \
+    template std::uint64_t EvolutionEngineT<N>::fastForward(                \
+        const StructuralStateT<N>&, const StructEventT<N>&, std::uint64_t,  \
+        StructuralStateT<N>&) const noexcept;
+
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_FAST_FORWARD)
+#undef FMRT_INSTANTIATE_FAST_FORWARD
+
+} // namespace fmrt
@@ -10,74 +10,74 @@
 #include "internal/invariant_validator.hpp"
 #include "internal/diagnostics.hpp"
 #include "internal/fp_guard.hpp"
+#include "internal/batch_kernel.hpp"
+#include "internal/stage_profile.hpp"
+
+#include <cstring>      // memcmp
+#include <limits>
 
-#include <cmath>        // fpclassify, FP_SUBNORMAL
 
 namespace fmrt
 {
-    // Статические, stateless модули
-    static const EventHandler       g_event_handler{};
-    static const EvolutionEngine    g_evolution{};
-    static const InvariantValidator g_validator{};
-    static const DiagnosticsLayer   g_diag{};
+    // Статические, stateless модули (one instance per Δ-dimension)
+    template <std::size_t N> static const EventHandlerT<N>       g_event_handler{};
+    template <std::size_t N> static const EvolutionEngineT<N>    g_evolution{};
+    template <std::size_t N> static const InvariantValidatorT<N> g_validator{};
+    template <std::size_t N> static const DiagnosticsLayerT<N>   g_diag{};
     static const FpGuard            g_fp{};
-
-    // ------------------ DENORMAL CHECK HELPERS ------------------
-    inline bool is_denormal(double x)
-    {
-        return x != 0.0 && std::fpclassify(x) == FP_SUBNORMAL;
-    }
-
-    inline bool has_denormal(const StructuralState& X)
-    {
-        for (double v : X.Delta)
-            if (is_denormal(v)) return true;
-
-        return
-            is_denormal(X.Phi)   ||
-            is_denormal(X.M)     ||
-            is_denormal(X.Kappa);
-    }
-
-    inline bool has_denormal(const StructEvent& E)
-    {
-        if (is_denormal(E.dt)) return true;
-
-        for (double v : E.stimulus)
-            if (is_denormal(v)) return true;
-
-        return false;
-    }
-    // ------------------------------------------------------------
-
-    StateEnvelope FMRT_Step(
-        const StructuralState& X,
-        const StructEvent&     E_in
+    static const BatchKernel        g_batch{};
+
+    // carry may be null; a rejected step leaves it keyed to a state other
+    // than env.state, so it is simply not reused
+    template <std::size_t N>
+    static void step_into(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E_in,
+        StateEnvelopeT<N>&         env,
+        CarriedMetricsT<N>*        carry
     )
     {
-        StateEnvelope env{};
+        // X(t) must survive until the invariants are checked
+        if (&X == &env.state)
+        {
+            const StructuralStateT<N> X_copy = X;
+            step_into(X_copy, E_in, env, carry);
+            return;
+        }
+
+        FMRT_STAGE_START();
 
         // ---------------------------------------------------------------------
         // 0) FP-окружение (строгий IEEE-754)
         // ---------------------------------------------------------------------
         if constexpr (ENABLE_FP_GUARDS)
         {
-            if (!g_fp.verifyEnvironment())
+            const bool fp_ok = g_fp.verifyEnvironment();
+            FMRT_STAGE_LAP(PipelineStage::FpGuard);
+
+            if (!fp_ok)
             {
-                env.state          = X;
-                env.status         = StepStatus::ERROR;
-                env.error_category = ErrorCategory::NumericError;
-                env.error_reason   = ERR_NUMERIC_ERROR;
-                env.event_type     = E_in.type;
-                return env;
+                g_diag<N>.buildErrorEnvelope(
+                    X,
+                    DerivedMetrics{},
+                    E_in.type,
+                    ErrorCategory::NumericError,
+                    ERR_NUMERIC_ERROR,
+                    env
+                );
+                env.invariants = InvariantStatus{};
+                FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+                return;
             }
         }
 
         // ---------------------------------------------------------------------
-        // 1) GLOBAL NUMERIC REJECT (NaN / INF / DENORMALS)
+        // 1) GLOBAL NUMERIC REJECT (NaN / INF / DENORMALS), single pass
         // ---------------------------------------------------------------------
-        if (!X.isFinite() || !E_in.isFinite() ||
-            has_denormal(X) || has_denormal(E_in))
+        const bool rejected = FpGuard::numericReject(g_fp.screen(X) | g_fp.screen(E_in), E_in.type);
+        FMRT_STAGE_LAP(PipelineStage::NumericScreen);
+
+        if (rejected)
         {
             env.status         = StepStatus::ERROR;
             env.error_category = ErrorCategory::NumericError;
@@ -90,76 +90,77 @@ namespace fmrt
             env.invariants.all_ok = false;
 
             env.event_type = E_in.type;
-            return env;
+            FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+            return;
         }
 
         // ---------------------------------------------------------------------
         // 2) Локальная копия события
         // ---------------------------------------------------------------------
-        StructEvent E = E_in;
+        StructEventT<N> E = E_in;
 
         // ---------------------------------------------------------------------
-        // 3) Валидация события
+        // 3) Валидация события (finiteness already screened in 1)
         // ---------------------------------------------------------------------
-        if (!g_event_handler.validate(E, env))
+        const ErrorCategory invalid = g_event_handler<N>.checkScreened(E);
+        FMRT_STAGE_LAP(PipelineStage::Validate);
+
+        if (invalid != ErrorCategory::None)
         {
-            env.state      = X;
-            env.metrics    = DerivedMetrics{};
-            env.event_type = E.type;
-            return env;
+            g_diag<N>.buildErrorEnvelope(
+                X,
+                DerivedMetrics{},
+                E.type,
+                invalid,
+                errorCategoryToString(invalid),
+                env
+            );
+            env.invariants = InvariantStatus{};
+            FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+            return;
         }
 
         // ---------------------------------------------------------------------
         // 4) Каноникализация события
         // ---------------------------------------------------------------------
-        g_event_handler.canonicalize(E);
+        g_event_handler<N>.canonicalize(E);
+        FMRT_STAGE_LAP(PipelineStage::Canonicalize);
 
         // ---------------------------------------------------------------------
-        // 5) Эволюция
+        // 5) Эволюция — прямо в конверт вызывающего
         // ---------------------------------------------------------------------
-        StructuralState X_next{};
-        DerivedMetrics  metrics{};
-
-        g_evolution.evolve(X, E, X_next, metrics);
+        g_evolution<N>.evolve(X, E, env.state, env.metrics, carry);
+        FMRT_STAGE_LAP(PipelineStage::Evolve);
 
         // ---------------------------------------------------------------------
         // 5a) RESET — инварианты не проверяются
         // ---------------------------------------------------------------------
         if (E.type == EventType::Reset)
         {
-            X_next.RegimePrev = metrics.regime;
+            env.state.RegimePrev = env.metrics.regime;
 
-            g_diag.buildOkEnvelope(
-                X_next,
-                metrics,
-                E.type,
-                env
-            );
+            g_diag<N>.finishOkEnvelope(E.type, env);
 
-            InvariantStatus st{};
-            st.clear();
-            st.all_ok = true;
-
-            env.invariants = st;
-            return env;
+            env.invariants.clear();
+            env.invariants.all_ok = true;
+            FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+            return;
         }
 
         // ---------------------------------------------------------------------
         // 6) Инварианты
         // ---------------------------------------------------------------------
-        StateEnvelope inv_env{};
-        inv_env.event_type = E.type;
-
-        const bool ok = g_validator.validate(
+        const bool ok = g_validator<N>.validate(
             X,
-            X_next,
-            metrics,
-            inv_env
+            env.state,
+            env.metrics,
+            env.invariants
         );
+        FMRT_STAGE_LAP(PipelineStage::Invariants);
 
         if (!ok)
         {
-            g_diag.buildErrorEnvelope(
+            g_diag<N>.buildErrorEnvelope(
                 X,
                 DerivedMetrics{},
                 E.type,
@@ -167,26 +168,637 @@ namespace fmrt
                 ERR_INVARIANT_VIOLATION,
                 env
             );
-
-            env.invariants = inv_env.invariants;
-            return env;
+            FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+            return;
         }
 
         // ---------------------------------------------------------------------
         // 7) Принятие шага
         // ---------------------------------------------------------------------
-        X_next.RegimePrev = metrics.regime;
+        env.state.RegimePrev = env.metrics.regime;
 
-        g_diag.buildOkEnvelope(
-            X_next,
-            metrics,
-            E.type,
-            env
-        );
+        g_diag<N>.finishOkEnvelope(E.type, env);
+        FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+    }
 
-        env.invariants = inv_env.invariants;
+    template <std::size_t N>
+    void FMRT_StepInto(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E,
+        StateEnvelopeT<N>&         env
+    )
+    {
+        step_into(X, E, env, static_cast<CarriedMetricsT<N>*>(nullptr));
+    }
+
+    template <std::size_t N>
+    void FMRT_StepInto(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E,
+        StateEnvelopeT<N>&         env,
+        CarriedMetricsT<N>&        carry
+    )
+    {
+        step_into(X, E, env, &carry);
+    }
 
+    template <std::size_t N>
+    StateEnvelopeT<N> FMRT_Step(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E
+    )
+    {
+        StateEnvelopeT<N> env;
+        FMRT_StepInto(X, E, env);
         return env;
     }
 
+    template <std::size_t N>
+    static StepStatus step_in_place(
+        StructuralStateT<N>&   X,
+        const StructEventT<N>& E_in,
+        CarriedMetricsT<N>*    carry,
+        DerivedMetrics*        metrics,
+        InvariantStatus*       invariants,
+        ErrorCategory*         error_category
+    )
+    {
+        InvariantStatus st{};
+        ErrorCategory   cat = ErrorCategory::None;
+
+        DerivedMetrics  scratch{};
+        DerivedMetrics& M = metrics ? *metrics : scratch;
+
+        StructEventT<N> E = E_in;
+
+        FMRT_STAGE_START();
+
+        if constexpr (ENABLE_FP_GUARDS)
+        {
+            if (!g_fp.verifyEnvironment())
+                cat = ErrorCategory::NumericError;
+            FMRT_STAGE_LAP(PipelineStage::FpGuard);
+        }
+
+        if (cat == ErrorCategory::None)
+        {
+            if (FpGuard::numericReject(g_fp.screen(X) | g_fp.screen(E_in), E_in.type))
+                cat = ErrorCategory::NumericError;
+            FMRT_STAGE_LAP(PipelineStage::NumericScreen);
+        }
+
+        if (cat == ErrorCategory::None)
+        {
+            cat = g_event_handler<N>.checkScreened(E);
+            FMRT_STAGE_LAP(PipelineStage::Validate);
+        }
+
+        if (cat == ErrorCategory::None)
+        {
+            g_event_handler<N>.canonicalize(E);
+            FMRT_STAGE_LAP(PipelineStage::Canonicalize);
+
+            // X(t) is needed by the validator, so X(t+1) is built beside it
+            StructuralStateT<N> X_next;
+            g_evolution<N>.evolve(X, E, X_next, M, carry);
+            FMRT_STAGE_LAP(PipelineStage::Evolve);
+
+            if (E.type == EventType::Reset)
+            {
+                st.all_ok = true;
+            }
+            else
+            {
+                if (!g_validator<N>.validate(X, X_next, M, st))
+                    cat = ErrorCategory::InvariantViolation;
+                FMRT_STAGE_LAP(PipelineStage::Invariants);
+            }
+
+            if (cat == ErrorCategory::None)
+            {
+                X_next.RegimePrev = M.regime;
+                X = X_next;
+            }
+        }
+
+        // ERROR leaves X untouched; outputs match the FMRT_Step envelope
+        if (cat != ErrorCategory::None)
+            M = DerivedMetrics{};
+
+        if (invariants)     *invariants     = st;
+        if (error_category) *error_category = cat;
+        FMRT_STAGE_LAP(PipelineStage::Diagnostics);
+
+        return (cat == ErrorCategory::None) ? StepStatus::OK : StepStatus::ERROR;
+    }
+
+    template <std::size_t N>
+    StepStatus FMRT_StepInPlace(
+        StructuralStateT<N>&   X,
+        const StructEventT<N>& E,
+        DerivedMetrics*        metrics,
+        InvariantStatus*       invariants,
+        ErrorCategory*         error_category
+    )
+    {
+        return step_in_place(X, E, static_cast<CarriedMetricsT<N>*>(nullptr), metrics, invariants, error_category);
+    }
+
+    template <std::size_t N>
+    StepStatus FMRT_StepInPlace(
+        StructuralStateT<N>&   X,
+        const StructEventT<N>& E,
+        CarriedMetricsT<N>&    carry,
+        DerivedMetrics*        metrics,
+        InvariantStatus*       invariants,
+        ErrorCategory*         error_category
+    )
+    {
+        return step_in_place(X, E, &carry, metrics, invariants, error_category);
+    }
+
+    // ------------------ FAST-FORWARD HELPERS ------------------
+    template <std::size_t N>
+    static bool same_state_bits(const StructuralStateT<N>& a, const StructuralStateT<N>& b)
+    {
+        // bitwise: a run stops only at a true fixed point (0.0 vs −0.0 differ)
+        return std::memcmp(a.Delta.data(), b.Delta.data(), sizeof(double) * N) == 0 &&
+               std::memcmp(&a.Phi,   &b.Phi,   sizeof(double)) == 0 &&
+               std::memcmp(&a.M,     &b.M,     sizeof(double)) == 0 &&
+               std::memcmp(&a.Kappa, &b.Kappa, sizeof(double)) == 0 &&
+               a.RegimePrev == b.RegimePrev;
+    }
+    // ------------------------------------------------------------
+
+    template <std::size_t N>
+    StateEnvelopeT<N> FMRT_FastForward(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E,
+        std::uint64_t              k
+    )
+    {
+        StateEnvelopeT<N> env;
+
+        if (k == 0)
+        {
+            g_diag<N>.buildErrorEnvelope(
+                X, DerivedMetrics{}, E.type,
+                ErrorCategory::InvalidEvent, ERR_INVALID_EVENT, env);
+            env.invariants = InvariantStatus{};
+            return env;
+        }
+
+        // Closed-form runs only for valid GAP / HEARTBEAT in a sane FP
+        // environment; anything else is plain scalar stepping.
+        StructEventT<N> E_canon = E;
+        bool closed_form =
+            (E.type == EventType::Gap || E.type == EventType::Heartbeat) &&
+            (!ENABLE_FP_GUARDS || g_fp.verifyEnvironment()) &&
+            !FpGuard::numericReject(g_fp.screen(E), E.type) &&
+            g_event_handler<N>.checkScreened(E) == ErrorCategory::None;
+
+        if (closed_form)
+            g_event_handler<N>.canonicalize(E_canon);
+
+        StructuralStateT<N> S = X;
+        StructuralStateT<N> S_next;
+        CarriedMetricsT<N>  carry;
+
+        while (k > 0)
+        {
+            // the last step is always scalar: it produces the envelope
+            if (closed_form && k > 1 && g_fp.screen(S) == 0u)
+            {
+                const std::uint64_t j = g_evolution<N>.fastForward(S, E_canon, k - 1, S_next);
+                if (j > 0)
+                {
+                    S  = S_next;
+                    k -= j;
+                    continue;
+                }
+            }
+
+            FMRT_StepInto(S, E, env, carry);
+            --k;
+
+            // identical input from here on: every remaining step repeats env
+            if (same_state_bits(env.state, S))
+                break;
+
+            S = env.state;
+        }
+
+        return env;
+    }
+
+    template <std::size_t N>
+    CollapseHorizon FMRT_CollapseHorizon(
+        const StructuralStateT<N>& X,
+        const StructEventT<N>&     E_in
+    )
+    {
+        CollapseHorizon H;
+
+        // Same gates as FMRT_Step stages 0, 1 and 3
+        ErrorCategory cat = ErrorCategory::None;
+
+        if constexpr (ENABLE_FP_GUARDS)
+        {
+            if (!g_fp.verifyEnvironment())
+                cat = ErrorCategory::NumericError;
+        }
+
+        if (cat == ErrorCategory::None &&
+            FpGuard::numericReject(g_fp.screen(X) | g_fp.screen(E_in), E_in.type))
+        {
+            cat = ErrorCategory::NumericError;
+        }
+
+        StructEventT<N> E = E_in;
+
+        if (cat == ErrorCategory::None)
+            cat = g_event_handler<N>.checkScreened(E);
+
+        if (cat != ErrorCategory::None)
+        {
+            H.status         = StepStatus::ERROR;
+            H.error_category = cat;
+            return H;
+        }
+
+        g_event_handler<N>.canonicalize(E);
+        g_evolution<N>.collapseHorizon(X, E, H);
+
+        auto to_time = [&](std::uint64_t steps)
+        {
+            return (steps == CollapseHorizon::NEVER)
+                 ? std::numeric_limits<double>::infinity()
+                 : static_cast<double>(steps) * E.dt;
+        };
+
+        H.time_min = to_time(H.steps_min);
+        H.time_max = to_time(H.steps_max);
+        return H;
+    }
+
+    template <std::size_t N>
+    void FMRT_CollapseHorizonBatch(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>*  E,
+        std::size_t             count,
+        CollapseHorizon*        out
+    )
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = FMRT_CollapseHorizon(X.load(i), E[i]);
+    }
+
+    // ------------------ BATCH HELPERS ------------------
+    template <std::size_t N>
+    static void step_scalar_lane(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>&  E,
+        std::size_t             i,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    )
+    {
+        const StateEnvelopeT<N> env = FMRT_Step(X.load(i), E);
+
+        X_next.store(i, env.state);
+
+        if (out.metrics)        out.metrics[i]        = env.metrics;
+        if (out.invariants)     out.invariants[i]     = env.invariants;
+        if (out.status)         out.status[i]         = env.status;
+        if (out.error_category) out.error_category[i] = env.error_category;
+    }
+
+    // FMRT_StepInPlace on organism i: a rejected organism keeps X(t)
+    template <std::size_t N>
+    static void step_in_place_lane(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>&  E,
+        std::size_t             i,
+        const EnvelopeColumns&  out
+    )
+    {
+        StructuralStateT<N> Xi = X.load(i);
+        InvariantStatus     inv{};
+        ErrorCategory       cat = ErrorCategory::None;
+
+        const StepStatus st = FMRT_StepInPlace(
+            Xi, E, out.metrics ? out.metrics + i : nullptr, &inv, &cat);
+
+        if (st == StepStatus::OK)
+            X.store(i, Xi);
+
+        if (out.invariants)     out.invariants[i]     = inv;
+        if (out.status)         out.status[i]         = st;
+        if (out.error_category) out.error_category[i] = cat;
+    }
+    // ------------------------------------------------------------
+
+    template <std::size_t N>
+    void FMRT_StepBatch(
+        const StateColumnsT<N>& X,
+        const StructEventT<N>*  E,
+        std::size_t             count,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    )
+    {
+        constexpr std::size_t LANES = BatchKernel::LANES;
+
+        std::size_t i = 0;
+
+        // ---------------------------------------------------------------------
+        // Vector blocks. The FP environment is process-wide, so one check
+        // covers the batch; if it fails every organism takes the scalar
+        // path, which reports the error per envelope.
+        // ---------------------------------------------------------------------
+        if (LANES > 1 && (!ENABLE_FP_GUARDS || g_fp.verifyEnvironment()))
+        {
+            LaneEventsT<N> lanes{};
+
+            for (; i + LANES <= count; i += LANES)
+            {
+                unsigned eligible = 0;
+
+                for (std::size_t l = 0; l < LANES; ++l)
+                {
+                    StructEventT<N> Ei = E[i + l];
+
+                    lanes.dt[l]     = 0.0;
+                    lanes.update[l] = 0.0;
+                    for (std::size_t k = 0; k < N; ++k)
+                        lanes.stimulus[k][l] = 0.0;
+
+                    // Same gates as FMRT_Step stages 1, 3 and 4
+                    if (FpGuard::numericReject(g_fp.screen(Ei), Ei.type))
+                        continue;
+
+                    if (g_event_handler<N>.checkScreened(Ei) != ErrorCategory::None)
+                        continue;
+
+                    g_event_handler<N>.canonicalize(Ei);
+
+                    if (Ei.type == EventType::Reset)
+                        continue;
+
+                    lanes.dt[l]     = Ei.dt;
+                    lanes.update[l] = (Ei.type == EventType::Update) ? 1.0 : 0.0;
+                    for (std::size_t k = 0; k < N; ++k)
+                        lanes.stimulus[k][l] = Ei.stimulus[k];
+
+                    eligible |= 1u << l;
+                }
+
+                const unsigned done = g_batch.step(X, i, lanes, eligible, X_next, out);
+
+                for (std::size_t l = 0; l < LANES; ++l)
+                    if (((done >> l) & 1u) == 0)
+                        step_scalar_lane(X, E[i + l], i + l, X_next, out);
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // Tail (and full batch without SIMD)
+        // ---------------------------------------------------------------------
+        for (; i < count; ++i)
+            step_scalar_lane(X, E[i], i, X_next, out);
+    }
+
+    // FMRT_StepBroadcast (in_place = false) / FMRT_StepBroadcastInPlace
+    template <std::size_t N>
+    static void step_broadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E_in,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out,
+        bool                    in_place
+    )
+    {
+        constexpr std::size_t LANES = BatchKernel::LANES;
+        constexpr unsigned    ALL   = (1u << LANES) - 1u;
+
+        std::size_t i = 0;
+
+        // ---------------------------------------------------------------------
+        // FMRT_Step stages 0, 1 (event part), 3 and 4, once for the whole
+        // broadcast. The state part of stage 1 stays per lane in the kernel.
+        // ---------------------------------------------------------------------
+        StructEventT<N> E = E_in;
+
+        const bool kernel =
+            (!ENABLE_FP_GUARDS || g_fp.verifyEnvironment()) &&
+            !FpGuard::numericReject(g_fp.screen(E), E.type) &&
+            g_event_handler<N>.checkScreened(E) == ErrorCategory::None &&
+            E.type != EventType::Reset;
+
+        if (kernel)
+        {
+            g_event_handler<N>.canonicalize(E);
+
+            const bool tick = (E.type != EventType::Update);
+
+            LaneEventsT<N> lanes{};
+            if (!tick)
+            {
+                for (std::size_t l = 0; l < LANES; ++l)
+                {
+                    lanes.dt[l]     = E.dt;
+                    lanes.update[l] = 1.0;
+                    for (std::size_t k = 0; k < N; ++k)
+                        lanes.stimulus[k][l] = E.stimulus[k];
+                }
+            }
+
+            for (; i + LANES <= count; i += LANES)
+            {
+                const unsigned done = tick
+                    ? g_batch.tick(X, i, E.dt, ALL, X_next, out)
+                    : g_batch.step(X, i, lanes, ALL, X_next, out);
+
+                if (done == ALL)
+                    continue;
+
+                for (std::size_t l = 0; l < LANES; ++l)
+                {
+                    if (((done >> l) & 1u) != 0)
+                        continue;
+
+                    if (in_place)
+                        step_in_place_lane(X, E_in, i + l, out);
+                    else
+                        step_scalar_lane(X, E_in, i + l, X_next, out);
+                }
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            if (in_place)
+                step_in_place_lane(X, E_in, i, out);
+            else
+                step_scalar_lane(X, E_in, i, X_next, out);
+        }
+    }
+
+    template <std::size_t N>
+    void FMRT_StepBroadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    )
+    {
+        step_broadcast(X, count, E, X_next, out, false);
+    }
+
+    template <std::size_t N>
+    void FMRT_StepBroadcastInPlace(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const EnvelopeColumns&  out
+    )
+    {
+        step_broadcast(X, count, E, X, out, true);
+    }
+
+    // FMRT_StepFactorBroadcast (in_place = false) / ...InPlace
+    template <std::size_t N>
+    static void step_factor_broadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E_in,
+        const double*           loading,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out,
+        bool                    in_place
+    )
+    {
+        constexpr std::size_t LANES = BatchKernel::LANES;
+        constexpr unsigned    ALL   = (1u << LANES) - 1u;
+
+        // scalar path with the event organism i would have been sent
+        const auto scalar = [&](std::size_t i)
+        {
+            StructEventT<N> Ei = E_in;
+            for (std::size_t k = 0; k < N; ++k)
+                Ei.stimulus[k] = loading[i] * E_in.stimulus[k];
+
+            if (in_place)
+                step_in_place_lane(X, Ei, i, out);
+            else
+                step_scalar_lane(X, Ei, i, X_next, out);
+        };
+
+        std::size_t i = 0;
+
+        // ---------------------------------------------------------------------
+        // Stage 0 and the dt part of stages 1, 3 and 4 once; the kernel
+        // screens every scaled stimulus (non-finite / subnormal products
+        // and a non-finite shock fall back to FMRT_Step per organism).
+        // ---------------------------------------------------------------------
+        StructEventT<N> E = E_in;
+        for (auto& v : E.stimulus) v = 0.0;
+
+        const bool kernel =
+            E.type == EventType::Update &&
+            (!ENABLE_FP_GUARDS || g_fp.verifyEnvironment()) &&
+            !FpGuard::numericReject(g_fp.screen(E), E.type) &&
+            g_event_handler<N>.checkScreened(E) == ErrorCategory::None;
+
+        if (kernel)
+        {
+            g_event_handler<N>.canonicalize(E);
+
+            for (; i + LANES <= count; i += LANES)
+            {
+                const unsigned done = g_batch.factor(
+                    X, i, E.dt, E_in.stimulus.data(), loading, ALL, X_next, out);
+
+                if (done == ALL)
+                    continue;
+
+                for (std::size_t l = 0; l < LANES; ++l)
+                    if (((done >> l) & 1u) == 0)
+                        scalar(i + l);
+            }
+        }
+
+        for (; i < count; ++i)
+            scalar(i);
+    }
+
+    template <std::size_t N>
+    void FMRT_StepFactorBroadcast(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const double*           loading,
+        const StateColumnsT<N>& X_next,
+        const EnvelopeColumns&  out
+    )
+    {
+        step_factor_broadcast(X, count, E, loading, X_next, out, false);
+    }
+
+    template <std::size_t N>
+    void FMRT_StepFactorBroadcastInPlace(
+        const StateColumnsT<N>& X,
+        std::size_t             count,
+        const StructEventT<N>&  E,
+        const double*           loading,
+        const EnvelopeColumns&  out
+    )
+    {
+        step_factor_broadcast(X, count, E, loading, X, out, true);
+    }
+
+    // ------------------ EXPLICIT INSTANTIATIONS ------------------
+#define FMRT_INSTANTIATE_API(N)                                             \
+    template StateEnvelopeT<N> FMRT_Step<N>(                                \
+        const StructuralStateT<N>&, const StructEventT<N>&);                \
+    template void FMRT_StepInto<N>(                                         \
+        const StructuralStateT<N>&, const StructEventT<N>&,                 \
+        StateEnvelopeT<N>&);                                                \
+    template void FMRT_StepInto<N>(                                         \
+        const StructuralStateT<N>&, const StructEventT<N>&,                 \
+        StateEnvelopeT<N>&, CarriedMetricsT<N>&);                           \
+    template StepStatus FMRT_StepInPlace<N>(                                \
+        StructuralStateT<N>&, const StructEventT<N>&,                       \
+        DerivedMetrics*, InvariantStatus*, ErrorCategory*);                 \
+    template StepStatus FMRT_StepInPlace<N>(                                \
+        StructuralStateT<N>&, const StructEventT<N>&, CarriedMetricsT<N>&,  \
+        DerivedMetrics*, InvariantStatus*, ErrorCategory*);                 \
+    template StateEnvelopeT<N> FMRT_FastForward<N>(                         \
+        const StructuralStateT<N>&, const StructEventT<N>&, std::uint64_t); \
+    template CollapseHorizon FMRT_CollapseHorizon<N>(                       \
+        const StructuralStateT<N>&, const StructEventT<N>&);                \
+    template void FMRT_CollapseHorizonBatch<N>(                             \
+        const StateColumnsT<N>&, const StructEventT<N>*, std::size_t,       \
+        CollapseHorizon*);                                                  \
+    template void FMRT_StepBatch<N>(                                        \
+        const StateColumnsT<N>&, const StructEventT<N>*, std::size_t,       \
+        const StateColumnsT<N>&, const EnvelopeColumns&);                   \
+    template void FMRT_StepBroadcast<N>(                                    \
+        const StateColumnsT<N>&, std::size_t, const StructEventT<N>&,       \
+        const StateColumnsT<N>&, const EnvelopeColumns&);                   \
+    template void FMRT_StepBroadcastInPlace<N>(                             \
+        const StateColumnsT<N>&, std::size_t, const StructEventT<N>&,       \
+        const EnvelopeColumns&);                                            \
+    template void FMRT_StepFactorBroadcast<N>(                              \
+        const StateColumnsT<N>&, std::size_t, const StructEventT<N>&,       \
+        const double*, const StateColumnsT<N>&, const EnvelopeColumns&);    \
+    template void FMRT_StepFactorBroadcastInPlace<N>(                       \
+        const StateColumnsT<N>&, std::size_t, const StructEventT<N>&,       \
+        const double*, const EnvelopeColumns&);
+
+    FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_API)
+#undef FMRT_INSTANTIATE_API
+
 } // namespace fmrt
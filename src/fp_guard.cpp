@@ -2,13 +2,86 @@
 // FMRT Core V2.2
 // fp_guard.cpp
 //
-// FpGuard is fully inline; this compilation unit exists only
-// to satisfy consistent repository structure.
+// Single-pass numeric screens of FpGuard. Every double is classified by
+// its exponent field only, so the result does not depend on FP modes
+// (DAZ / FTZ) and needs no branches per value:
+//   exponent == 0x7FF             → NaN / Inf
+//   exponent == 0, mantissa != 0  → subnormal
 //
 
 #include "internal/fp_guard.hpp"
+#include "internal/simd.hpp"
+
+#include <cstdint>
+#include <cstring>
 
 namespace fmrt
 {
-    // No non-inline methods — everything defined in fp_guard.hpp.
-}
+    namespace
+    {
+        constexpr std::uint64_t EXP_MASK  = 0x7FF0000000000000ULL;
+        constexpr std::uint64_t MANT_MASK = 0x000FFFFFFFFFFFFFULL;
+
+        // bit 0 = non-finite, bit 1 = subnormal
+        inline unsigned classify(double x) noexcept
+        {
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof(double));
+
+            // |x| as bits: exponent all ones ⇔ |x| >= EXP_MASK,
+            // 0 < |x| < 2^52 (wraps for zero) ⇔ subnormal
+            const std::uint64_t a = b & (EXP_MASK | MANT_MASK);
+            const unsigned non_finite = (a >= EXP_MASK);
+            const unsigned subnormal  = (a - 1) < MANT_MASK;
+            return non_finite | (subnormal << 1);
+        }
+
+        template <std::size_t N>
+        inline unsigned classifyArray(const double* p) noexcept
+        {
+            unsigned acc = 0;
+            std::size_t i = 0;
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+            constexpr std::size_t VEC_END = N - N % simd::LANES;
+
+            unsigned non_finite = 0, subnormal = 0;
+            for (; i < VEC_END; i += simd::LANES)
+            {
+                const simd::VecD v = simd::load(p + i);
+                non_finite |= simd::bits(simd::nonFinite(v));
+                subnormal  |= simd::bits(simd::subnormal(v));
+            }
+            acc = (non_finite != 0) | (unsigned(subnormal != 0) << 1);
+#endif
+
+            for (; i < N; ++i)
+                acc |= classify(p[i]);
+
+            return acc;
+        }
+    } // namespace
+
+    template <std::size_t N>
+    unsigned FpGuard::screen(const StructuralStateT<N>& X) const noexcept
+    {
+        // bits 0..1 are SCREEN_STATE_*
+        return classifyArray<N>(X.Delta.data()) |
+               classify(X.Phi) | classify(X.M) | classify(X.Kappa);
+    }
+
+    template <std::size_t N>
+    unsigned FpGuard::screen(const StructEventT<N>& E) const noexcept
+    {
+        return (classify(E.dt) << 2) |
+               (classifyArray<N>(E.stimulus.data()) << 4);
+    }
+
+#define FMRT_INSTANTIATE_SCREEN(N)                                          \
+    template unsigned FpGuard::screen<N>(const StructuralStateT<N>&) const noexcept; \
+    template unsigned FpGuard::screen<N>(const StructEventT<N>&) const noexcept;
+
+    FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_SCREEN)
+#undef FMRT_INSTANTIATE_SCREEN
+
+} // namespace fmrt
@@ -5,11 +5,23 @@
 namespace fmrt
 {
 
-bool InvariantValidator::validate(
-    const StructuralState& X_current,
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::validate(
+    const StructuralStateT<N>& X_current,
+    const StructuralStateT<N>& X_next,
     const DerivedMetrics& metrics,
-    StateEnvelope& out_env
+    StateEnvelopeT<N>& out_env
+) const noexcept
+{
+    return validate(X_current, X_next, metrics, out_env.invariants);
+}
+
+template <std::size_t N>
+bool InvariantValidatorT<N>::validate(
+    const StructuralStateT<N>& X_current,
+    const StructuralStateT<N>& X_next,
+    const DerivedMetrics& metrics,
+    InvariantStatus& out
 ) const noexcept
 {
     InvariantStatus st{};
@@ -27,14 +39,15 @@ bool InvariantValidator::validate(
     ok &= checkForbidden(X_next, metrics, st);
 
     st.all_ok = ok;
-    out_env.invariants = st;
+    out = st;
 
     return ok;
 }
 
-bool InvariantValidator::checkMemory(
-    const StructuralState& X_cur,
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkMemory(
+    const StructuralStateT<N>& X_cur,
+    const StructuralStateT<N>& X_next,
     InvariantStatus& st
 ) const noexcept
 {
@@ -46,8 +59,9 @@ bool InvariantValidator::checkMemory(
     return valid;
 }
 
-bool InvariantValidator::checkKappa(
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkKappa(
+    const StructuralStateT<N>& X_next,
     InvariantStatus& st
 ) const noexcept
 {
@@ -59,8 +73,9 @@ bool InvariantValidator::checkKappa(
     return valid;
 }
 
-bool InvariantValidator::checkMetric(
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkMetric(
+    const StructuralStateT<N>& X_next,
     const DerivedMetrics& metrics,
     InvariantStatus& st
 ) const noexcept
@@ -82,8 +97,9 @@ bool InvariantValidator::checkMetric(
     return valid;
 }
 
-bool InvariantValidator::checkTau(
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkTau(
+    const StructuralStateT<N>& X_next,
     const DerivedMetrics& metrics,
     InvariantStatus& st
 ) const noexcept
@@ -104,7 +120,8 @@ bool InvariantValidator::checkTau(
     return ok;
 }
 
-bool InvariantValidator::checkMorphology(
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkMorphology(
     const DerivedMetrics& metrics,
     InvariantStatus& st
 ) const noexcept
@@ -118,7 +135,8 @@ bool InvariantValidator::checkMorphology(
     return valid;
 }
 
-bool InvariantValidator::checkRegime(
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkRegime(
     Regime prev,
     Regime next,
     InvariantStatus& st
@@ -133,8 +151,9 @@ bool InvariantValidator::checkRegime(
     return valid;
 }
 
-bool InvariantValidator::checkCollapse(
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkCollapse(
+    const StructuralStateT<N>& X_next,
     const DerivedMetrics& metrics,
     InvariantStatus& st
 ) const noexcept
@@ -154,8 +173,9 @@ bool InvariantValidator::checkCollapse(
     return valid;
 }
 
-bool InvariantValidator::checkForbidden(
-    const StructuralState& X_next,
+template <std::size_t N>
+bool InvariantValidatorT<N>::checkForbidden(
+    const StructuralStateT<N>& X_next,
     const DerivedMetrics& metrics,
     InvariantStatus& st
 ) const noexcept
@@ -181,4 +201,8 @@ bool InvariantValidator::checkForbidden(
     return valid;
 }
 
+#define FMRT_INSTANTIATE_VALIDATOR(N) template class InvariantValidatorT<N>;
+FMRT_FOR_EACH_DELTA_DIM(FMRT_INSTANTIATE_VALIDATOR)
+#undef FMRT_INSTANTIATE_VALIDATOR
+
 } // namespace fmrt
@@ -0,0 +1,280 @@
+//
+// FMRT Core V2.2
+// stage_profile.cpp
+//
+// Per-thread stage histograms behind fmrt_profile.hpp.
+//
+// Each recording thread owns one ThreadHistograms block, allocated on its
+// first sample and listed in the registry. Only the owner writes it, with
+// relaxed load / store pairs (no read-modify-write on the step path);
+// FMRT_StageProfile() reads the blocks with relaxed loads while they may
+// still be written, so a snapshot of a running thread can be a few samples
+// behind. A thread that exits folds its block into `retired` first.
+//
+
+#include "internal/stage_profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if FMRT_STAGE_PROFILING
+#   include <atomic>
+#   include <mutex>
+#   include <new>
+#   include <vector>
+#endif
+
+namespace fmrt
+{
+    const char* pipelineStageName(PipelineStage s) noexcept
+    {
+        switch (s)
+        {
+            case PipelineStage::FpGuard:       return "fp_guard";
+            case PipelineStage::NumericScreen: return "numeric_screen";
+            case PipelineStage::Validate:      return "validate";
+            case PipelineStage::Canonicalize:  return "canonicalize";
+            case PipelineStage::Evolve:        return "evolve";
+            case PipelineStage::Invariants:    return "invariants";
+            case PipelineStage::Diagnostics:   return "diagnostics";
+        }
+        return "unknown";
+    }
+
+    std::uint64_t StageHistogram::quantile(double q) const noexcept
+    {
+        if (samples == 0)
+            return 0;
+
+        const double        want   = std::ceil(std::min(std::max(q, 0.0), 1.0) *
+                                               static_cast<double>(samples));
+        const std::uint64_t target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(want));
+
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < BUCKETS; ++b)
+        {
+            seen += count[b];
+            if (seen >= target)
+                return std::min(bucketHigh(b), max);
+        }
+        return max;
+    }
+
+#if FMRT_STAGE_PROFILING
+
+    namespace
+    {
+        using Counter = std::atomic<std::uint64_t>;
+
+        inline void bump(Counter& c, std::uint64_t by) noexcept
+        {
+            c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        struct ThreadHistograms
+        {
+            struct Stage
+            {
+                Counter count[StageHistogram::BUCKETS] = {};
+                Counter samples{0};
+                Counter sum{0};
+                Counter min{0};
+                Counter max{0};
+            };
+
+            Stage stage[PIPELINE_STAGES];
+
+            void record(PipelineStage s, std::uint64_t v) noexcept
+            {
+                Stage& h = stage[static_cast<std::size_t>(s)];
+
+                const std::uint64_t n = h.samples.load(std::memory_order_relaxed);
+                if (n == 0 || v < h.min.load(std::memory_order_relaxed))
+                    h.min.store(v, std::memory_order_relaxed);
+                if (v > h.max.load(std::memory_order_relaxed))
+                    h.max.store(v, std::memory_order_relaxed);
+
+                bump(h.count[StageHistogram::bucketOf(v)], 1);
+                bump(h.sum, v);
+                h.samples.store(n + 1, std::memory_order_relaxed);
+            }
+
+            void readInto(StageProfile& p) const noexcept
+            {
+                for (std::size_t i = 0; i < PIPELINE_STAGES; ++i)
+                {
+                    const Stage& h = stage[i];
+
+                    StageHistogram r;
+                    for (std::size_t b = 0; b < StageHistogram::BUCKETS; ++b)
+                        r.count[b] = h.count[b].load(std::memory_order_relaxed);
+                    r.samples = h.samples.load(std::memory_order_relaxed);
+                    r.sum     = h.sum.load(std::memory_order_relaxed);
+                    r.min     = h.min.load(std::memory_order_relaxed);
+                    r.max     = h.max.load(std::memory_order_relaxed);
+
+                    p.stage[i].merge(r);
+                }
+            }
+
+            void clear() noexcept
+            {
+                for (Stage& h : stage)
+                {
+                    for (Counter& c : h.count)
+                        c.store(0, std::memory_order_relaxed);
+                    h.samples.store(0, std::memory_order_relaxed);
+                    h.sum.store(0, std::memory_order_relaxed);
+                    h.min.store(0, std::memory_order_relaxed);
+                    h.max.store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        struct Registry
+        {
+            std::mutex                     m;
+            std::vector<ThreadHistograms*> live;
+            StageProfile                   retired;     // exited threads
+        };
+
+        Registry& registry()
+        {
+            static Registry r;
+            return r;
+        }
+
+        // the calling thread's block; folded into `retired` at thread exit
+        struct ThreadSlot
+        {
+            ThreadHistograms* h = nullptr;
+
+            ~ThreadSlot()
+            {
+                if (!h)
+                    return;
+
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.m);
+
+                h->readInto(r.retired);
+                r.live.erase(std::find(r.live.begin(), r.live.end(), h));
+                delete h;
+            }
+        };
+
+        thread_local ThreadSlot t_slot;
+
+        std::uint64_t clockOverhead() noexcept
+        {
+            constexpr std::size_t LAPS = 255;
+
+            StageHistogram h;
+            std::uint64_t  t = stage_profile::now();
+            for (std::size_t i = 0; i < LAPS; ++i)
+            {
+                const std::uint64_t u = stage_profile::now();
+                h.record(u - t);
+                t = u;
+            }
+            return h.quantile(0.5);
+        }
+
+        ThreadHistograms* attach() noexcept
+        {
+            ThreadHistograms* h = new (std::nothrow) ThreadHistograms;
+            if (!h)
+                return nullptr;
+
+            try
+            {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.m);
+                r.live.push_back(h);
+            }
+            catch (...)
+            {
+                delete h;
+                return nullptr;
+            }
+
+            t_slot.h = h;
+            return h;
+        }
+    } // namespace
+
+    namespace stage_profile
+    {
+        void record(PipelineStage s, std::uint64_t ticks) noexcept
+        {
+            ThreadHistograms* h = t_slot.h ? t_slot.h : attach();
+            if (h)                              // out of memory: sample dropped
+                h->record(s, ticks);
+        }
+    } // namespace stage_profile
+
+    bool FMRT_StageProfilingEnabled() noexcept { return true; }
+
+    StageProfile FMRT_StageProfile()
+    {
+        StageProfile p;
+#if defined(FMRT_STAGE_HAS_TSC)
+        p.unit = "TSC ticks";
+#else
+        p.unit = "ns";
+#endif
+        p.clock_overhead = clockOverhead();
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.m);
+
+        p.merge(r.retired);
+        for (const ThreadHistograms* h : r.live)
+            h->readInto(p);
+        return p;
+    }
+
+    void FMRT_StageProfileReset()
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.m);
+
+        r.retired = StageProfile{};
+        for (ThreadHistograms* h : r.live)
+            h->clear();
+    }
+
+#else
+
+    bool FMRT_StageProfilingEnabled() noexcept { return false; }
+
+    StageProfile FMRT_StageProfile() { return StageProfile{}; }
+
+    void FMRT_StageProfileReset() {}
+
+#endif
+
+    void FMRT_StageProfileDump(const StageProfile& profile, std::FILE* out)
+    {
+        std::fprintf(out, "step pipeline stages (%s, clock overhead ~%llu per sample)\n",
+                     profile.unit, static_cast<unsigned long long>(profile.clock_overhead));
+        std::fprintf(out, "  %-15s %12s %10s %10s %10s %10s %10s %10s\n",
+                     "stage", "samples", "mean", "p50", "p90", "p99", "p99.9", "max");
+
+        for (std::size_t i = 0; i < PIPELINE_STAGES; ++i)
+        {
+            const StageHistogram& h = profile.stage[i];
+
+            std::fprintf(out, "  %-15s %12llu %10.1f %10llu %10llu %10llu %10llu %10llu\n",
+                         pipelineStageName(static_cast<PipelineStage>(i)),
+                         static_cast<unsigned long long>(h.samples),
+                         h.mean(),
+                         static_cast<unsigned long long>(h.quantile(0.50)),
+                         static_cast<unsigned long long>(h.quantile(0.90)),
+                         static_cast<unsigned long long>(h.quantile(0.99)),
+                         static_cast<unsigned long long>(h.quantile(0.999)),
+                         static_cast<unsigned long long>(h.max));
+        }
+    }
+
+} // namespace fmrt
@@ -38,7 +38,29 @@ int test_numeric_underflow_overflow_safety();
 int test_determinism_single_run();
 int test_determinism_multi_run();
 int test_determinism_no_hidden_state();
-void test_bridge_numeric_reject_NaN();
+int test_batch_bit_identical();
+int test_delta_dimensions();
+int test_step_in_place();
+int test_numeric_screen();
+int test_fast_forward();
+int test_collapse_horizon();
+int test_carried_metrics();
+int test_det_exp();
+int test_fleet();
+int test_fleet_queue();
+int test_organism_pool();
+int test_fleet_lifecycle();
+int test_fleet_broadcast();
+int test_factor_broadcast();
+int test_sorted_batch();
+int test_stage_profile();
+int test_workload();
+int test_event_log();
+int test_replay();
+int test_trajectory();
+int test_bridge_numeric_reject_NaN();
+int test_bridge_handles();
+int test_bridge_stream();
 
 int main()
 {
@@ -189,9 +211,39 @@ if (test_numeric_underflow_overflow_safety() != 0) return 1;
 if (test_determinism_single_run() != 0) return 1;
 if (test_determinism_multi_run() != 0) return 1;
 if (test_determinism_no_hidden_state() != 0) return 1;
-
-std::printf("Running bridge_numeric_reject_NaN...\n");
-test_bridge_numeric_reject_NaN();
+if (test_batch_bit_identical() != 0) return 1;
+if (test_delta_dimensions() != 0) return 1;
+if (test_step_in_place() != 0) return 1;
+if (test_numeric_screen() != 0) return 1;
+if (test_fast_forward() != 0) return 1;
+if (test_collapse_horizon() != 0) return 1;
+if (test_carried_metrics() != 0) return 1;
+if (test_det_exp() != 0) return 1;
+if (test_fleet() != 0) return 1;
+if (test_fleet_queue() != 0) return 1;
+if (test_organism_pool() != 0) return 1;
+if (test_fleet_lifecycle() != 0) return 1;
+if (test_fleet_broadcast() != 0) return 1;
+if (test_factor_broadcast() != 0) return 1;
+if (test_sorted_batch() != 0) return 1;
+if (test_stage_profile() != 0) return 1;
+if (test_workload() != 0) return 1;
+if (test_event_log() != 0) return 1;
+if (test_replay() != 0) return 1;
+if (test_trajectory() != 0) return 1;
+
+if (test_bridge_numeric_reject_NaN() != 0) {
+    std::cerr << "bridge_numeric_reject_NaN FAILED\n";
+    return 1;
+}
+if (test_bridge_handles() != 0) {
+    std::cerr << "bridge_handles FAILED\n";
+    return 1;
+}
+if (test_bridge_stream() != 0) {
+    std::cerr << "bridge_stream FAILED\n";
+    return 1;
+}
 
     std::cout << "ALL TESTS PASSED\n";
     return 0; 
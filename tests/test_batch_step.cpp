@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// deterministic LCG in [lo, hi)
+static double next_uniform(std::uint64_t& s, double lo, double hi)
+{
+    s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+    const double u = static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0);
+    return lo + (hi - lo) * u;
+}
+
+int test_batch_bit_identical()
+{
+    std::cout << "Running batch_bit_identical...\n";
+
+    const std::size_t N = 203;   // not a multiple of any lane width
+    std::uint64_t seed = 42;
+
+    std::vector<StructuralState> ref(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        StructuralState& X = ref[i];
+        X.reset();
+        for (auto& v : X.Delta) v = next_uniform(seed, -12.0, 12.0);
+        X.Phi   = next_uniform(seed, 0.0, 60.0);
+        X.M     = next_uniform(seed, 0.0, 100.0);
+        X.Kappa = next_uniform(seed, 0.0, 1.2);
+        X.RegimePrev = static_cast<Regime>(i % 3);
+    }
+
+    // special organisms
+    ref[3].Kappa  = 0.0;                        // collapsed
+    ref[5].Kappa  = 2e-12;                      // collapses during the step
+    ref[7].Phi    = 1e-320;                     // denormal → numeric reject
+    ref[9].M      = std::numeric_limits<double>::infinity();
+    ref[11].Delta = {0.0, -0.0, 0.0, -0.0};
+    ref[11].Phi   = 0.0;
+    ref[11].RegimePrev = Regime::REL;           // regime invariant violation
+
+    // SoA copy
+    std::vector<double> cols[DELTA_DIM];
+    std::vector<double> phi(N), m(N), kappa(N);
+    std::vector<Regime> prev(N);
+    for (auto& c : cols) c.resize(N);
+
+    StateColumns X;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) X.Delta[k] = cols[k].data();
+    X.Phi = phi.data();
+    X.M = m.data();
+    X.Kappa = kappa.data();
+    X.RegimePrev = prev.data();
+
+    for (std::size_t i = 0; i < N; ++i)
+        X.store(i, ref[i]);
+
+    std::vector<DerivedMetrics>  metrics(N);
+    std::vector<InvariantStatus> inv(N);
+    std::vector<StepStatus>      status(N);
+    std::vector<ErrorCategory>   err(N);
+
+    EnvelopeColumns out;
+    out.metrics        = metrics.data();
+    out.invariants     = inv.data();
+    out.status         = status.data();
+    out.error_category = err.data();
+
+    std::vector<StructEvent> events(N);
+
+    for (int step = 0; step < 40; ++step)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            StructEvent& E = events[i];
+            E = StructEvent{};
+
+            const std::size_t kind = (i + static_cast<std::size_t>(step)) % 7;
+            E.type = (kind < 4) ? EventType::Update
+                   : (kind == 4) ? EventType::Gap
+                   : (kind == 5) ? EventType::Heartbeat
+                   : EventType::Reset;
+
+            E.dt = next_uniform(seed, 0.01, 2.0);
+            for (auto& v : E.stimulus) v = next_uniform(seed, -20.0, 20.0);
+        }
+
+        events[13].dt = -1.0;                                          // invalid dt
+        events[17].stimulus[2] = std::numeric_limits<double>::quiet_NaN();
+        events[19].dt = 50.0;                                          // |1 - λ·dt| > 1
+
+        FMRT_StepBatch(X, events.data(), N, X, out);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const StateEnvelope env = FMRT_Step(ref[i], events[i]);
+
+            if (!same_state(X.load(i), env.state) ||
+                !same_metrics(metrics[i], env.metrics) ||
+                inv[i].flags != env.invariants.flags ||
+                inv[i].all_ok != env.invariants.all_ok ||
+                status[i] != env.status ||
+                err[i] != env.error_category)
+            {
+                std::cerr << "batch_bit_identical FAILED: organism " << i
+                          << " step " << step << "\n";
+                return 1;
+            }
+
+            ref[i] = env.state;
+        }
+    }
+
+    std::cout << "batch_bit_identical OK\n";
+    return 0;
+}
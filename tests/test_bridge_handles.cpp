@@ -0,0 +1,110 @@
+#include <cstdio>
+
+#include "../bridge/fmrt_bridge.h"
+#include "fmrt_api.hpp"
+
+using namespace fmrt;
+
+static fmrt_bridge_event make_event(EventType type, double dt, double s)
+{
+    fmrt_bridge_event ev{};
+    ev.type = static_cast<std::uint8_t>(type);
+    ev.dt   = dt;
+    for (int i = 0; i < 4; ++i)
+        ev.stimulus[i] = (type == EventType::Update) ? s * (i + 1) : 0.0;
+    return ev;
+}
+
+int test_bridge_handles()
+{
+    std::printf("Running bridge_handles...\n");
+
+    fmrt_bridge_handle a = fmrt_bridge_create();
+    fmrt_bridge_handle b = fmrt_bridge_create();
+    if (!a || !b) return 1;
+
+    // reference organisms driven through the C++ API
+    StructuralState Xa{};
+    StructuralState Xb{};
+    Xa.reset();
+    Xb.reset();
+
+    // --- independent instances -------------------------------------------
+    const fmrt_bridge_event up = make_event(EventType::Update, 0.5, 0.2);
+    const fmrt_bridge_event hb = make_event(EventType::Heartbeat, 1.0, 0.0);
+
+    fmrt_bridge_envelope out{};
+    if (fmrt_bridge_step(a, &up, &out) != FMRT_BRIDGE_OK) return 1;
+    if (fmrt_bridge_step(b, &hb, &out) != FMRT_BRIDGE_OK) return 1;
+
+    StructEvent Eu{};
+    Eu.type = EventType::Update;
+    Eu.dt   = up.dt;
+    for (int i = 0; i < 4; ++i) Eu.stimulus[i] = up.stimulus[i];
+
+    StructEvent Eh{};
+    Eh.type = EventType::Heartbeat;
+    Eh.dt   = hb.dt;
+
+    Xa = fmrt::FMRT_Step(Xa, Eu).state;
+    Xb = fmrt::FMRT_Step(Xb, Eh).state;
+
+    fmrt_bridge_state sa{};
+    fmrt_bridge_state sb{};
+    fmrt_bridge_export_state(a, &sa);
+    fmrt_bridge_export_state(b, &sb);
+
+    if (sa.kappa != Xa.Kappa || sa.phi != Xa.Phi || sa.m != Xa.M) return 1;
+    if (sb.kappa != Xb.Kappa || sb.phi != Xb.Phi || sb.m != Xb.M) return 1;
+    if (sa.delta[3] != Xa.Delta[3] || sb.delta[0] != Xb.Delta[0]) return 1;
+
+    // --- batch call with a repeated handle (processed in order) -----------
+    fmrt_bridge_handle handles[4] = { a, b, a, nullptr };
+    fmrt_bridge_event  events[4]  = { up, hb, hb, hb };
+    fmrt_bridge_envelope outs[4]{};
+    int rcs[4] = { 1, 1, 1, 1 };
+
+    const int rc = fmrt_bridge_step_many(handles, events, outs, 4, rcs);
+    if (rc != FMRT_BRIDGE_E_NULLPTR) return 1;
+    if (rcs[0] != FMRT_BRIDGE_OK || rcs[1] != FMRT_BRIDGE_OK ||
+        rcs[2] != FMRT_BRIDGE_OK || rcs[3] != FMRT_BRIDGE_E_NULLPTR) return 1;
+
+    Xa = fmrt::FMRT_Step(Xa, Eu).state;
+    Xa = fmrt::FMRT_Step(Xa, Eh).state;
+    Xb = fmrt::FMRT_Step(Xb, Eh).state;
+
+    fmrt_bridge_export_state(a, &sa);
+    fmrt_bridge_export_state(b, &sb);
+    if (sa.kappa != Xa.Kappa || sa.m != Xa.M) return 1;
+    if (sb.kappa != Xb.Kappa || sb.m != Xb.M) return 1;
+
+    // --- import / export round trip ---------------------------------------
+    fmrt_bridge_state in{};
+    in.delta[0] = 0.5;
+    in.phi = 2.0;
+    in.m = 3.0;
+    in.kappa = 0.7;
+    in.regime_prev = static_cast<std::uint8_t>(Regime::DEV);
+
+    if (fmrt_bridge_import_state(b, &in) != FMRT_BRIDGE_OK) return 1;
+    fmrt_bridge_export_state(b, &sb);
+    if (sb.kappa != 0.7 || sb.regime_prev != in.regime_prev) return 1;
+
+    // invalid import leaves state untouched
+    in.kappa = -1.0;
+    if (fmrt_bridge_import_state(b, &in) != FMRT_BRIDGE_E_BAD_INPUT) return 1;
+    fmrt_bridge_export_state(b, &sb);
+    if (sb.kappa != 0.7) return 1;
+
+    // --- reset ---------------------------------------------------------------
+    if (fmrt_bridge_reset(a) != FMRT_BRIDGE_OK) return 1;
+    fmrt_bridge_export_state(a, &sa);
+    if (sa.kappa != RESET_KAPPA || sa.m != 0.0) return 1;
+
+    fmrt_bridge_destroy(a);
+    fmrt_bridge_destroy(b);
+    fmrt_bridge_destroy(nullptr);
+
+    std::printf("bridge_handles OK\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <cmath>      // NAN
+#include <cstdio>
+#include <vector>
+
+#include "../bridge/fmrt_bridge.h"
+#include "fmrt_types.hpp"
+
+using namespace fmrt;
+
+// events embedded in a larger caller record (strided access)
+struct stream_record
+{
+    std::uint64_t     sequence;
+    fmrt_bridge_event ev;
+};
+
+int test_bridge_stream()
+{
+    std::printf("Running bridge_stream...\n");
+
+    const std::size_t N = 64;
+
+    std::vector<stream_record> records(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        stream_record& r = records[i];
+        r.sequence = i;
+        r.ev.type  = static_cast<std::uint8_t>(i % 3 == 0 ? EventType::Heartbeat : EventType::Update);
+        r.ev.dt    = 0.1 + 0.01 * static_cast<double>(i % 5);
+        for (int k = 0; k < 4; ++k)
+            r.ev.stimulus[k] = (r.ev.type == 0) ? 0.05 * (k + 1) : 0.0;
+    }
+
+    records[10].ev.dt = -1.0;                  // rejected by the bridge, as in fmrt_bridge_step
+    records[40].ev.stimulus[2] = NAN;
+
+    fmrt_bridge_handle streamed = fmrt_bridge_create();
+    fmrt_bridge_handle stepped  = fmrt_bridge_create();
+
+    fmrt_bridge_envelope untouched{};
+    untouched.status = 0xFF;
+    std::vector<fmrt_bridge_envelope> out(N, untouched);
+
+    // the stream stops at each bad event; the caller resumes after it
+    int rc = fmrt_bridge_step_stream(streamed,
+                                     &records[0].ev, sizeof(stream_record),
+                                     out.data(), sizeof(fmrt_bridge_envelope),
+                                     N);
+    if (rc != FMRT_BRIDGE_E_BAD_INPUT) return 1;
+    if (out[9].status == 0xFF || out[10].status != 0xFF || out[11].status != 0xFF) return 1;
+
+    rc = fmrt_bridge_step_stream(streamed,
+                                 &records[11].ev, sizeof(stream_record),
+                                 &out[11], sizeof(fmrt_bridge_envelope),
+                                 N - 11);
+    if (rc != FMRT_BRIDGE_E_BAD_INPUT) return 1;
+    if (out[39].status == 0xFF || out[40].status != 0xFF) return 1;
+
+    rc = fmrt_bridge_step_stream(streamed,
+                                 &records[41].ev, sizeof(stream_record),
+                                 &out[41], sizeof(fmrt_bridge_envelope),
+                                 N - 41);
+    if (rc != FMRT_BRIDGE_OK) return 1;
+
+    // reference: one call per event
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        fmrt_bridge_envelope ref{};
+        rc = fmrt_bridge_step(stepped, &records[i].ev, &ref);
+
+        if (i == 10 || i == 40)
+        {
+            if (rc != FMRT_BRIDGE_E_BAD_INPUT) return 1;
+            continue;
+        }
+
+        if (rc != FMRT_BRIDGE_OK) return 1;
+        if (ref.status != out[i].status || ref.invariants_ok != out[i].invariants_ok) return 1;
+        for (int k = 0; k < 4; ++k)
+            if (ref.derived[k] != out[i].derived[k]) return 1;
+    }
+
+    fmrt_bridge_state a{};
+    fmrt_bridge_state b{};
+    fmrt_bridge_export_state(streamed, &a);
+    fmrt_bridge_export_state(stepped, &b);
+
+    if (a.kappa != b.kappa || a.phi != b.phi || a.m != b.m) return 1;
+    for (int k = 0; k < 4; ++k)
+        if (a.delta[k] != b.delta[k]) return 1;
+
+    // misaligned stride is rejected
+    rc = fmrt_bridge_step_stream(streamed, &records[0].ev, sizeof(stream_record) + 1,
+                                 out.data(), sizeof(fmrt_bridge_envelope), N);
+    if (rc != FMRT_BRIDGE_E_BAD_INPUT) return 1;
+
+    fmrt_bridge_destroy(streamed);
+    fmrt_bridge_destroy(stepped);
+
+    std::printf("bridge_stream OK\n");
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+#include "fmrt_api.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// deterministic event mix: updates of varying strength, gaps,
+// heartbeats, an invalid dt, a NaN stimulus and a reset
+static StructEvent event_at(std::uint64_t i)
+{
+    StructEvent E{};
+    E.dt = 0.05 + 0.01 * static_cast<double>(i % 7);
+
+    switch (i % 11)
+    {
+        case 0: case 1: case 2: case 3: case 4:
+            E.type = EventType::Update;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                E.stimulus[k] = 0.3 * static_cast<double>((i * (k + 3)) % 9) - 1.2;
+            break;
+        case 5: case 6:  E.type = EventType::Gap;       break;
+        case 7: case 8:  E.type = EventType::Heartbeat; break;
+        case 9:
+            E.type = EventType::Update;
+            E.dt   = (i % 3 == 0) ? -1.0 : 0.1;
+            E.stimulus[1] = (i % 3 == 1) ? std::numeric_limits<double>::quiet_NaN() : 0.2;
+            break;
+        default:
+            E.type = (i % 50 == 10) ? EventType::Reset : EventType::Gap;
+            break;
+    }
+    return E;
+}
+
+int test_carried_metrics()
+{
+    std::cout << "Running carried_metrics...\n";
+
+    StructuralState X_plain, X_carry, X_into;
+    X_plain.reset();
+    X_carry.reset();
+    X_into.reset();
+
+    CarriedMetrics carry, carry_into;
+    StateEnvelope  env;
+
+    for (std::uint64_t i = 0; i < 4000; ++i)
+    {
+        const StructEvent E = event_at(i);
+
+        // FMRT_StepInPlace with and without carry
+        DerivedMetrics  m_plain, m_carry;
+        InvariantStatus s_plain, s_carry;
+        ErrorCategory   c_plain, c_carry;
+
+        const StepStatus st_plain = FMRT_StepInPlace(X_plain, E, &m_plain, &s_plain, &c_plain);
+        const StepStatus st_carry = FMRT_StepInPlace(X_carry, E, carry, &m_carry, &s_carry, &c_carry);
+
+        // FMRT_StepInto with carry against FMRT_Step
+        const StateEnvelope ref = FMRT_Step(X_into, E);
+        FMRT_StepInto(X_into, E, env, carry_into);
+
+        if (st_plain != st_carry || c_plain != c_carry ||
+            !same_state(X_plain, X_carry) ||
+            !same_bits(m_plain.curvature_R, m_carry.curvature_R) ||
+            !same_bits(m_plain.tau, m_carry.tau) ||
+            !same_bits(m_plain.mu, m_carry.mu) ||
+            m_plain.regime != m_carry.regime ||
+            s_plain.flags != s_carry.flags ||
+            !same_envelope(ref, env))
+        {
+            std::cerr << "carried_metrics FAILED: step " << i << "\n";
+            return 1;
+        }
+        X_into = env.state;
+
+        // edit the state behind the cache's back now and then
+        if (i % 97 == 0)
+        {
+            X_plain.Delta[2] += 0.125;
+            X_carry.Delta[2] += 0.125;
+            X_into.Delta[2]  += 0.125;
+        }
+    }
+
+    // the cache describes the state produced by an accepted step
+    StructuralState X;
+    X.reset();
+    CarriedMetrics c;
+    StructEvent E{};
+    E.type     = EventType::Update;
+    E.dt       = 0.1;
+    E.stimulus = {0.2, -0.1, 0.0, 0.3};
+
+    if (FMRT_StepInPlace(X, E, c) != StepStatus::OK || !c.matches(X))
+    {
+        std::cerr << "carried_metrics FAILED: carry not bound to X(t+1)\n";
+        return 1;
+    }
+
+    // a foreign state is never served from the cache
+    StructuralState other = X;
+    other.Delta[3] = -other.Delta[3] + 1.0;
+    if (c.matches(other))
+    {
+        std::cerr << "carried_metrics FAILED: foreign state matched\n";
+        return 1;
+    }
+
+    // Δ components that differ only in bits a rotate-and-XOR fold could
+    // cancel (sign of Δ0 against bit 50 of Δ1) still miss
+    StructuralState Y = X;
+    Y.Delta[0] = 1.0;
+    Y.Delta[1] = 1.0;
+    c.bind(Y);
+    StructuralState Z = Y;
+    Z.Delta[0] = -1.0;
+    Z.Delta[1] = 1.25;
+    if (!c.matches(Y) || c.matches(Z))
+    {
+        std::cerr << "carried_metrics FAILED: distinct Δ matched\n";
+        return 1;
+    }
+
+    std::cout << "carried_metrics OK\n";
+    return 0;
+}
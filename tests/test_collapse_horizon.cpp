@@ -0,0 +1,163 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+#include "fmrt_api.hpp"
+
+using namespace fmrt;
+
+static StructuralState make_state(std::array<double, DELTA_DIM> d, double phi, double m,
+                                  double kappa)
+{
+    StructuralState X;
+    X.reset();
+    X.Delta = d;
+    X.Phi   = phi;
+    X.M     = m;
+    X.Kappa = kappa;
+    return X;
+}
+
+static StructEvent make_event(EventType type, double dt, std::array<double, DELTA_DIM> s = {})
+{
+    StructEvent E{};
+    E.type     = type;
+    E.dt       = dt;
+    E.stimulus = s;
+    return E;
+}
+
+// first step (1-based) whose envelope reports collapse; 0 on a rejected step
+static std::uint64_t simulate(StructuralState X, const StructEvent& E, std::uint64_t cap)
+{
+    for (std::uint64_t j = 1; j <= cap; ++j)
+    {
+        const StateEnvelope env = FMRT_Step(X, E);
+        if (env.status != StepStatus::OK)
+            return 0;
+        if (env.metrics.is_collapse)
+            return j;
+        X = env.state;
+    }
+    return 0;
+}
+
+static int check_exact(const char* name, const StructuralState& X, const StructEvent& E)
+{
+    const CollapseHorizon H = FMRT_CollapseHorizon(X, E);
+    const std::uint64_t   j = simulate(X, E, 2000000);
+
+    if (j == 0 || H.status != StepStatus::OK || !H.exact ||
+        H.steps_min != j || H.steps_max != j ||
+        H.time_min != static_cast<double>(j) * E.dt)
+    {
+        std::cerr << "collapse_horizon FAILED: " << name << " expected " << j
+                  << " got [" << H.steps_min << ", " << H.steps_max << "]\n";
+        return 1;
+    }
+    return 0;
+}
+
+static int check_bounds(const char* name, const StructuralState& X, const StructEvent& E)
+{
+    const CollapseHorizon H = FMRT_CollapseHorizon(X, E);
+    const std::uint64_t   j = simulate(X, E, 2000000);
+
+    if (j == 0 || H.status != StepStatus::OK || H.exact ||
+        !(H.steps_min <= j && j <= H.steps_max) ||
+        !(H.time_min <= H.time_max))
+    {
+        std::cerr << "collapse_horizon FAILED: " << name << " step " << j
+                  << " outside [" << H.steps_min << ", " << H.steps_max << "]\n";
+        return 1;
+    }
+    return 0;
+}
+
+int test_collapse_horizon()
+{
+    std::cout << "Running collapse_horizon...\n";
+
+    const StructuralState idle = make_state({0.4, -0.2, 0.1, 0.3}, 0.5, 0.2, 1.0);
+
+    // stimulus-free: exact
+    if (check_exact("heartbeat_dt1",   idle, make_event(EventType::Heartbeat, 1.0))  != 0) return 1;
+    if (check_exact("gap_dt037",       idle, make_event(EventType::Gap, 0.37))       != 0) return 1;
+    if (check_exact("gap_small_dt",
+                    make_state({}, 0.0, 0.0, 0.3), make_event(EventType::Gap, 0.01)) != 0) return 1;
+    if (check_exact("heartbeat_large_dt",
+                    idle, make_event(EventType::Heartbeat, 333.0))                    != 0) return 1;
+    if (check_exact("one_step",
+                    make_state({}, 0.0, 0.0, 0.5), make_event(EventType::Gap, 1e3))   != 0) return 1;
+    if (check_exact("near_threshold",
+                    make_state({}, 0.0, 0.0, 3e-12), make_event(EventType::Gap, 1e-9)) != 0) return 1;
+
+    // constant stimulus: bounds
+    if (check_bounds("update_small", idle,
+                     make_event(EventType::Update, 0.1, {0.01, 0.0, -0.01, 0.0}))  != 0) return 1;
+    if (check_bounds("update_medium", idle,
+                     make_event(EventType::Update, 0.5, {0.3, -0.2, 0.1, 0.0}))    != 0) return 1;
+    if (check_bounds("update_high", make_state({2.0, 2.0, 0.0, 0.0}, 3.0, 5.0, 0.8),
+                     make_event(EventType::Update, 0.2, {4.0, -3.0, 2.0, 1.0}))    != 0) return 1;
+
+    // already collapsed
+    const CollapseHorizon done =
+        FMRT_CollapseHorizon(make_state({}, 0.0, 0.0, 0.0), make_event(EventType::Gap, 1.0));
+    if (!done.exact || done.steps_min != 0 || done.steps_max != 0)
+    {
+        std::cerr << "collapse_horizon FAILED: collapsed state\n";
+        return 1;
+    }
+
+    // RESET never collapses
+    const CollapseHorizon reset = FMRT_CollapseHorizon(idle, make_event(EventType::Reset, 0.0));
+    if (reset.steps_max != CollapseHorizon::NEVER ||
+        reset.time_max  != std::numeric_limits<double>::infinity())
+    {
+        std::cerr << "collapse_horizon FAILED: reset\n";
+        return 1;
+    }
+
+    // rejected inputs
+    if (FMRT_CollapseHorizon(idle, make_event(EventType::Gap, -1.0)).error_category
+            != ErrorCategory::InvalidEvent ||
+        FMRT_CollapseHorizon(make_state({}, NAN, 0.0, 1.0),
+                             make_event(EventType::Gap, 1.0)).error_category
+            != ErrorCategory::NumericError)
+    {
+        std::cerr << "collapse_horizon FAILED: rejected inputs\n";
+        return 1;
+    }
+
+    // batch == scalar
+    double d[DELTA_DIM][3] = {{0.4, 0.0, 2.0}, {-0.2, 0.0, 2.0}, {0.1, 0.0, 0.0}, {0.3, 0.0, 0.0}};
+    double phi[3] = {0.5, 0.0, 3.0}, m[3] = {0.2, 0.0, 5.0}, kappa[3] = {1.0, 0.3, 0.8};
+    Regime prev[3] = {Regime::ACC, Regime::ACC, Regime::ACC};
+
+    StateColumns cols;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) cols.Delta[k] = d[k];
+    cols.Phi = phi; cols.M = m; cols.Kappa = kappa; cols.RegimePrev = prev;
+
+    const StructEvent events[3] = {
+        make_event(EventType::Heartbeat, 1.0),
+        make_event(EventType::Gap, 0.01),
+        make_event(EventType::Update, 0.2, {4.0, -3.0, 2.0, 1.0}),
+    };
+
+    CollapseHorizon batch[3];
+    FMRT_CollapseHorizonBatch(cols, events, 3, batch);
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const CollapseHorizon ref = FMRT_CollapseHorizon(cols.load(i), events[i]);
+        if (batch[i].steps_min != ref.steps_min || batch[i].steps_max != ref.steps_max)
+        {
+            std::cerr << "collapse_horizon FAILED: batch lane " << i << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "collapse_horizon OK\n";
+    return 0;
+}
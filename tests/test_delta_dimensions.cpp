@@ -0,0 +1,176 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// Every Δ dimension must reproduce the 4-dim trajectory bit for bit when the
+// extra components are zero: they only add exact zeros to every reduction.
+
+template <std::size_t N>
+static bool same_as_base(const StateEnvelopeT<N>& wide, const StateEnvelope& base)
+{
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        if (!same_bits(wide.state.Delta[k], base.state.Delta[k])) return false;
+
+    for (std::size_t k = DELTA_DIM; k < N; ++k)
+        if (wide.state.Delta[k] != 0.0) return false;
+
+    return same_bits(wide.state.Phi, base.state.Phi) &&
+           same_bits(wide.state.M, base.state.M) &&
+           same_bits(wide.state.Kappa, base.state.Kappa) &&
+           wide.state.RegimePrev == base.state.RegimePrev &&
+           same_bits(wide.metrics.curvature_R, base.metrics.curvature_R) &&
+           same_bits(wide.metrics.tau, base.metrics.tau) &&
+           same_bits(wide.metrics.mu, base.metrics.mu) &&
+           wide.metrics.regime == base.metrics.regime &&
+           wide.invariants.flags == base.invariants.flags &&
+           wide.status == base.status &&
+           wide.error_category == base.error_category;
+}
+
+template <std::size_t N>
+static StructuralStateT<N> widen(const StructuralState& X)
+{
+    StructuralStateT<N> W;
+    W.reset();
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) W.Delta[k] = X.Delta[k];
+    W.Phi        = X.Phi;
+    W.M          = X.M;
+    W.Kappa      = X.Kappa;
+    W.RegimePrev = X.RegimePrev;
+    return W;
+}
+
+template <std::size_t N>
+static StructEventT<N> widen(const StructEvent& E)
+{
+    StructEventT<N> W{};
+    W.type = E.type;
+    W.dt   = E.dt;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) W.stimulus[k] = E.stimulus[k];
+    return W;
+}
+
+static StructEvent make_event(int step)
+{
+    StructEvent E{};
+    const int kind = step % 5;
+    E.type = (kind < 3) ? EventType::Update
+           : (kind == 3) ? EventType::Gap
+           : EventType::Heartbeat;
+    E.dt = 0.1 + 0.05 * (step % 7);
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        E.stimulus[k] = 0.5 * static_cast<double>((step + 1) * (k % 2 ? -1 : 1)) / (1.0 + k);
+    return E;
+}
+
+template <std::size_t N>
+static int run_scalar(const StructuralState& start)
+{
+    StructuralState     X = start;
+    StructuralStateT<N> W = widen<N>(start);
+
+    for (int step = 0; step < 60; ++step)
+    {
+        const StructEvent E = make_event(step);
+
+        const StateEnvelope     base = FMRT_Step(X, E);
+        const StateEnvelopeT<N> wide = FMRT_Step(W, widen<N>(E));
+
+        if (!same_as_base(wide, base))
+        {
+            std::cerr << "delta_dimensions FAILED: N=" << N << " step " << step << "\n";
+            return 1;
+        }
+
+        X = base.state;
+        W = wide.state;
+    }
+    return 0;
+}
+
+template <std::size_t N>
+static int run_batch(const StructuralState& start)
+{
+    const std::size_t count = 11;   // exercises full lanes and the scalar tail
+
+    std::vector<double> cols[N];
+    std::vector<double> phi(count), m(count), kappa(count);
+    std::vector<Regime> prev(count);
+    for (auto& c : cols) c.resize(count);
+
+    StateColumnsT<N> C;
+    for (std::size_t k = 0; k < N; ++k) C.Delta[k] = cols[k].data();
+    C.Phi        = phi.data();
+    C.M          = m.data();
+    C.Kappa      = kappa.data();
+    C.RegimePrev = prev.data();
+
+    std::vector<StructuralState> ref(count, start);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ref[i].Kappa = start.Kappa * (1.0 + 0.1 * static_cast<double>(i));
+        C.store(i, widen<N>(ref[i]));
+    }
+
+    std::vector<StepStatus> status(count);
+    EnvelopeColumns out;
+    out.status = status.data();
+
+    std::vector<StructEventT<N>> events(count);
+
+    for (int step = 0; step < 30; ++step)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            events[i] = widen<N>(make_event(step + static_cast<int>(i)));
+
+        FMRT_StepBatch(C, events.data(), count, C, out);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const StateEnvelope base =
+                FMRT_Step(ref[i], make_event(step + static_cast<int>(i)));
+
+            StateEnvelopeT<N> wide;
+            wide.state          = C.load(i);
+            wide.metrics        = base.metrics;
+            wide.invariants     = base.invariants;
+            wide.status         = status[i];
+            wide.error_category = base.error_category;
+
+            if (!same_as_base(wide, base))
+            {
+                std::cerr << "delta_dimensions FAILED: batch N=" << N
+                          << " organism " << i << " step " << step << "\n";
+                return 1;
+            }
+            ref[i] = base.state;
+        }
+    }
+    return 0;
+}
+
+int test_delta_dimensions()
+{
+    std::cout << "Running delta_dimensions...\n";
+
+    StructuralState start;
+    start.reset();
+    start.Delta = {0.4, -0.2, 0.1, 0.3};
+    start.Phi   = 2.0;
+    start.M     = 1.5;
+    start.Kappa = 0.8;
+
+    if (run_scalar<8>(start)  != 0) return 1;
+    if (run_scalar<16>(start) != 0) return 1;
+    if (run_scalar<64>(start) != 0) return 1;
+    if (run_batch<8>(start)   != 0) return 1;
+    if (run_batch<64>(start)  != 0) return 1;
+
+    std::cout << "delta_dimensions OK\n";
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "internal/det_exp.hpp"
+
+using namespace fmrt;
+
+// ---------------------------------------------------------------------------
+// Double-double reference exp (~100 bits; needs -ffp-contract=off)
+// ---------------------------------------------------------------------------
+namespace
+{
+    struct DD { double hi, lo; };
+
+    DD quick_two_sum(double a, double b)
+    {
+        const double s = a + b;
+        return { s, b - (s - a) };
+    }
+
+    DD two_sum(double a, double b)
+    {
+        const double s  = a + b;
+        const double bb = s - a;
+        return { s, (a - (s - bb)) + (b - bb) };
+    }
+
+    void split(double a, double& hi, double& lo)
+    {
+        const double c = 134217729.0 * a;          // 2^27 + 1
+        hi = c - (c - a);
+        lo = a - hi;
+    }
+
+    DD two_prod(double a, double b)
+    {
+        const double p = a * b;
+        double ah, al, bh, bl;
+        split(a, ah, al);
+        split(b, bh, bl);
+        return { p, ((ah * bh - p) + ah * bl + al * bh) + al * bl };
+    }
+
+    DD add(DD a, DD b)
+    {
+        const DD s = two_sum(a.hi, b.hi);
+        return quick_two_sum(s.hi, s.lo + a.lo + b.lo);
+    }
+
+    DD mul(DD a, DD b)
+    {
+        const DD p = two_prod(a.hi, b.hi);
+        return quick_two_sum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+    }
+
+    DD div(DD a, double n)
+    {
+        const double q1 = a.hi / n;
+        const DD     p  = two_prod(q1, n);
+        const double r  = ((a.hi - p.hi) - p.lo) + a.lo;
+        return quick_two_sum(q1, r / n);
+    }
+
+    // exp(x) = 2^k · exp(r)^(2^10),  r = (x − k·ln2) / 2^10
+    DD reference_exp_scaled(double x, int& k)
+    {
+        const DD LN2 = { 0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56 };
+
+        const double kd = std::nearbyint(x / LN2.hi);
+        k = static_cast<int>(kd);
+
+        const DD kl = add(two_prod(kd, LN2.hi), two_prod(kd, LN2.lo));
+        DD r = add(DD{ x, 0.0 }, DD{ -kl.hi, -kl.lo });
+        r.hi = std::ldexp(r.hi, -10);
+        r.lo = std::ldexp(r.lo, -10);
+
+        DD p = { 1.0, 0.0 };
+        for (int n = 14; n >= 1; --n)
+            p = add(DD{ 1.0, 0.0 }, div(mul(r, p), static_cast<double>(n)));
+
+        for (int i = 0; i < 10; ++i)
+            p = mul(p, p);
+
+        return p;
+    }
+
+    // |detExp(x) − exp(x)| in ulps of the correctly rounded result
+    double ulp_error(double x)
+    {
+        int k = 0;
+        const DD ref = reference_exp_scaled(x, k);
+        const double y = detExp(x);
+
+        int e = 0;
+        std::frexp(ref.hi, &e);                     // ref.hi in [2^(e-1), 2^e)
+        const int ulp_exp = std::max(e - 53 + k, -1074) - k;
+
+        const double y_scaled = std::ldexp(y, -k);  // exact
+        const double diff     = (y_scaled - ref.hi) - ref.lo;
+        return std::fabs(diff) / std::ldexp(1.0, ulp_exp);
+    }
+
+    std::uint64_t bits(double x)
+    {
+        std::uint64_t b;
+        std::memcpy(&b, &x, sizeof(double));
+        return b;
+    }
+
+    // deterministic sample stream
+    struct Lcg
+    {
+        std::uint64_t s = 0x9E3779B97F4A7C15ULL;
+        double next()
+        {
+            s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<double>(s >> 11) * 0x1p-53;      // [0, 1)
+        }
+    };
+}
+
+int test_det_exp()
+{
+    std::cout << "Running det_exp...\n";
+
+    double max_err = 0.0;
+    double worst_x = 0.0;
+
+    auto probe = [&](double x)
+    {
+        const double err = ulp_error(x);
+        if (!(err <= max_err)) { max_err = err; worst_x = x; }
+    };
+
+    Lcg rng;
+
+    // whole domain, engine domain (−λκ, −c2·R), near zero
+    for (int i = 0; i < (1 << 18); ++i)
+        probe(detexp::EXP_UNDERFLOW + rng.next() * (detexp::EXP_OVERFLOW - detexp::EXP_UNDERFLOW));
+    for (int i = 0; i < (1 << 18); ++i)
+        probe(-40.0 * rng.next());
+    for (int i = 0; i < (1 << 15); ++i)
+        probe((rng.next() - 0.5) * 1e-3);
+
+    // around the reduction boundaries (k·ln2 ± ln2/2) and both ends
+    for (int k = -1075; k <= 1024; ++k)
+    {
+        const double b = (k + 0.5) * 0x1.62e42fefa39efp-1;
+        for (int d = -4; d <= 4; ++d)
+        {
+            const double x = b + d * std::ldexp(std::fabs(b) + 1.0, -50);
+            if (x >= detexp::EXP_UNDERFLOW && x <= detexp::EXP_OVERFLOW)
+                probe(x);
+        }
+    }
+    for (int d = 0; d < 64; ++d)
+    {
+        probe(std::nextafter(detexp::EXP_OVERFLOW, 0.0) - d * 1e-13);
+        probe(detexp::EXP_UNDERFLOW + d * 1e-13);
+        probe(std::ldexp(1.0, -d - 20));
+        probe(-std::ldexp(1.0, -d - 20));
+    }
+
+    if (!(max_err < 1.0))
+    {
+        std::cerr << "det_exp FAILED: " << max_err << " ulp at x = " << worst_x << "\n";
+        return 1;
+    }
+
+    // special values
+    const double inf = std::numeric_limits<double>::infinity();
+    if (detExp(0.0) != 1.0 || detExp(-0.0) != 1.0 ||
+        detExp(inf) != inf || detExp(-inf) != 0.0 ||
+        detExp(710.0) != inf || detExp(-746.0) != 0.0 ||
+        !std::isnan(detExp(std::numeric_limits<double>::quiet_NaN())))
+    {
+        std::cerr << "det_exp FAILED: special values\n";
+        return 1;
+    }
+
+    // fixed bit patterns: identical on every conforming toolchain
+    struct Golden { double x; std::uint64_t y; };
+    const Golden golden[] = {
+        {  1.0,     0x4005BF0A8B14576AULL },
+        { -1.0,     0x3FD78B56362CEF38ULL },
+        { -0.5,     0x3FE368B2FC6F960AULL },
+        { -12.375,  0x3ED1B64085373070ULL },
+        {  300.25,  0x5B01FDA3EAEB3D0EULL },
+        { -740.0,   0x0000000000000055ULL },
+    };
+    for (const Golden& g : golden)
+    {
+        if (bits(detExp(g.x)) != g.y)
+        {
+            std::cerr << "det_exp FAILED: golden value at x = " << g.x << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "det_exp OK (max error " << max_err << " ulp)\n";
+    return 0;
+}
@@ -0,0 +1,302 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_event_log.hpp"
+#include "fmrt_workload.hpp"
+
+using namespace fmrt;
+
+static bool same_fleet_event(const FleetEvent& a, const FleetEvent& b)
+{
+    return a.id == b.id && a.type == b.type &&
+           std::memcmp(&a.dt, &b.dt, sizeof(double)) == 0 &&
+           std::memcmp(a.stimulus, b.stimulus, sizeof(a.stimulus)) == 0;
+}
+
+// GAP / HEARTBEAT / RESET records carry no stimulus
+static FleetEvent stored_form(FleetEvent e)
+{
+    if (e.type != EventType::Update)
+        for (double& v : e.stimulus) v = 0.0;
+    return e;
+}
+
+// reads the whole log; false on any mismatch against (time, events)
+static bool read_back(const std::string& path, const std::vector<std::int64_t>& time,
+                      const std::vector<FleetEvent>& events, const char* what)
+{
+    EventLogReader reader;
+    if (!reader.open(path.c_str()))
+    {
+        std::cerr << "event_log(" << what << "): open failed: " << reader.error() << "\n";
+        return false;
+    }
+    if (reader.records() != events.size() || reader.truncated())
+    {
+        std::cerr << "event_log(" << what << "): " << reader.records() << " records, expected "
+                  << events.size() << "\n";
+        return false;
+    }
+
+    EventLogCursor     c = reader.cursor();
+    EventLogRecordView r;
+    std::size_t        j = 0;
+    EventLogStatus     st;
+
+    while ((st = c.next(r)) == EventLogStatus::Ok)
+    {
+        if (j >= events.size() || r.time() != time[j] ||
+            !same_fleet_event(r.fleetEvent(), stored_form(events[j])) ||
+            r.event().type != events[j].type)
+        {
+            std::cerr << "event_log(" << what << "): record " << j << " differs\n";
+            return false;
+        }
+        ++j;
+    }
+
+    if (st != EventLogStatus::End || j != events.size())
+    {
+        std::cerr << "event_log(" << what << "): cursor stopped at " << j << " (status "
+                  << static_cast<int>(st) << ")\n";
+        return false;
+    }
+    return true;
+}
+
+int test_event_log()
+{
+    std::cout << "Running event_log...\n";
+
+    // CRC-32C check value
+    if (crc32c("123456789", 9) != 0xE3069283u)
+    {
+        std::cerr << "event_log: crc32c check value mismatch\n";
+        return 1;
+    }
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "fmrt_test_event_log.bin").string();
+    std::filesystem::remove(path);
+
+    // --- a workload stream with timestamp jumps --------------------------------
+    WorkloadConfig wc;
+    wc.seed = 99;
+    const MarketWorkload w(wc);
+
+    constexpr std::size_t N = 5000;
+    std::vector<FleetEvent>   events(N);
+    std::vector<std::int64_t> time(N);
+
+    std::int64_t t = 1'700'000'000'000'000'000;
+    for (std::size_t j = 0; j < N; ++j)
+    {
+        w.generate(static_cast<OrganismId>(j % 37), j / 37, 1, &events[j]);
+
+        t += static_cast<std::int64_t>(events[j].dt * 1e9);
+        if (j == 1000) t += std::int64_t{1} << 33;      // delta > 2^32: new block
+        if (j == 2000) t -= 5'000'000'000;              // clock stepped back: new block
+        time[j] = t;
+    }
+    events[10].type = EventType::Reset;
+
+    EventLogOptions opt;
+    opt.block_records = 512;
+    opt.flush_bytes   = 4096;
+
+    {
+        EventLogWriter wr;
+        if (!wr.open(path.c_str(), opt) ||
+            !wr.append(time.data(), events.data(), 3000) ||
+            !wr.close())
+        {
+            std::cerr << "event_log: write failed: " << wr.error() << "\n";
+            return 1;
+        }
+    }
+
+    // --- append to the existing log ------------------------------------------
+    {
+        EventLogWriter wr;
+        if (!wr.open(path.c_str(), opt) || wr.records() != 3000)
+        {
+            std::cerr << "event_log: reopen for append failed: " << wr.error() << "\n";
+            return 1;
+        }
+        for (std::size_t j = 3000; j < N; ++j)
+            if (!wr.append(time[j], events[j]))
+            {
+                std::cerr << "event_log: append failed: " << wr.error() << "\n";
+                return 1;
+            }
+    }   // destructor seals and flushes
+
+    if (!read_back(path, time, events, "round trip"))
+        return 1;
+
+    // --- blocks: split on size and on timestamp jumps; partial ranges -----------
+    {
+        EventLogReader reader;
+        reader.open(path.c_str());
+
+        std::uint64_t expect_first = 0;
+        int           jump_splits  = 0;
+        for (std::size_t b = 0; b < reader.blocks(); ++b)
+        {
+            const EventLogBlockHeader& h = reader.blockHeader(b);
+            if (h.first_record != expect_first || h.records > opt.block_records)
+            {
+                std::cerr << "event_log: block " << b << " header is inconsistent\n";
+                return 1;
+            }
+            jump_splits += (h.first_record == 1000) + (h.first_record == 2000);
+            expect_first += h.records;
+        }
+        if (jump_splits != 2)
+        {
+            std::cerr << "event_log: timestamp jumps did not start new blocks\n";
+            return 1;
+        }
+
+        const std::size_t  mid = reader.blocks() / 2;
+        EventLogCursor     c   = reader.cursor(mid, mid + 1);
+        EventLogRecordView r;
+        std::size_t        n   = 0;
+        std::uint64_t      j   = reader.blockHeader(mid).first_record;
+        while (c.next(r) == EventLogStatus::Ok)
+        {
+            if (r.time() != time[j] || !same_fleet_event(r.fleetEvent(), stored_form(events[j])))
+            {
+                std::cerr << "event_log: block range read differs\n";
+                return 1;
+            }
+            ++n;
+            ++j;
+        }
+        if (n != reader.blockHeader(mid).records)
+        {
+            std::cerr << "event_log: block range produced " << n << " records\n";
+            return 1;
+        }
+    }
+
+    const std::uintmax_t full = std::filesystem::file_size(path);
+
+    // --- a flipped payload byte is reported as Corrupt ----------------------
+    {
+        std::vector<unsigned char> bytes(full);
+        {
+            std::FILE* f = std::fopen(path.c_str(), "rb");
+            std::fread(bytes.data(), 1, bytes.size(), f);
+            std::fclose(f);
+        }
+        const std::string bad = path + ".corrupt";
+        bytes[sizeof(EventLogFileHeader) + sizeof(EventLogBlockHeader) + 17] ^= 0x40;
+        {
+            std::FILE* f = std::fopen(bad.c_str(), "wb");
+            std::fwrite(bytes.data(), 1, bytes.size(), f);
+            std::fclose(f);
+        }
+
+        EventLogReader reader;
+        reader.open(bad.c_str());
+
+        EventLogRecordView r;
+        EventLogCursor     c  = reader.cursor();
+        if (c.next(r) != EventLogStatus::Corrupt || c.block() != 0)
+        {
+            std::cerr << "event_log: corrupted block not detected\n";
+            return 1;
+        }
+
+        EventLogCursor raw = reader.cursor(false);      // unverified: readable
+        if (raw.next(r) != EventLogStatus::Ok)
+        {
+            std::cerr << "event_log: unverified cursor failed\n";
+            return 1;
+        }
+        std::filesystem::remove(bad);
+    }
+
+    // --- a bad block header before the tail: append refused, file kept ------
+    {
+        EventLogReader reader;
+        reader.open(path.c_str());
+        const long second = static_cast<long>(sizeof(EventLogFileHeader) + sizeof(EventLogBlockHeader) +
+                                              reader.blockHeader(0).payload_bytes);
+        reader.close();
+
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, second, SEEK_SET);
+        std::fwrite("XXXX", 1, 4, f);
+        std::fclose(f);
+
+        EventLogWriter wr;
+        if (wr.open(path.c_str(), opt) || std::filesystem::file_size(path) != full)
+        {
+            std::cerr << "event_log: append over a corrupt block header was not refused\n";
+            return 1;
+        }
+
+        const std::uint32_t magic = EVENT_LOG_BLOCK_MAGIC;
+        f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, second, SEEK_SET);
+        std::fwrite(&magic, sizeof(magic), 1, f);
+        std::fclose(f);
+    }
+
+    // --- torn tail: reader ignores it, writer truncates and continues --------
+    {
+        std::filesystem::resize_file(path, full - 100);
+
+        EventLogReader reader;
+        if (!reader.open(path.c_str()) || !reader.truncated() || reader.records() >= N)
+        {
+            std::cerr << "event_log: torn tail not reported\n";
+            return 1;
+        }
+        const std::uint64_t kept = reader.records();
+        reader.close();
+
+        EventLogWriter wr;
+        if (!wr.open(path.c_str(), opt) || wr.records() != kept ||
+            wr.droppedBytes() == 0 ||
+            std::filesystem::file_size(path) + wr.droppedBytes() != full - 100)
+        {
+            std::cerr << "event_log: append after a torn tail failed\n";
+            return 1;
+        }
+        for (std::size_t j = kept; j < N; ++j)
+            wr.append(time[j], events[j]);
+        wr.close();
+
+        if (!read_back(path, time, events, "after torn tail"))
+            return 1;
+    }
+
+    // --- wrong files are refused ---------------------------------------------
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fwrite("NOTALOG!", 1, 8, f);
+        std::fclose(f);
+
+        EventLogReader reader;
+        EventLogWriter wr;
+        if (reader.open(path.c_str()) || wr.open(path.c_str()))
+        {
+            std::cerr << "event_log: foreign file accepted\n";
+            return 1;
+        }
+    }
+
+    std::filesystem::remove(path);
+
+    std::cout << "event_log OK\n";
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// the event organism i is meant to receive
+static StructEvent scaled(const StructEvent& E, double beta)
+{
+    StructEvent Ei = E;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        Ei.stimulus[k] = beta * E.stimulus[k];
+    return Ei;
+}
+
+// shock of round r: mostly market updates, plus the other kinds
+static StructEvent shock_at(std::size_t r)
+{
+    StructEvent E{};
+    E.type = EventType::Update;
+    E.dt   = 0.02 + 0.04 * static_cast<double>(r % 5);
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        E.stimulus[k] = uniform(mix(r * 16 + k), -3.0, 3.0);
+    E.stimulus[DELTA_DIM - 1] = 0.0;            // ±0 products
+
+    switch (r % 13)
+    {
+        case 4:  E.type = EventType::Gap;   break;
+        case 6:  E.dt = -0.5;               break;  // rejected
+        case 8:  E.stimulus[0] = std::numeric_limits<double>::quiet_NaN(); break;
+        case 12: E.type = EventType::Reset; break;
+        default: break;
+    }
+    return E;
+}
+
+// --- FMRT_StepFactorBroadcast(InPlace) against FMRT_Step(InPlace) -----------
+static int check_columns(bool in_place)
+{
+    const std::size_t N = 203;                  // not a multiple of any lane width
+
+    std::vector<StructuralState> ref(N);
+    std::vector<double>          beta(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        StructuralState& X = ref[i];
+        X.reset();
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            X.Delta[k] = uniform(mix(i * 8 + k), -8.0, 8.0);
+        X.Phi   = uniform(mix(i ^ 0x100), 0.0, 20.0);
+        X.M     = uniform(mix(i ^ 0x200), 0.0, 50.0);
+        X.Kappa = uniform(mix(i ^ 0x300), 0.2, 1.2);
+
+        beta[i] = uniform(mix(i ^ 0x400), -1.5, 2.5);
+    }
+
+    ref[3].Kappa = 0.0;                         // collapsed
+    ref[5].Phi   = 1e-320;                      // denormal state
+    beta[7]  = 0.0;
+    beta[8]  = -0.0;
+    beta[9]  = 1e308;                           // product overflows → rejected
+    beta[10] = 1e-310;                          // subnormal product → rejected
+    beta[11] = std::numeric_limits<double>::quiet_NaN();
+    beta[12] = std::numeric_limits<double>::infinity();
+
+    return check_column_kernel("factor_broadcast", ref, 52, in_place,
+        [N, &beta](std::size_t r, ColumnFixture& c, bool inp)
+        {
+            if (inp)
+                FMRT_StepFactorBroadcastInPlace(c.X, N, shock_at(r), beta.data(), c.out);
+            else
+                FMRT_StepFactorBroadcast(c.X, N, shock_at(r), beta.data(), c.X, c.out);
+        },
+        [&beta](std::size_t r, std::size_t i) { return scaled(shock_at(r), beta[i]); });
+}
+
+// --- Fleet::broadcast(E, loading) against submitting scaled events -----------
+static int check_fleet(LifecyclePolicy policy, const char* name)
+{
+    constexpr std::size_t ORGANISMS = 400;
+
+    FleetConfig cfg;
+    cfg.threads   = 3;
+    cfg.shards    = 7;
+    cfg.lifecycle = policy;
+
+    std::vector<double> beta(ORGANISMS);
+    for (std::size_t i = 0; i < ORGANISMS; ++i)
+        beta[i] = uniform(mix(i ^ 0x77), -1.0, 3.0);
+    beta[10] = std::numeric_limits<double>::quiet_NaN();   // numeric reject per event
+
+    return check_fleet_pair("factor_broadcast", name, cfg, ORGANISMS, 39,
+        [](std::size_t i)
+        {
+            StructuralState X;
+            X.reset();
+            X.Kappa = (i % 3 == 0) ? 0.9 : 0.002 * static_cast<double>(i % 7 + 1);  // fragile ones collapse
+            if (i == 6)
+                X.Phi = 1e-320;                 // every step is a numeric reject
+            return X;
+        },
+        [&beta](std::size_t r, Fleet& fast, Fleet& slow)
+        {
+            const StructEvent E = shock_at(r);
+
+            fast.broadcast(E, beta.data());
+
+            for (std::size_t i = 0; i < ORGANISMS; ++i)
+                slow.submit(static_cast<OrganismId>(i), scaled(E, beta[i]));
+            slow.run();
+        });
+}
+
+// --- the single-event kernel is faster in every FMRT_SIMD build -------------
+static int check_speed()
+{
+    constexpr std::size_t N = 2048;
+
+    ColumnFixture       fast(N), slow(N);
+    std::vector<double> beta(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        StructuralState X;
+        X.reset();
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            X.Delta[k] = uniform(mix(i * 8 + k), -5.0, 5.0);
+        X.Kappa = 1e6;                          // stays alive over the repetitions
+        fast.X.store(i, X);
+        slow.X.store(i, X);
+
+        beta[i] = uniform(mix(i ^ 0x400), -1.5, 2.5);
+    }
+
+    StructEvent E{};
+    E.type = EventType::Update;
+    E.dt   = 1e-6;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        E.stimulus[k] = uniform(mix(k), -3.0, 3.0);
+
+    // the reference builds each organism's event, as a caller without the
+    // factor broadcast would
+    if (!runs_faster([&] { for (int r = 0; r < 5; ++r) FMRT_StepFactorBroadcastInPlace(fast.X, N, E, beta.data(), fast.out); },
+                     [&]
+                     {
+                         for (int r = 0; r < 5; ++r)
+                             step_each_in_place(slow, N, [&](std::size_t i) { return scaled(E, beta[i]); });
+                     }))
+    {
+        std::cerr << "factor_broadcast FAILED: factor broadcast not faster than stepping each organism\n";
+        return 1;
+    }
+    return 0;
+}
+
+int test_factor_broadcast()
+{
+    std::cout << "Running factor_broadcast...\n";
+
+    if (check_columns(false) != 0) return 1;
+    if (check_columns(true) != 0) return 1;
+    if (check_speed() != 0) return 1;
+
+    if (check_fleet(LifecyclePolicy::Keep,   "keep")   != 0) return 1;
+    if (check_fleet(LifecyclePolicy::Freeze, "freeze") != 0) return 1;
+    if (check_fleet(LifecyclePolicy::Evict,  "evict")  != 0) return 1;
+
+    std::cout << "factor_broadcast OK\n";
+    return 0;
+}
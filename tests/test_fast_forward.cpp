@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "fmrt_api.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+static bool close(double a, double b)
+{
+    if (a == b) return true;
+    return std::fabs(a - b) <= 1e-9 * std::max(std::fabs(a), std::fabs(b));
+}
+
+// FMRT_FastForward(X, E, k) against k scalar steps.
+// κ, Φ, regime and status are exact; Δ and M within closed-form rounding.
+static int check_run(const char* name, const StructuralState& X, const StructEvent& E,
+                     std::uint64_t max_k)
+{
+    StructuralState S = X;
+
+    for (std::uint64_t k = 1; k <= max_k; ++k)
+    {
+        const StateEnvelope ref = FMRT_Step(S, E);
+        S = ref.state;
+
+        if (k > 64 && k % 61 != 0 && k != max_k)
+            continue;
+
+        const StateEnvelope ff = FMRT_FastForward(X, E, k);
+
+        bool ok = ff.status == ref.status &&
+                  ff.error_category == ref.error_category &&
+                  ff.metrics.regime == ref.metrics.regime &&
+                  ff.metrics.morph_class == ref.metrics.morph_class &&
+                  ff.invariants.flags == ref.invariants.flags &&
+                  ff.state.RegimePrev == ref.state.RegimePrev &&
+                  same_bits(ff.state.Kappa, ref.state.Kappa) &&
+                  same_bits(ff.state.Phi, ref.state.Phi) &&
+                  close(ff.state.M, ref.state.M) &&
+                  close(ff.metrics.curvature_R, ref.metrics.curvature_R) &&
+                  close(ff.metrics.tau, ref.metrics.tau);
+
+        for (std::size_t i = 0; i < DELTA_DIM; ++i)
+            ok = ok && close(ff.state.Delta[i], ref.state.Delta[i]);
+
+        if (!ok)
+        {
+            std::cerr << "fast_forward FAILED: " << name << " k=" << k << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static StructuralState make_state(std::array<double, DELTA_DIM> d, double phi, double m,
+                                  double kappa, Regime prev)
+{
+    StructuralState X;
+    X.reset();
+    X.Delta      = d;
+    X.Phi        = phi;
+    X.M          = m;
+    X.Kappa      = kappa;
+    X.RegimePrev = prev;
+    return X;
+}
+
+static StructEvent make_event(EventType type, double dt)
+{
+    StructEvent E{};
+    E.type = type;
+    E.dt   = dt;
+    return E;
+}
+
+int test_fast_forward()
+{
+    std::cout << "Running fast_forward...\n";
+
+    // idle organism: Φ floor, κ binades, collapse
+    if (check_run("heartbeat_to_collapse",
+                  make_state({0.4, -0.2, 0.1, 0.3}, 2.0, 1.5, 0.8, Regime::ACC),
+                  make_event(EventType::Heartbeat, 1.0), 1200) != 0) return 1;
+
+    // small dt, long run
+    if (check_run("gap_small_dt",
+                  make_state({1e-3, 0.0, 0.0, 0.0}, 0.0, 0.0, 1.0, Regime::ACC),
+                  make_event(EventType::Gap, 0.01), 20000) != 0) return 1;
+
+    // high curvature: regime candidate drops → frozen invariant violation
+    if (check_run("regime_freeze",
+                  make_state({3.0, 3.0, 3.0, 3.0}, 3.0, 60.0, 0.7, Regime::ACC),
+                  make_event(EventType::Heartbeat, 0.05), 3000) != 0) return 1;
+
+    // Δ underflows to a subnormal → numeric reject → RESET, then collapse
+    if (check_run("delta_underflow_reset",
+                  make_state({1e-300, -0.2, 0.1, 0.3}, 0.0, 0.0, 3.0, Regime::ACC),
+                  make_event(EventType::Gap, 1.0), 3500) != 0) return 1;
+
+    // oscillating decay (λ·dt > 1) and clipped start
+    if (check_run("oscillating_clipped",
+                  make_state({12.0, 9.0, -9.0, 0.0}, 100.0, 0.0, 0.5, Regime::ACC),
+                  make_event(EventType::Gap, 15.0), 400) != 0) return 1;
+
+    // non-closed-form events are stepped exactly
+    if (check_run("update",
+                  make_state({0.4, -0.2, 0.1, 0.3}, 2.0, 1.5, 0.8, Regime::ACC),
+                  [] { StructEvent E = make_event(EventType::Update, 0.2);
+                       E.stimulus = {0.1, -0.1, 0.05, 0.0}; return E; }(), 300) != 0) return 1;
+
+    if (check_run("invalid_dt",
+                  make_state({0.4, -0.2, 0.1, 0.3}, 2.0, 1.5, 0.8, Regime::ACC),
+                  make_event(EventType::Heartbeat, -1.0), 100) != 0) return 1;
+
+    // k == 0 is rejected, state untouched
+    const StructuralState X = make_state({0.4, -0.2, 0.1, 0.3}, 2.0, 1.5, 0.8, Regime::ACC);
+    const StateEnvelope none = FMRT_FastForward(X, make_event(EventType::Gap, 1.0), 0);
+    if (none.status != StepStatus::ERROR ||
+        none.error_category != ErrorCategory::InvalidEvent ||
+        !same_bits(none.state.Kappa, X.Kappa))
+    {
+        std::cerr << "fast_forward FAILED: k == 0\n";
+        return 1;
+    }
+
+    std::cout << "fast_forward OK\n";
+    return 0;
+}
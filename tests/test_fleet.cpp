@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// deterministic interleaved stream: organism and event mix per index
+static StructEvent event_at(std::uint64_t i)
+{
+    const std::uint64_t h = mix(i);
+
+    StructEvent E{};
+    E.dt = 0.02 + 0.01 * static_cast<double>(h % 13);
+
+    switch ((h >> 8) % 16)
+    {
+        case 0: E.type = EventType::Gap;       break;
+        case 1: E.type = EventType::Heartbeat; break;
+        case 2: E.type = EventType::Reset;     break;
+        case 3:                                 // rejected: NaN stimulus
+            E.type = EventType::Update;
+            E.stimulus[1] = std::numeric_limits<double>::quiet_NaN();
+            break;
+        default:
+            E.type = EventType::Update;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                E.stimulus[k] = 0.25 * static_cast<double>((h >> (16 + 4 * k)) % 11) - 1.0;
+            break;
+    }
+    return E;
+}
+
+// runs `rounds` rounds of `per_round` events over `organisms` organisms and
+// compares every organism against a serial FMRT_StepInPlace loop
+static int check_fleet(const FleetConfig& cfg, std::size_t organisms,
+                       std::size_t rounds, std::size_t per_round, const char* name)
+{
+    Fleet fleet(cfg);
+
+    std::vector<StructuralState> ref(organisms);
+    std::vector<StepStatus>      ref_status(organisms, StepStatus::OK);
+
+    for (std::size_t i = 0; i < organisms; ++i)
+    {
+        ref[i].reset();
+        if (i % 5 == 0)
+            ref[i].Kappa = 0.02;                // collapses early
+
+        if (fleet.add(ref[i]) != static_cast<OrganismId>(i))
+        {
+            std::cerr << "fleet FAILED [" << name << "]: ids not dense\n";
+            return 1;
+        }
+    }
+
+    FleetStats expect;
+    std::uint64_t n = 0;
+
+    for (std::size_t r = 0; r < rounds; ++r)
+    {
+        for (std::size_t j = 0; j < per_round; ++j, ++n)
+        {
+            const OrganismId  id = static_cast<OrganismId>(mix(n ^ 0xABCDu) % organisms);
+            const StructEvent E  = event_at(n);
+
+            if (!fleet.submit(id, E))
+            {
+                std::cerr << "fleet FAILED [" << name << "]: submit rejected\n";
+                return 1;
+            }
+
+            const StepStatus st = FMRT_StepInPlace(ref[id], E);
+            ref_status[id] = st;
+
+            ++expect.steps;
+            if (st == StepStatus::ERROR)
+                ++expect.errors;
+        }
+
+        fleet.run();
+    }
+
+    for (std::size_t i = 0; i < organisms; ++i)
+    {
+        const OrganismId id = static_cast<OrganismId>(i);
+        if (!same_state(fleet.state(id), ref[i]) || fleet.lastStatus(id) != ref_status[i])
+        {
+            std::cerr << "fleet FAILED [" << name << "]: organism " << i
+                      << " differs from the serial loop\n";
+            return 1;
+        }
+    }
+
+    const FleetStats got = fleet.stats();
+    if (got.steps != expect.steps || got.errors != expect.errors || got.dead != 0)
+    {
+        std::cerr << "fleet FAILED [" << name << "]: stats mismatch\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_fleet()
+{
+    std::cout << "Running fleet...\n";
+
+    FleetConfig one;
+    one.threads = 1;
+
+    FleetConfig four;
+    four.threads = 4;
+    four.shards  = 7;                           // uneven ranges
+
+    FleetConfig wide;
+    wide.threads = 6;
+    wide.shards  = 64;                          // shards left empty
+
+    if (check_fleet(one,  257, 4, 5000, "1 thread") != 0) return 1;
+    if (check_fleet(four, 257, 4, 5000, "4 threads") != 0) return 1;
+    if (check_fleet(wide, 3,   3, 200,  "3 organisms") != 0) return 1;
+
+    // unknown organism, empty run
+    Fleet fleet(four);
+    const OrganismId a = fleet.add();
+    StructEvent E{};
+    E.type = EventType::Heartbeat;
+    E.dt   = 0.1;
+
+    if (fleet.submit(a + 1, E))
+    {
+        std::cerr << "fleet FAILED: unknown id accepted\n";
+        return 1;
+    }
+
+    fleet.run();
+    if (fleet.stats().steps != 0 || fleet.size() != 1 || fleet.threads() != 4 || fleet.shards() != 7)
+    {
+        std::cerr << "fleet FAILED: empty run\n";
+        return 1;
+    }
+
+    std::cout << "fleet OK\n";
+    return 0;
+}
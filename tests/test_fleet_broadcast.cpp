@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// broadcast event of round r: mostly ticks, plus the other kinds
+static StructEvent tick_at(std::size_t r)
+{
+    StructEvent E{};
+    E.dt = 0.05 + 0.15 * static_cast<double>(r % 5);
+
+    switch (r % 11)
+    {
+        case 3:  E.type = EventType::Gap;    break;
+        case 5:                                 // stimulus carried by a tick is ignored
+            E.type = EventType::Heartbeat;
+            E.stimulus[0] = 7.0;
+            break;
+        case 7:
+            E.type = EventType::Update;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                E.stimulus[k] = 0.5 * static_cast<double>(k) - 0.6;
+            break;
+        case 8:  E.type = EventType::Heartbeat; E.dt = -1.0; break;    // rejected
+        case 9:                                 // numeric reject
+            E.type = EventType::Gap;
+            E.dt   = std::numeric_limits<double>::quiet_NaN();
+            break;
+        case 10: E.type = EventType::Reset;  break;
+        default: E.type = EventType::Heartbeat; break;
+    }
+    return E;
+}
+
+// --- FMRT_StepBroadcast(InPlace) against FMRT_Step(InPlace) -----------------
+static int check_columns(bool in_place)
+{
+    const std::size_t N = 203;                  // not a multiple of any lane width
+
+    std::vector<StructuralState> ref(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        StructuralState& X = ref[i];
+        X.reset();
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            X.Delta[k] = uniform(mix(i * 8 + k), -12.0, 12.0);
+        X.Phi   = uniform(mix(i ^ 0x100), 0.0, 60.0);
+        X.M     = uniform(mix(i ^ 0x200), 0.0, 100.0);
+        X.Kappa = uniform(mix(i ^ 0x300), 0.0, 1.2);
+        X.RegimePrev = static_cast<Regime>(i % 3);
+    }
+
+    ref[3].Kappa  = 0.0;                        // collapsed
+    ref[5].Kappa  = 2e-12;                      // collapses during the step
+    ref[7].Phi    = 1e-320;                     // denormal → numeric reject
+    ref[9].M      = std::numeric_limits<double>::infinity();
+    ref[11].Delta = {0.0, -0.0, 0.0, -0.0};     // -0.0 + 0·dt is +0.0
+    ref[11].Phi   = 0.0;
+    ref[13].RegimePrev = Regime::REL;           // regime invariant violation
+
+    return check_column_kernel("fleet_broadcast", ref, 44, in_place,
+        [N](std::size_t r, ColumnFixture& c, bool inp)
+        {
+            if (inp)
+                FMRT_StepBroadcastInPlace(c.X, N, tick_at(r), c.out);
+            else
+                FMRT_StepBroadcast(c.X, N, tick_at(r), c.X, c.out);
+        },
+        [](std::size_t r, std::size_t) { return tick_at(r); });
+}
+
+// --- Fleet::broadcast against submitting E to every organism -----------------
+static int check_fleet(LifecyclePolicy policy, std::uint32_t after, const char* name)
+{
+    constexpr std::size_t ORGANISMS = 500;
+
+    FleetConfig cfg;
+    cfg.threads          = 3;
+    cfg.shards           = 7;
+    cfg.lifecycle        = policy;
+    cfg.auto_reset_after = after;
+
+    return check_fleet_pair("fleet_broadcast", name, cfg, ORGANISMS, 40,
+        [](std::size_t i)
+        {
+            StructuralState X;
+            X.reset();
+            X.Kappa = (i % 4 == 0) ? 0.9 : 0.0005 * static_cast<double>(i % 9 + 1);  // fragile ones collapse
+            if (i == 6)
+                X.Phi = 1e-320;                 // every step is a numeric reject
+            return X;
+        },
+        [](std::size_t r, Fleet& fast, Fleet& slow)
+        {
+            // a few queued per-organism events first: they must run before the tick
+            for (std::size_t j = 0; j < 50; ++j)
+            {
+                const std::uint64_t h  = mix(r * 100 + j);
+                const OrganismId    id = static_cast<OrganismId>(h % ORGANISMS);
+
+                StructEvent E{};
+                E.type = EventType::Update;
+                E.dt   = 0.1;
+                for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                    E.stimulus[k] = uniform(mix(h + k), -2.0, 2.0);
+
+                fast.submit(id, E);
+                slow.submit(id, E);
+            }
+
+            const StructEvent T = tick_at(r);
+
+            fast.broadcast(T);
+
+            for (std::size_t i = 0; i < ORGANISMS; ++i)
+                slow.submit(static_cast<OrganismId>(i), T);
+            slow.run();
+        });
+}
+
+// --- the single-event kernel is faster in every FMRT_SIMD build -------------
+static int check_speed()
+{
+    constexpr std::size_t N = 2048;
+
+    ColumnFixture fast(N), slow(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        StructuralState X;
+        X.reset();
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            X.Delta[k] = uniform(mix(i * 8 + k), -5.0, 5.0);
+        X.Kappa = 1e6;                          // stays alive over the repetitions
+        fast.X.store(i, X);
+        slow.X.store(i, X);
+    }
+
+    StructEvent E{};
+    E.type = EventType::Heartbeat;
+    E.dt   = 1e-6;
+
+    if (!runs_faster([&] { for (int r = 0; r < 5; ++r) FMRT_StepBroadcastInPlace(fast.X, N, E, fast.out); },
+                     [&] { for (int r = 0; r < 5; ++r) step_each_in_place(slow, N, [&](std::size_t) { return E; }); }))
+    {
+        std::cerr << "fleet_broadcast FAILED: heartbeat broadcast not faster than stepping each organism\n";
+        return 1;
+    }
+    return 0;
+}
+
+int test_fleet_broadcast()
+{
+    std::cout << "Running fleet_broadcast...\n";
+
+    if (check_columns(false) != 0) return 1;
+    if (check_columns(true) != 0) return 1;
+    if (check_speed() != 0) return 1;
+
+    if (check_fleet(LifecyclePolicy::Keep,      0, "keep")         != 0) return 1;
+    if (check_fleet(LifecyclePolicy::Freeze,    0, "freeze")       != 0) return 1;
+    if (check_fleet(LifecyclePolicy::AutoReset, 0, "auto-reset 0") != 0) return 1;
+    if (check_fleet(LifecyclePolicy::AutoReset, 3, "auto-reset 3") != 0) return 1;
+    if (check_fleet(LifecyclePolicy::Evict,     0, "evict")        != 0) return 1;
+
+    std::cout << "fleet_broadcast OK\n";
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// heartbeat-heavy stream: fragile organisms collapse, a few RESETs revive
+static StructEvent event_at(std::uint64_t i)
+{
+    const std::uint64_t h = mix(i);
+
+    StructEvent E{};
+    E.dt = 0.5 + 0.25 * static_cast<double>(h % 4);
+
+    const std::uint64_t kind = (h >> 8) % 64;
+    if (kind == 0)
+    {
+        E.type = EventType::Reset;
+    }
+    else if (kind < 40)
+    {
+        E.type = EventType::Heartbeat;
+    }
+    else if (kind < 48)
+    {
+        E.type = EventType::Gap;
+    }
+    else
+    {
+        E.type = EventType::Update;
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            E.stimulus[k] = 0.3 * static_cast<double>((h >> (16 + 4 * k)) % 7) - 0.9;
+    }
+
+    if (kind == 63)
+        E.dt = -1.0;                            // rejected (also when parked)
+    return E;
+}
+
+// serial model of the lifecycle rules documented in fmrt_fleet.hpp
+struct RefOrganism
+{
+    StructuralState X;
+    OrganismPhase   phase  = OrganismPhase::Active;
+    StepStatus      status = StepStatus::OK;
+    std::uint32_t   parked = 0;
+};
+
+struct RefFleet
+{
+    LifecyclePolicy policy;
+    std::uint32_t   after;
+    FleetStats      stats;
+
+    StepStatus step(RefOrganism& o, const StructEvent& E)
+    {
+        const StepStatus st = FMRT_StepInPlace(o.X, E);
+        ++stats.steps;
+        if (st == StepStatus::ERROR) ++stats.errors;
+        return st;
+    }
+
+    void autoReset(RefOrganism& o)
+    {
+        StructEvent R;
+        R.type = EventType::Reset;
+        ++stats.auto_resets;
+        o.parked = 0;
+        o.phase  = OrganismPhase::Active;
+        o.status = step(o, R);
+    }
+
+    void apply(RefOrganism& o, const StructEvent& E)
+    {
+        if (o.phase == OrganismPhase::Evicted)
+        {
+            ++stats.dropped;
+            return;
+        }
+
+        if (o.phase == OrganismPhase::Frozen)
+        {
+            if (E.type != EventType::Reset)
+            {
+                ++stats.dead;
+                o.status = StepStatus::DEAD;
+                if (policy == LifecyclePolicy::AutoReset && ++o.parked >= after)
+                    autoReset(o);
+                return;
+            }
+            o.phase = OrganismPhase::Active;
+        }
+
+        o.status = step(o, E);
+
+        if (policy != LifecyclePolicy::Keep && o.X.Kappa == 0.0)
+        {
+            o.phase  = OrganismPhase::Frozen;
+            o.parked = 0;
+
+            if (policy == LifecyclePolicy::Evict)
+            {
+                o.phase = OrganismPhase::Evicted;
+                ++stats.evictions;
+            }
+            else if (policy == LifecyclePolicy::AutoReset && after == 0)
+            {
+                autoReset(o);
+            }
+        }
+    }
+};
+
+static int check_policy(LifecyclePolicy policy, std::uint32_t after, const char* name,
+                        std::vector<StructuralState>* final_states)
+{
+    constexpr std::size_t ORGANISMS = 300;
+    constexpr std::size_t ROUNDS    = 6;
+    constexpr std::size_t PER_ROUND = 4000;
+
+    FleetConfig cfg;
+    cfg.threads          = 3;
+    cfg.shards           = 11;
+    cfg.lifecycle        = policy;
+    cfg.auto_reset_after = after;
+
+    Fleet fleet(cfg);
+    RefFleet ref{ policy, after, FleetStats{} };
+    std::vector<RefOrganism> org(ORGANISMS);
+
+    for (std::size_t i = 0; i < ORGANISMS; ++i)
+    {
+        org[i].X.reset();
+        org[i].X.Kappa = (i % 3 == 0) ? 0.9 : 0.002 * static_cast<double>(i % 7 + 1);
+        fleet.add(org[i].X);
+    }
+
+    std::uint64_t n = 0;
+    std::size_t  min_active = ORGANISMS;
+    for (std::size_t r = 0; r < ROUNDS; ++r)
+    {
+        for (std::size_t j = 0; j < PER_ROUND; ++j, ++n)
+        {
+            const OrganismId  id = static_cast<OrganismId>(mix(n ^ 0x5EEDu) % ORGANISMS);
+            const StructEvent E  = event_at(n);
+
+            if (!fleet.submit(id, E))
+            {
+                std::cerr << "fleet_lifecycle FAILED [" << name << "]: submit rejected\n";
+                return 1;
+            }
+            ref.apply(org[id], E);
+        }
+        fleet.run();
+        if (fleet.active() < min_active) min_active = fleet.active();
+    }
+
+    std::size_t active = 0;
+    for (std::size_t i = 0; i < ORGANISMS; ++i)
+    {
+        const OrganismId id = static_cast<OrganismId>(i);
+        const RefOrganism& o = org[i];
+
+        bool ok = fleet.phase(id) == o.phase && fleet.lastStatus(id) == o.status;
+        if (ok && o.phase != OrganismPhase::Evicted)
+            ok = same_state(fleet.state(id), o.X);
+
+        if (!ok)
+        {
+            std::cerr << "fleet_lifecycle FAILED [" << name << "]: organism " << i << "\n";
+            return 1;
+        }
+        active += (o.phase == OrganismPhase::Active);
+    }
+
+    const FleetStats got = fleet.stats();
+    const FleetStats& want = ref.stats;
+    if (got.steps != want.steps || got.errors != want.errors || got.dead != want.dead ||
+        got.dropped != want.dropped || got.auto_resets != want.auto_resets ||
+        got.evictions != want.evictions || fleet.active() != active)
+    {
+        std::cerr << "fleet_lifecycle FAILED [" << name << "]: stats\n";
+        return 1;
+    }
+
+    // the stream must actually exercise the policy
+    if (policy != LifecyclePolicy::Keep &&
+        (want.dead + want.auto_resets + want.evictions == 0 ||
+         (policy == LifecyclePolicy::Freeze && min_active == ORGANISMS)))
+    {
+        std::cerr << "fleet_lifecycle FAILED [" << name << "]: nothing collapsed\n";
+        return 1;
+    }
+
+    if (final_states)
+    {
+        final_states->clear();
+        for (const RefOrganism& o : org)
+            final_states->push_back(o.X);
+    }
+    return 0;
+}
+
+int test_fleet_lifecycle()
+{
+    std::cout << "Running fleet_lifecycle...\n";
+
+    std::vector<StructuralState> keep, freeze;
+
+    if (check_policy(LifecyclePolicy::Keep,      0, "keep",        &keep)   != 0) return 1;
+    if (check_policy(LifecyclePolicy::Freeze,    0, "freeze",      &freeze) != 0) return 1;
+    if (check_policy(LifecyclePolicy::AutoReset, 0, "auto-reset 0", nullptr) != 0) return 1;
+    if (check_policy(LifecyclePolicy::AutoReset, 5, "auto-reset 5", nullptr) != 0) return 1;
+    if (check_policy(LifecyclePolicy::Evict,     0, "evict",       nullptr) != 0) return 1;
+
+    // parking never changes a state: Freeze ends where plain stepping ends
+    for (std::size_t i = 0; i < keep.size(); ++i)
+    {
+        if (!same_state(keep[i], freeze[i]))
+        {
+            std::cerr << "fleet_lifecycle FAILED: Freeze differs from Keep at " << i << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "fleet_lifecycle OK\n";
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+#include "fmrt_mpsc_ring.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// j-th event of organism id (depends on both, so reordering shows up)
+static FleetEvent event_for(OrganismId id, std::uint64_t j)
+{
+    FleetEvent E;
+    E.id   = id;
+    E.dt   = 0.03 + 0.01 * static_cast<double>((id + j) % 5);
+    E.type = (j % 9 == 8) ? EventType::Gap : EventType::Update;
+
+    if (E.type == EventType::Update)
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            E.stimulus[k] = 0.2 * static_cast<double>((id * 7 + j * (k + 1)) % 9) - 0.8;
+    return E;
+}
+
+static int test_ring()
+{
+    MpscRing<FleetEvent> q;
+    q.init(5);                                  // rounds up to 8
+    if (q.capacity() != 8) return 1;
+
+    FleetEvent E;
+    for (std::uint32_t i = 0; i < 8; ++i)
+    {
+        E.id = i;
+        if (!q.tryPush(E)) return 1;
+    }
+    if (q.tryPush(E) || q.rejectedPushes() != 1 || q.depth() != 8)
+        return 1;
+
+    // batches come out oldest first, across the wrap-around
+    FleetEvent out[8];
+    if (q.popBatch(out, 3) != 3 || out[0].id != 0 || out[2].id != 2)
+        return 1;
+
+    for (std::uint32_t i = 8; i < 11; ++i)
+    {
+        E.id = i;
+        if (!q.tryPush(E)) return 1;
+    }
+
+    std::uint32_t next = 3;
+    std::size_t   n    = 0;
+    while ((n = q.popBatch(out, 4)) != 0)
+        for (std::size_t j = 0; j < n; ++j)
+            if (out[j].id != next++) return 1;
+
+    if (next != 11 || q.depth() != 0 || q.pushed() != 11 || q.highWater() != 8)
+        return 1;
+
+    return 0;
+}
+
+int test_fleet_queue()
+{
+    std::cout << "Running fleet_queue...\n";
+
+    if (test_ring() != 0)
+    {
+        std::cerr << "fleet_queue FAILED: ring order / counters\n";
+        return 1;
+    }
+
+    // --- concurrent producers while the owner keeps running ---------------
+    constexpr std::size_t ORGANISMS = 96;
+    constexpr std::size_t PRODUCERS = 4;
+    constexpr std::size_t PER_ORG   = 300;
+
+    FleetConfig cfg;
+    cfg.threads        = 3;
+    cfg.shards         = 5;
+    cfg.queue_capacity = 256;                   // small: producers hit full rings
+
+    Fleet fleet(cfg);
+    for (std::size_t i = 0; i < ORGANISMS; ++i)
+        fleet.add();
+
+    // producer p owns organisms id % PRODUCERS == p and interleaves them
+    std::atomic<std::size_t> finished{0};
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&fleet, &finished, p]
+        {
+            for (std::uint64_t j = 0; j < PER_ORG; ++j)
+                for (std::size_t id = p; id < ORGANISMS; id += PRODUCERS)
+                    while (!fleet.push(event_for(static_cast<OrganismId>(id), j)))
+                        std::this_thread::yield();
+            finished.fetch_add(1);
+        });
+    }
+
+    while (finished.load() != PRODUCERS)
+        fleet.run();
+    for (std::thread& t : producers)
+        t.join();
+    fleet.run();
+
+    // reference: each organism's events in producer order
+    for (std::size_t id = 0; id < ORGANISMS; ++id)
+    {
+        StructuralState X;
+        X.reset();
+        for (std::uint64_t j = 0; j < PER_ORG; ++j)
+            FMRT_StepInPlace(X, event_for(static_cast<OrganismId>(id), j).event());
+
+        if (!same_state(X, fleet.state(static_cast<OrganismId>(id))))
+        {
+            std::cerr << "fleet_queue FAILED: organism " << id << " out of order\n";
+            return 1;
+        }
+    }
+
+    const FleetQueueStats qs = fleet.queueStats();
+    if (qs.pushed != ORGANISMS * PER_ORG || qs.depth != 0 ||
+        qs.high_water > cfg.queue_capacity || fleet.stats().steps != qs.pushed)
+    {
+        std::cerr << "fleet_queue FAILED: queue counters\n";
+        return 1;
+    }
+
+    // unknown organism; full ring reported, not waited on
+    FleetEvent bad = event_for(0, 0);
+    bad.id = static_cast<OrganismId>(ORGANISMS);
+    if (fleet.push(bad))
+    {
+        std::cerr << "fleet_queue FAILED: unknown id accepted\n";
+        return 1;
+    }
+
+    std::size_t accepted = 0;
+    while (fleet.push(event_for(0, accepted)))
+        ++accepted;
+
+    const std::uint64_t rejected_before = fleet.queueStats(0).rejected;
+    if (accepted != 256 || fleet.queueStats(0).depth != 256 || fleet.push(event_for(0, 0)) ||
+        fleet.queueStats(0).rejected != rejected_before + 1)
+    {
+        std::cerr << "fleet_queue FAILED: full ring\n";
+        return 1;
+    }
+
+    fleet.run();
+    if (fleet.queueStats().depth != 0)
+    {
+        std::cerr << "fleet_queue FAILED: ring not drained\n";
+        return 1;
+    }
+
+    std::cout << "fleet_queue OK\n";
+    return 0;
+}
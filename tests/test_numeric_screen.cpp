@@ -0,0 +1,93 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "fmrt_api.hpp"
+#include "internal/fp_guard.hpp"
+
+using namespace fmrt;
+
+// Reference: the original multi-pass numeric reject of FMRT_Step
+static bool is_denormal(double x)
+{
+    return x != 0.0 && std::fpclassify(x) == FP_SUBNORMAL;
+}
+
+template <std::size_t N>
+static bool legacy_reject(const StructuralStateT<N>& X, const StructEventT<N>& E)
+{
+    bool denormal = is_denormal(X.Phi) || is_denormal(X.M) ||
+                    is_denormal(X.Kappa) || is_denormal(E.dt);
+    for (double v : X.Delta)    denormal = denormal || is_denormal(v);
+    for (double v : E.stimulus) denormal = denormal || is_denormal(v);
+
+    return !X.isFinite() || !E.isFinite() || denormal;
+}
+
+static const double SPECIALS[] = {
+    0.0, -0.0, 1.0, -2.5, 1e300,
+    std::numeric_limits<double>::min(),            // smallest normal
+    std::numeric_limits<double>::denorm_min(),
+    -std::numeric_limits<double>::denorm_min(),
+    std::numeric_limits<double>::min() / 2.0,      // subnormal
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::infinity(),
+    -std::numeric_limits<double>::infinity(),
+    std::numeric_limits<double>::quiet_NaN(),
+    -std::numeric_limits<double>::quiet_NaN(),
+};
+
+template <std::size_t N>
+static int run_dimension()
+{
+    const FpGuard fp{};
+    const EventType types[] = {
+        EventType::Update, EventType::Gap, EventType::Heartbeat, EventType::Reset
+    };
+
+    // one special value placed in each double slot of X (N + 3) and E (N + 1)
+    for (EventType type : types)
+    for (std::size_t slot = 0; slot < 2 * N + 4; ++slot)
+    for (double v : SPECIALS)
+    {
+        StructuralStateT<N> X;
+        X.reset();
+        for (std::size_t k = 0; k < N; ++k) X.Delta[k] = 0.1 * static_cast<double>(k);
+        X.Kappa = 0.7;
+
+        StructEventT<N> E{};
+        E.type = type;
+        E.dt   = 0.2;
+        for (std::size_t k = 0; k < N; ++k) E.stimulus[k] = -0.3;
+
+        if      (slot < N)         X.Delta[slot]           = v;
+        else if (slot == N)        X.Phi                   = v;
+        else if (slot == N + 1)    X.M                     = v;
+        else if (slot == N + 2)    X.Kappa                 = v;
+        else if (slot == N + 3)    E.dt                    = v;
+        else                       E.stimulus[slot - N - 4] = v;
+
+        const bool fused = FpGuard::numericReject(fp.screen(X) | fp.screen(E), E.type);
+
+        if (fused != legacy_reject(X, E))
+        {
+            std::cerr << "numeric_screen FAILED: N=" << N << " slot " << slot
+                      << " value " << v << " type " << static_cast<int>(type) << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int test_numeric_screen()
+{
+    std::cout << "Running numeric_screen...\n";
+
+    if (run_dimension<4>()  != 0) return 1;
+    if (run_dimension<8>()  != 0) return 1;
+    if (run_dimension<16>() != 0) return 1;
+    if (run_dimension<64>() != 0) return 1;
+
+    std::cout << "numeric_screen OK\n";
+    return 0;
+}
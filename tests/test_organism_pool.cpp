@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_organism_pool.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// organism i: distinct, recognizable field values
+static StructuralState state_for(std::uint32_t i)
+{
+    StructuralState X;
+    X.reset();
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        X.Delta[k] = 0.001 * static_cast<double>(i) + 0.1 * static_cast<double>(k);
+    X.Phi   = 0.5 + 0.0001 * static_cast<double>(i);
+    X.M     = 0.01 * static_cast<double>(i % 17);
+    X.Kappa = 0.2 + 0.7 * static_cast<double>(i % 11) / 11.0;
+    return X;
+}
+
+int test_organism_pool()
+{
+    std::cout << "Running organism_pool...\n";
+
+    OrganismPool pool;
+    pool.reserve(64);
+
+    // --- insert / remove / stale detection --------------------------------
+    std::vector<OrganismHandle> h;
+    std::vector<std::uint32_t>  tag;            // which state_for() each handle holds
+    for (std::uint32_t i = 0; i < 500; ++i)
+    {
+        h.push_back(pool.insert(state_for(i)));
+        tag.push_back(i);
+    }
+
+    // remove every third organism (a second remove must fail)
+    std::vector<OrganismHandle> stale, kept_h;
+    std::vector<std::uint32_t>  kept_tag;
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        if (i % 3 != 0)
+        {
+            kept_h.push_back(h[i]);
+            kept_tag.push_back(tag[i]);
+            continue;
+        }
+
+        if (!pool.remove(h[i]) || pool.remove(h[i]))
+        {
+            std::cerr << "organism_pool FAILED: remove\n";
+            return 1;
+        }
+        stale.push_back(h[i]);
+    }
+    h   = kept_h;
+    tag = kept_tag;
+
+    // reuse freed slots: old handles must stay stale
+    for (std::uint32_t i = 500; i < 600; ++i)
+    {
+        h.push_back(pool.insert(state_for(i)));
+        tag.push_back(i);
+    }
+
+    StructuralState X;
+    for (const OrganismHandle& s : stale)
+    {
+        if (pool.contains(s) || pool.load(s, X) || pool.store(s, X) ||
+            pool.denseIndex(s) != pool.size())
+        {
+            std::cerr << "organism_pool FAILED: stale handle accepted\n";
+            return 1;
+        }
+    }
+
+    bool reused = false;
+    for (const OrganismHandle& s : stale)
+        for (const OrganismHandle& a : h)
+            reused |= (a.index == s.index);
+    if (!reused || pool.size() != h.size() || pool.remove(OrganismHandle{}))
+    {
+        std::cerr << "organism_pool FAILED: slot reuse\n";
+        return 1;
+    }
+
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        if (!pool.load(h[i], X) || !same_state(X, state_for(tag[i])) ||
+            pool.handleAt(pool.denseIndex(h[i])) != h[i])
+        {
+            std::cerr << "organism_pool FAILED: handle lost its organism\n";
+            return 1;
+        }
+    }
+
+    // --- swapDense keeps handles attached ---------------------------------
+    pool.swapDense(0, pool.size() - 1);
+    pool.swapDense(3, 3);
+    for (std::size_t i = 0; i < h.size(); ++i)
+    {
+        if (!pool.load(h[i], X) || !same_state(X, state_for(tag[i])))
+        {
+            std::cerr << "organism_pool FAILED: swapDense\n";
+            return 1;
+        }
+    }
+
+    // --- contiguous columns feed FMRT_StepBatch -----------------------------
+    const std::size_t n = pool.size();
+    std::vector<StructuralState> ref(n);
+    std::vector<StructEvent>     ev(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ref[i] = pool.loadDense(i);
+        ev[i].type = EventType::Update;
+        ev[i].dt   = 0.05;
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            ev[i].stimulus[k] = 0.1 * static_cast<double>((i + k) % 7) - 0.3;
+    }
+
+    double kappa_sum = 0.0;
+    const double* kappa = pool.kappaColumn();
+    for (std::size_t i = 0; i < n; ++i)
+        kappa_sum += kappa[i];
+
+    double ref_sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+        ref_sum += ref[i].Kappa;
+
+    const StateColumns cols = pool.columns();
+    FMRT_StepBatch(cols, ev.data(), n, cols, EnvelopeColumns{});
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const StateEnvelope env = FMRT_Step(ref[i], ev[i]);
+        if (!same_state(pool.loadDense(i), env.state))
+        {
+            std::cerr << "organism_pool FAILED: batch over pool columns\n";
+            return 1;
+        }
+    }
+
+    if (!same_bits(kappa_sum, ref_sum))
+    {
+        std::cerr << "organism_pool FAILED: kappa column\n";
+        return 1;
+    }
+
+    // --- drain to empty ---------------------------------------------------
+    for (const OrganismHandle& a : h)
+        pool.remove(a);
+    if (!pool.empty() || pool.contains(h.front()))
+    {
+        std::cerr << "organism_pool FAILED: drain\n";
+        return 1;
+    }
+
+    std::cout << "organism_pool OK\n";
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_event_log.hpp"
+#include "fmrt_replay.hpp"
+#include "fmrt_workload.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// records `rounds` rounds of a workload over `organisms` organisms,
+// `spacing` ticks apart
+static bool write_log(const std::string& path, std::uint64_t seed, OrganismId organisms,
+                      std::size_t rounds, std::int64_t spacing, std::vector<FleetEvent>& events)
+{
+    WorkloadConfig wc;
+    wc.seed           = seed;
+    wc.stimulus_scale = 0.05;
+    const MarketWorkload w(wc);
+
+    events.resize(std::size_t{organisms} * rounds);
+    for (std::size_t i = 0; i < rounds; ++i)
+        w.round(i, 0, organisms, &events[i * organisms]);
+
+    // a few organisms restart mid-stream
+    for (std::size_t j = 7; j < events.size(); j += 997)
+        events[j].type = EventType::Reset;
+
+    EventLogOptions opt;
+    opt.block_records = 300;
+
+    std::filesystem::remove(path);              // the writer appends to an existing log
+
+    EventLogWriter wr;
+    if (!wr.open(path.c_str(), opt))
+        return false;
+    for (std::size_t j = 0; j < events.size(); ++j)
+        if (!wr.append(1'000'000 + static_cast<std::int64_t>(j) * spacing, events[j]))
+            return false;
+    return wr.close();
+}
+
+int test_replay()
+{
+    std::cout << "Running replay...\n";
+
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string a = (dir / "fmrt_test_replay_a.bin").string();
+    const std::string b = (dir / "fmrt_test_replay_b.bin").string();
+
+    constexpr OrganismId  ORGANISMS = 50;
+    constexpr std::size_t ROUNDS    = 120;
+
+    std::vector<FleetEvent> ev_a, ev_b;
+    if (!write_log(a, 11, ORGANISMS, ROUNDS, 1000, ev_a) ||
+        !write_log(b, 12, ORGANISMS, ROUNDS, 1000, ev_b))
+    {
+        std::cerr << "replay: could not write the logs\n";
+        return 1;
+    }
+
+    // --- reference: a plain FMRT_StepInPlace loop in log order ----------------
+    std::vector<StructuralState> ref(ORGANISMS);
+    for (StructuralState& X : ref)
+        X.reset();
+
+    std::uint64_t hash   = REPLAY_HASH_SEED;
+    std::uint64_t errors = 0;
+    for (const FleetEvent& e : ev_a)
+    {
+        DerivedMetrics  m;
+        InvariantStatus inv;
+        ErrorCategory   cat = ErrorCategory::None;
+        const StepStatus st = FMRT_StepInPlace(ref[e.id], e.event(), &m, &inv, &cat);
+        errors += st == StepStatus::ERROR;
+        hash    = replayHashStep(hash, envelopeDigest(ref[e.id], st, cat, m, inv));
+    }
+
+    // --- Ordered and Sorted replays match the reference -----------------------
+    EventLogReader log;
+    if (!log.open(a.c_str()))
+    {
+        std::cerr << "replay: open failed: " << log.error() << "\n";
+        return 1;
+    }
+
+    struct Case
+    {
+        ReplayMode  mode;
+        std::size_t batch;
+    };
+    const Case cases[] = { { ReplayMode::Ordered, 1 }, { ReplayMode::Sorted, 1 },
+                           { ReplayMode::Sorted, 173 }, { ReplayMode::Sorted, 4096 } };
+
+    for (const Case& k : cases)
+    {
+        ReplayConfig cfg;
+        cfg.mode          = k.mode;
+        cfg.batch_records = k.batch;
+
+        LogReplay replay(cfg);
+        if (!replay.run(log))
+        {
+            std::cerr << "replay: run failed: " << replay.result().error << "\n";
+            return 1;
+        }
+
+        const ReplayResult& r = replay.result();
+        if (r.records != ev_a.size() || r.errors != errors || r.hash != hash ||
+            r.organisms != ORGANISMS || r.first_time != 1'000'000 ||
+            r.last_time != 1'000'000 + static_cast<std::int64_t>(ev_a.size() - 1) * 1000)
+        {
+            std::cerr << "replay: mode " << static_cast<int>(k.mode) << " / batch " << k.batch
+                      << " differs from the reference (records " << r.records << ", errors "
+                      << r.errors << " vs " << errors << ")\n";
+            return 1;
+        }
+        for (OrganismId id = 0; id < ORGANISMS; ++id)
+            if (!same_state(replay.state(id), ref[id]))
+            {
+                std::cerr << "replay: state of organism " << id << " differs\n";
+                return 1;
+            }
+    }
+    log.close();
+
+    // --- several files side by side -------------------------------------------
+    {
+        ReplayConfig cfg;
+        cfg.threads = 2;
+
+        const std::vector<ReplayResult> r = replayLogs({ a, b, a, dir.string() + "/fmrt_no_such_log" }, cfg);
+
+        if (r.size() != 4 || !r[0].ok || !r[1].ok || !r[2].ok || r[3].ok ||
+            r[0].hash != hash || r[2].hash != hash || r[1].hash == hash ||
+            r[1].records != ev_b.size() || r[1].path != b)
+        {
+            std::cerr << "replay: replayLogs results are wrong\n";
+            return 1;
+        }
+    }
+
+    // --- pacing: 6000 records 1 µs apart (6 ms of log) at half speed ----------
+    {
+        ReplayConfig cfg;
+        cfg.speed = 0.5;
+
+        EventLogReader in;
+        in.open(a.c_str());
+        for (ReplayMode mode : { ReplayMode::Ordered, ReplayMode::Sorted })
+        {
+            cfg.mode = mode;
+            LogReplay replay(cfg);
+            replay.run(in);
+
+            const ReplayResult& r = replay.result();
+            if (!r.ok || r.hash != hash || r.seconds < 0.012)
+            {
+                std::cerr << "replay: paced replay took " << r.seconds << " s\n";
+                return 1;
+            }
+        }
+    }
+
+    // --- failures: ids beyond max_organisms, torn tail, corrupt blocks -------
+    {
+        ReplayConfig cfg;
+        cfg.max_organisms = 10;
+
+        EventLogReader in;
+        in.open(a.c_str());
+        LogReplay replay(cfg);
+        if (replay.run(in) || replay.result().ok || replay.result().records != 10)
+        {
+            std::cerr << "replay: max_organisms not enforced\n";
+            return 1;
+        }
+    }
+    {
+        std::filesystem::resize_file(a, std::filesystem::file_size(a) - 100);     // torn tail
+
+        EventLogReader in;
+        in.open(a.c_str());
+        const std::uint64_t kept = in.records();
+
+        for (ReplayMode mode : { ReplayMode::Ordered, ReplayMode::Sorted })
+        {
+            ReplayConfig cfg;
+            cfg.mode = mode;
+
+            LogReplay replay(cfg);
+            const ReplayResult& r = replay.result();
+            if (replay.run(in) || r.ok || !r.truncated || r.records != kept || kept >= ev_a.size())
+            {
+                std::cerr << "replay: truncated log not reported\n";
+                return 1;
+            }
+        }
+
+        const std::vector<ReplayResult> r = replayLogs({ a });
+        if (r[0].ok || !r[0].truncated)
+        {
+            std::cerr << "replay: replayLogs accepted a truncated log\n";
+            return 1;
+        }
+    }
+    {
+        std::FILE* f = std::fopen(b.c_str(), "r+b");
+        std::fseek(f, static_cast<long>(std::filesystem::file_size(b) / 2), SEEK_SET);
+        const int ch = std::fgetc(f);
+        std::fseek(f, -1, SEEK_CUR);
+        std::fputc(ch ^ 0x10, f);
+        std::fclose(f);
+
+        const std::vector<ReplayResult> r = replayLogs({ b });
+        if (r[0].ok || r[0].truncated || r[0].error.find("corrupt") == std::string::npos ||
+            r[0].records == 0 || r[0].records >= ev_b.size())
+        {
+            std::cerr << "replay: corrupt block not reported\n";
+            return 1;
+        }
+    }
+
+    std::filesystem::remove(a);
+    std::filesystem::remove(b);
+
+    std::cout << "replay OK\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_sorted_batch.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// event j of a batch for `organisms` organisms: every kind, some rejected
+static FleetEvent event_at(std::uint64_t j, std::size_t organisms)
+{
+    const std::uint64_t h = mix(j);
+
+    FleetEvent e;
+    e.id = static_cast<OrganismId>(h % organisms);
+    e.dt = uniform(mix(h), 0.01, 0.4);
+
+    switch (h % 17)
+    {
+        case 0:  e.type = EventType::Reset;     break;
+        case 1:  e.type = EventType::Gap;       break;
+        case 2:
+        case 3:  e.type = EventType::Heartbeat; break;
+        case 4:  e.type = EventType::Update; e.dt = -1.0; break;    // rejected
+        case 5:
+            e.type = EventType::Update;
+            e.stimulus[1] = std::numeric_limits<double>::quiet_NaN();
+            break;
+        default:
+            e.type = EventType::Update;
+            for (std::size_t k = 0; k < DELTA_DIM; ++k)
+                e.stimulus[k] = uniform(mix(h + k + 1), -4.0, 4.0);
+            break;
+    }
+    return e;
+}
+
+// --- sort(): (id, arrival) order -------------------------------------------
+static int check_sort()
+{
+    SortedEventBatch batch;
+
+    batch.sort(nullptr, 0);
+
+    // ids spread over all four bytes, plus equal high bytes
+    const OrganismId ids[] = { 0x01020304u, 7u, 0xFFFFFFFFu, 7u, 0x00010000u, 0u,
+                               0x01020304u, 0xFF000000u, 7u, 0x00000100u, 0u };
+    const std::size_t n = sizeof(ids) / sizeof(ids[0]);
+
+    std::vector<FleetEvent> E(n);
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        E[j].id = ids[j];
+        E[j].dt = static_cast<double>(j);
+    }
+
+    batch.sort(E.data(), n);
+
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        const FleetEvent&   s = batch.sorted()[j];
+        const std::uint32_t a = batch.order()[j];
+
+        bool ok = a < n && s.id == E[a].id && s.dt == E[a].dt;
+        if (ok && j > 0)
+        {
+            const FleetEvent& p = batch.sorted()[j - 1];
+            ok = p.id < s.id || (p.id == s.id && batch.order()[j - 1] < a);
+        }
+
+        if (!ok)
+        {
+            std::cerr << "sorted_batch FAILED: sort position " << j << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// --- step(): against FMRT_StepInPlace in arrival order ----------------------
+static int check_step(std::size_t organisms, std::size_t n, bool presorted, const char* name)
+{
+    std::vector<StructuralState> ref(organisms);
+    for (std::size_t i = 0; i < organisms; ++i)
+    {
+        StructuralState& X = ref[i];
+        X.reset();
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            X.Delta[k] = uniform(mix(i * 8 + k + 99), -8.0, 8.0);
+        X.Phi   = uniform(mix(i ^ 0x100), 0.0, 20.0);
+        X.M     = uniform(mix(i ^ 0x200), 0.0, 50.0);
+        X.Kappa = (i % 5 == 0) ? 0.002 : uniform(mix(i ^ 0x300), 0.2, 1.2);
+    }
+    if (organisms > 3)
+        ref[3].Phi = 1e-320;                    // every step is a numeric reject
+
+    std::vector<double> cols[DELTA_DIM];
+    std::vector<double> phi(organisms), m(organisms), kappa(organisms);
+    std::vector<Regime> prev(organisms);
+    for (auto& c : cols) c.resize(organisms);
+
+    StateColumns X;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k) X.Delta[k] = cols[k].data();
+    X.Phi = phi.data();
+    X.M = m.data();
+    X.Kappa = kappa.data();
+    X.RegimePrev = prev.data();
+
+    for (std::size_t i = 0; i < organisms; ++i)
+        X.store(i, ref[i]);
+
+    SortedEventBatch batch;
+    std::vector<StepStatus> status(n);
+
+    for (std::uint64_t round = 0; round < 6; ++round)
+    {
+        std::vector<FleetEvent> E(n);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            E[j] = event_at(round * n + j, organisms);
+            if (presorted)
+                E[j].id = static_cast<OrganismId>(j * organisms / n);
+        }
+
+        batch.step(X, E.data(), n, status.data());
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const StepStatus st = FMRT_StepInPlace(ref[E[j].id], E[j].event());
+            if (st != status[j])
+            {
+                std::cerr << "sorted_batch FAILED [" << name << "]: status of event " << j
+                          << " round " << round << "\n";
+                return 1;
+            }
+        }
+
+        for (std::size_t i = 0; i < organisms; ++i)
+            if (!same_state(X.load(i), ref[i]))
+            {
+                std::cerr << "sorted_batch FAILED [" << name << "]: organism " << i
+                          << " round " << round << "\n";
+                return 1;
+            }
+    }
+
+    return 0;
+}
+
+int test_sorted_batch()
+{
+    std::cout << "Running sorted_batch...\n";
+
+    if (check_sort() != 0) return 1;
+
+    if (check_step(1,     40,   false, "one organism")  != 0) return 1;
+    if (check_step(37,    900,  false, "long runs")     != 0) return 1;
+    if (check_step(700,   1000, false, "short runs")    != 0) return 1;
+    if (check_step(70000, 3000, false, "two digits")    != 0) return 1;
+    if (check_step(50,    500,  true,  "presorted")     != 0) return 1;
+    if (check_step(10,    0,    false, "empty")         != 0) return 1;
+
+    std::cout << "sorted_batch OK\n";
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include "fmrt_api.hpp"
+
+using namespace fmrt;
+
+// --- StageHistogram: bucket layout, quantiles, merge -------------------------
+static int check_histogram()
+{
+    // buckets tile [0, 2^64) without gaps, each bucket at most 1/16 wide
+    for (std::size_t b = 0; b + 1 < StageHistogram::BUCKETS; ++b)
+    {
+        const std::uint64_t lo = StageHistogram::bucketLow(b);
+        const std::uint64_t hi = StageHistogram::bucketHigh(b);
+
+        if (StageHistogram::bucketLow(b + 1) != hi + 1 ||
+            StageHistogram::bucketOf(lo) != b || StageHistogram::bucketOf(hi) != b ||
+            (lo >= StageHistogram::SUB && (hi - lo) > lo / StageHistogram::SUB))
+        {
+            std::cerr << "stage_profile FAILED: bucket " << b << "\n";
+            return 1;
+        }
+    }
+    if (StageHistogram::bucketOf(std::numeric_limits<std::uint64_t>::max()) !=
+        StageHistogram::BUCKETS - 1)
+    {
+        std::cerr << "stage_profile FAILED: top bucket\n";
+        return 1;
+    }
+
+    StageHistogram a, b;
+    for (std::uint64_t v = 1; v <= 100; ++v)
+        a.record(v);
+    b.record(100000);
+
+    if (a.samples != 100 || a.min != 1 || a.max != 100 || a.mean() != 50.5 ||
+        a.quantile(0.0) != 1 || a.quantile(0.10) != 10 || a.quantile(1.0) != 100)
+    {
+        std::cerr << "stage_profile FAILED: quantiles\n";
+        return 1;
+    }
+
+    // p50 = 50 lies in bucket [48, 51]
+    if (a.quantile(0.5) != 51)
+    {
+        std::cerr << "stage_profile FAILED: bucket bound\n";
+        return 1;
+    }
+
+    a.merge(b);
+    if (a.samples != 101 || a.max != 100000 || a.min != 1 || a.sum != 5050 + 100000 ||
+        a.quantile(1.0) != 100000)
+    {
+        std::cerr << "stage_profile FAILED: merge\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+// --- FMRT_StageProfile(): one sample per stage that ran ----------------------
+static std::uint64_t samples(const StageProfile& p, PipelineStage s)
+{
+    return p[s].samples;
+}
+
+static int check_pipeline()
+{
+    StructuralState X;
+    X.reset();
+
+    StructEvent U;
+    U.type = EventType::Update;
+    U.dt   = 0.1;
+    for (std::size_t k = 0; k < DELTA_DIM; ++k)
+        U.stimulus[k] = 0.25;
+
+    StructEvent R;
+    R.type = EventType::Reset;
+
+    StructEvent bad = U;
+    bad.stimulus[0] = std::numeric_limits<double>::quiet_NaN();
+
+    StructEvent invalid = U;
+    invalid.dt = -1.0;
+
+    FMRT_StageProfileReset();
+
+    // 10 accepted updates, 3 resets, 2 numeric rejects, 4 invalid events,
+    // half through FMRT_Step, half through FMRT_StepInPlace
+    for (int i = 0; i < 5; ++i)
+    {
+        FMRT_Step(X, U);
+        StructuralState Y = X;
+        FMRT_StepInPlace(Y, U);
+    }
+    FMRT_Step(X, R);
+    FMRT_Step(X, R);
+    {
+        StructuralState Y = X;
+        FMRT_StepInPlace(Y, R);
+    }
+    FMRT_Step(X, bad);
+    {
+        StructuralState Y = X;
+        FMRT_StepInPlace(Y, bad);
+    }
+
+    // a second thread, exited before the snapshot
+    std::thread t([&]
+    {
+        for (int i = 0; i < 4; ++i)
+            FMRT_Step(X, invalid);
+    });
+    t.join();
+
+    const StageProfile p = FMRT_StageProfile();
+
+    if (!FMRT_StageProfilingEnabled())
+    {
+        for (std::size_t i = 0; i < PIPELINE_STAGES; ++i)
+            if (p.stage[i].samples != 0)
+            {
+                std::cerr << "stage_profile FAILED: samples while disabled\n";
+                return 1;
+            }
+        return 0;
+    }
+
+    const std::uint64_t all = 10 + 3 + 2 + 4;
+
+    if (samples(p, PipelineStage::FpGuard)       != all ||
+        samples(p, PipelineStage::NumericScreen) != all ||
+        samples(p, PipelineStage::Validate)      != all - 2 ||
+        samples(p, PipelineStage::Canonicalize)  != 10 + 3 ||
+        samples(p, PipelineStage::Evolve)        != 10 + 3 ||
+        samples(p, PipelineStage::Invariants)    != 10 ||
+        samples(p, PipelineStage::Diagnostics)   != all)
+    {
+        std::cerr << "stage_profile FAILED: stage samples\n";
+        FMRT_StageProfileDump(p, stderr);
+        return 1;
+    }
+
+    FMRT_StageProfileReset();
+    if (FMRT_StageProfile()[PipelineStage::Evolve].samples != 0)
+    {
+        std::cerr << "stage_profile FAILED: reset\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_stage_profile()
+{
+    std::cout << "Running stage_profile...\n";
+
+    if (check_histogram() != 0) return 1;
+    if (check_pipeline() != 0) return 1;
+
+    std::cout << "stage_profile OK\n";
+    return 0;
+}
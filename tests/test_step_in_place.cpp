@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+#include "fmrt_api.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+// envelope full of stale values from an unrelated step
+static StateEnvelope stale_envelope()
+{
+    StateEnvelope env;
+    env.state.Delta = {9.0, 9.0, 9.0, 9.0};
+    env.state.Kappa = 0.5;
+    env.state.RegimePrev = Regime::COL;
+    env.metrics.tau = 42.0;
+    env.metrics.regime = Regime::REL;
+    env.invariants.flags = 0xFFu;
+    env.invariants.all_ok = true;
+    env.status = StepStatus::DEAD;
+    env.error_category = ErrorCategory::PostCollapse;
+    env.error_reason = ERR_POST_COLLAPSE;
+    env.event_type = EventType::Reset;
+    return env;
+}
+
+int test_step_in_place()
+{
+    std::cout << "Running step_in_place...\n";
+
+    StructuralState X{};
+    X.reset();
+    X.Delta = {0.3, -0.1, 0.2, 0.05};
+    X.Phi   = 1.0;
+    X.M     = 0.5;
+    X.Kappa = 0.9;
+
+    bool saw_ok = false, saw_error = false;
+
+    for (int step = 0; step < 80; ++step)
+    {
+        StructEvent E{};
+        const int kind = step % 10;
+        E.type = (kind < 5) ? EventType::Update
+               : (kind == 5) ? EventType::Gap
+               : (kind == 6) ? EventType::Heartbeat
+               : (kind == 7) ? EventType::Reset
+               : EventType::Update;
+        E.dt = 0.05 + 0.01 * (step % 9);
+        for (std::size_t k = 0; k < DELTA_DIM; ++k)
+            E.stimulus[k] = 0.25 * static_cast<double>((step * 7 + static_cast<int>(k) * 3) % 11) - 1.0;
+
+        StructuralState Xs = X;
+
+        if (kind == 8) E.dt = -1.0;                                           // invalid event
+        if (kind == 9 && step % 20 == 9)
+            E.stimulus[1] = std::numeric_limits<double>::quiet_NaN();         // numeric reject
+        if (kind == 9 && step % 20 == 19)
+            Xs.RegimePrev = Regime::COL;                                      // invariant violation
+
+        const StateEnvelope ref = FMRT_Step(Xs, E);
+
+        // ---- StepInto, separate storage ----
+        StateEnvelope into = stale_envelope();
+        FMRT_StepInto(Xs, E, into);
+        if (!same_envelope(into, ref) || into.error_reason != ref.error_reason)
+        {
+            std::cerr << "step_in_place FAILED: StepInto differs at step " << step << "\n";
+            return 1;
+        }
+
+        // ---- StepInto, env.state aliases X ----
+        StateEnvelope alias = stale_envelope();
+        alias.state = Xs;
+        FMRT_StepInto(alias.state, E, alias);
+        if (!same_envelope(alias, ref) || alias.error_reason != ref.error_reason)
+        {
+            std::cerr << "step_in_place FAILED: aliased StepInto differs at step " << step << "\n";
+            return 1;
+        }
+
+        // ---- StepInPlace ----
+        StructuralState Xp = Xs;
+        DerivedMetrics  m;
+        InvariantStatus inv;
+        ErrorCategory   err = ErrorCategory::PostCollapse;
+
+        const StepStatus st = FMRT_StepInPlace(Xp, E, &m, &inv, &err);
+
+        const StructuralState& expected = (ref.status == StepStatus::OK) ? ref.state : Xs;
+        if (st != ref.status ||
+            !same_state(Xp, expected) ||
+            !same_metrics(m, ref.metrics) ||
+            inv.flags != ref.invariants.flags ||
+            inv.all_ok != ref.invariants.all_ok ||
+            err != ref.error_category)
+        {
+            std::cerr << "step_in_place FAILED: StepInPlace differs at step " << step << "\n";
+            return 1;
+        }
+
+        // outputs are optional
+        StructuralState Xq = Xs;
+        if (FMRT_StepInPlace(Xq, E) != ref.status || !same_state(Xq, Xp))
+        {
+            std::cerr << "step_in_place FAILED: StepInPlace without outputs at step " << step << "\n";
+            return 1;
+        }
+
+        if (st == StepStatus::OK) saw_ok = true;
+        else                      saw_error = true;
+
+        if (ref.status == StepStatus::OK)
+            X = ref.state;
+    }
+
+    if (!saw_ok || !saw_error)
+    {
+        std::cerr << "step_in_place FAILED: trajectory did not cover OK and ERROR\n";
+        return 1;
+    }
+
+    std::cout << "step_in_place OK\n";
+    return 0;
+}
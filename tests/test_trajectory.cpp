@@ -0,0 +1,271 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_errors.hpp"
+#include "fmrt_trajectory.hpp"
+#include "fmrt_workload.hpp"
+#include "test_util.hpp"
+
+using namespace fmrt;
+
+struct Row
+{
+    OrganismId    id;
+    std::uint64_t step;
+    StateEnvelope env;
+};
+
+// `rounds` rounds of a workload over `organisms` organisms, stepped with
+// FMRT_Step; every row keeps its envelope
+static std::vector<Row> make_rows(OrganismId organisms, std::size_t rounds)
+{
+    WorkloadConfig wc;
+    wc.seed           = 21;
+    wc.stimulus_scale = 0.05;
+    const MarketWorkload w(wc);
+
+    std::vector<StructuralState> X(organisms);
+    for (StructuralState& x : X)
+        x.reset();
+
+    std::vector<FleetEvent> round(organisms);
+    std::vector<Row>        rows;
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        w.round(i, 0, organisms, round.data());
+        for (const FleetEvent& e : round)
+        {
+            StructEvent E = e.event();
+            if (i == 40 && e.id == 3)
+                E.dt = -1.0;                    // one rejected step
+            const StateEnvelope env = FMRT_Step(X[e.id], E);
+            if (env.status != StepStatus::ERROR)
+                X[e.id] = env.state;
+            rows.push_back({ e.id, i, env });
+        }
+    }
+    return rows;
+}
+
+int test_trajectory()
+{
+    std::cout << "Running trajectory...\n";
+
+    const std::filesystem::path dir  = std::filesystem::temp_directory_path();
+    const std::string           path = (dir / "fmrt_test_trajectory.bin").string();
+
+    constexpr OrganismId  ORGANISMS = 7;
+    constexpr std::size_t ROUNDS    = 300;
+    constexpr std::size_t BLOCK     = 500;
+
+    std::vector<Row> rows = make_rows(ORGANISMS, ROUNDS);
+
+    // a NaN payload and a negative zero survive bit for bit
+    rows[5].env.metrics.mu  = std::numeric_limits<double>::quiet_NaN();
+    rows[6].env.state.Phi   = -0.0;
+
+    bool saw_error = false;
+    for (const Row& r : rows)
+        saw_error |= r.env.status == StepStatus::ERROR;
+    if (!saw_error)
+    {
+        std::cerr << "trajectory: the rows contain no rejected step\n";
+        return 1;
+    }
+
+    // --- write ------------------------------------------------------------------
+    {
+        TrajectoryOptions opt;
+        opt.block_rows = BLOCK;
+
+        TrajectoryWriter wr;
+        if (!wr.open(path.c_str(), opt))
+        {
+            std::cerr << "trajectory: open for writing failed: " << wr.error() << "\n";
+            return 1;
+        }
+        for (const Row& r : rows)
+            if (!wr.append(r.id, r.step, r.env))
+            {
+                std::cerr << "trajectory: append failed: " << wr.error() << "\n";
+                return 1;
+            }
+        if (!wr.close() || wr.rows() != rows.size() ||
+            wr.bytes() != std::filesystem::file_size(path))
+        {
+            std::cerr << "trajectory: close failed: " << wr.error() << "\n";
+            return 1;
+        }
+    }
+
+    // --- read back: every field, rows grouped by organism within a block --------
+    TrajectoryReader rd;
+    if (!rd.open(path.c_str()))
+    {
+        std::cerr << "trajectory: open failed: " << rd.error() << "\n";
+        return 1;
+    }
+
+    const std::size_t blocks = (rows.size() + BLOCK - 1) / BLOCK;
+    if (rd.blocks() != blocks || rd.rows() != rows.size() || rd.truncated())
+    {
+        std::cerr << "trajectory: " << rd.blocks() << " blocks / " << rd.rows() << " rows indexed\n";
+        return 1;
+    }
+
+    TrajectoryBlock blk;
+    for (std::size_t b = 0; b < rd.blocks(); ++b)
+    {
+        if (!rd.decode(b, blk))
+        {
+            std::cerr << "trajectory: decode failed: " << rd.error() << "\n";
+            return 1;
+        }
+
+        const std::size_t first = b * BLOCK;
+        const std::size_t n     = std::min(BLOCK, rows.size() - first);
+        if (blk.rows != n || rd.blockHeader(b).first_row != first)
+        {
+            std::cerr << "trajectory: block " << b << " has " << blk.rows << " rows\n";
+            return 1;
+        }
+
+        // expected order: stable by organism
+        std::vector<const Row*> expect;
+        for (OrganismId id = 0; id < ORGANISMS; ++id)
+            for (std::size_t j = first; j < first + n; ++j)
+                if (rows[j].id == id)
+                    expect.push_back(&rows[j]);
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const Row& r = *expect[j];
+            const StateEnvelope env = blk.envelope(j);
+            if (blk.id[j] != r.id || blk.step[j] != r.step || !same_envelope(env, r.env) ||
+                env.error_reason != errorCategoryToString(r.env.error_category))
+            {
+                std::cerr << "trajectory: block " << b << " row " << j << " differs\n";
+                return 1;
+            }
+        }
+    }
+
+    // --- partial decode: κ only ------------------------------------------------------
+    {
+        TrajectoryBlock k;
+        if (!rd.decode(1, k, trajColumn(TRAJ_KAPPA)) || k.columns != trajColumn(TRAJ_KAPPA) ||
+            !k.id.empty() || k.real[TRAJ_PHI - TRAJ_DELTA].size() != 0 ||
+            k.real[TRAJ_KAPPA - TRAJ_DELTA].size() != BLOCK)
+        {
+            std::cerr << "trajectory: single-column decode\n";
+            return 1;
+        }
+        rd.decode(1, blk);
+        if (std::memcmp(k.reals(TRAJ_KAPPA), blk.reals(TRAJ_KAPPA), BLOCK * sizeof(double)) != 0)
+        {
+            std::cerr << "trajectory: single-column decode differs\n";
+            return 1;
+        }
+    }
+
+    // --- block statistics ---------------------------------------------------------------
+    for (std::size_t b = 0; b < rd.blocks(); ++b)
+    {
+        const TrajectoryBlockStats& s = rd.blockStats(b);
+        const std::uint64_t first_step = b * BLOCK / ORGANISMS;
+
+        if (s.id_min != 0 || s.id_max != ORGANISMS - 1 || s.step_min != first_step ||
+            rd.mayContain(b, TRAJ_STEP, static_cast<double>(s.step_max) + 1.0, 1e18) ||
+            !rd.mayContain(b, TRAJ_STEP, static_cast<double>(first_step), static_cast<double>(first_step)) ||
+            rd.mayContain(b, TRAJ_KAPPA, 2.0, 3.0) || !rd.mayContain(b, TRAJ_KAPPA, 0.0, 1.0) ||
+            !rd.mayContain(b, TRAJ_INVARIANTS, 0.0, 0.0))
+        {
+            std::cerr << "trajectory: block " << b << " statistics\n";
+            return 1;
+        }
+    }
+    {
+        const std::size_t b = 40 * ORGANISMS / BLOCK;      // block of the rejected step
+        if (!rd.mayContain(b, TRAJ_STATUS, 1.0, 1.0) || rd.mayContain(b + 1, TRAJ_STATUS, 1.0, 1.0) ||
+            rd.mayContain(b, TRAJ_STATUS, 3.0, 200.0))
+        {
+            std::cerr << "trajectory: code column statistics\n";
+            return 1;
+        }
+    }
+    rd.close();
+
+    // --- corruption: checksum caught, other blocks still decode ---------------
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, static_cast<long>(size / 2), SEEK_SET);
+        const int ch = std::fgetc(f);
+        std::fseek(f, -1, SEEK_CUR);
+        std::fputc(ch ^ 0x04, f);
+        std::fclose(f);
+
+        TrajectoryReader in;
+        if (!in.open(path.c_str()))
+        {
+            std::cerr << "trajectory: corrupt file not indexed: " << in.error() << "\n";
+            return 1;
+        }
+
+        std::size_t bad = 0;
+        for (std::size_t b = 0; b < in.blocks(); ++b)
+            if (!in.decode(b, blk))
+            {
+                ++bad;
+                if (in.error().find("checksum") == std::string::npos)
+                {
+                    std::cerr << "trajectory: unexpected error: " << in.error() << "\n";
+                    return 1;
+                }
+            }
+        if (bad != 1)
+        {
+            std::cerr << "trajectory: " << bad << " corrupt blocks reported\n";
+            return 1;
+        }
+    }
+
+    // --- torn tail: the last, partial block is ignored --------------------------
+    {
+        std::filesystem::resize_file(path, size - 100);
+
+        TrajectoryReader in;
+        if (!in.open(path.c_str()) || !in.truncated() || in.blocks() != blocks - 1)
+        {
+            std::cerr << "trajectory: torn tail not detected\n";
+            return 1;
+        }
+    }
+
+    // --- not a trajectory file ----------------------------------------------------------
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        std::fputs("FMRTLOG! but not a trajectory file at all", f);
+        std::fclose(f);
+
+        TrajectoryReader in;
+        if (in.open(path.c_str()) || in.error().find("not an FMRT trajectory") == std::string::npos)
+        {
+            std::cerr << "trajectory: foreign file accepted\n";
+            return 1;
+        }
+    }
+
+    std::filesystem::remove(path);
+
+    std::cout << "trajectory OK\n";
+    return 0;
+}
@@ -0,0 +1,281 @@
+#pragma once
+//
+// FMRT Core V2.2
+// test_util.hpp
+//
+// Helpers shared by the tests: bitwise comparison of states, metrics and
+// envelopes (NaN payloads and signed zeros included), a stateless hash
+// for deterministic test inputs, and the harnesses of the broadcast
+// tests (column kernel against the scalar step, fleet against fleet,
+// kernel speed against the per-organism step).
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_fleet.hpp"
+
+inline bool same_bits(double a, double b)
+{
+    std::uint64_t ua, ub;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+inline bool same_state(const fmrt::StructuralState& a, const fmrt::StructuralState& b)
+{
+    for (std::size_t k = 0; k < fmrt::DELTA_DIM; ++k)
+        if (!same_bits(a.Delta[k], b.Delta[k])) return false;
+
+    return same_bits(a.Phi, b.Phi) &&
+           same_bits(a.M, b.M) &&
+           same_bits(a.Kappa, b.Kappa) &&
+           a.RegimePrev == b.RegimePrev;
+}
+
+inline bool same_metrics(const fmrt::DerivedMetrics& a, const fmrt::DerivedMetrics& b)
+{
+    return same_bits(a.curvature_R, b.curvature_R) &&
+           same_bits(a.det_g, b.det_g) &&
+           same_bits(a.tau, b.tau) &&
+           same_bits(a.mu, b.mu) &&
+           a.morph_class == b.morph_class &&
+           a.regime == b.regime &&
+           a.is_collapse == b.is_collapse &&
+           same_bits(a.collapse_distance, b.collapse_distance) &&
+           same_bits(a.collapse_speed, b.collapse_speed) &&
+           same_bits(a.collapse_intensity, b.collapse_intensity);
+}
+
+// every field but the error_reason pointer
+inline bool same_envelope(const fmrt::StateEnvelope& a, const fmrt::StateEnvelope& b)
+{
+    return same_state(a.state, b.state) &&
+           same_metrics(a.metrics, b.metrics) &&
+           a.invariants.flags == b.invariants.flags &&
+           a.invariants.all_ok == b.invariants.all_ok &&
+           a.status == b.status &&
+           a.error_category == b.error_category &&
+           a.event_type == b.event_type;
+}
+
+// murmur3 finalizer: well-mixed bits from a counter
+inline std::uint64_t mix(std::uint64_t x)
+{
+    x ^= x >> 33; x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33; x *= 0xC4CEB9FE1A85EC53ULL;
+    return x ^ (x >> 33);
+}
+
+// [lo, hi) from the top 53 bits of h
+inline double uniform(std::uint64_t h, double lo, double hi)
+{
+    return lo + (hi - lo) * static_cast<double>(h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// State and envelope columns of n organisms, owned by vectors
+class ColumnFixture
+{
+public:
+    explicit ColumnFixture(std::size_t n)
+        : phi(n), m(n), kappa(n), prev(n), metrics(n), inv(n), status(n), err(n)
+    {
+        for (std::size_t k = 0; k < fmrt::DELTA_DIM; ++k)
+        {
+            delta[k].resize(n);
+            X.Delta[k] = delta[k].data();
+        }
+        X.Phi        = phi.data();
+        X.M          = m.data();
+        X.Kappa      = kappa.data();
+        X.RegimePrev = prev.data();
+
+        out.metrics        = metrics.data();
+        out.invariants     = inv.data();
+        out.status         = status.data();
+        out.error_category = err.data();
+    }
+
+    ColumnFixture(const ColumnFixture&)            = delete;
+    ColumnFixture& operator=(const ColumnFixture&) = delete;
+
+    // organism i as the kernel left it, against the scalar envelope
+    bool matches(std::size_t i, const fmrt::StateEnvelope& env) const
+    {
+        return same_state(X.load(i), env.state) &&
+               same_metrics(metrics[i], env.metrics) &&
+               inv[i].flags == env.invariants.flags &&
+               inv[i].all_ok == env.invariants.all_ok &&
+               status[i] == env.status &&
+               err[i] == env.error_category;
+    }
+
+    fmrt::StateColumns    X;
+    fmrt::EnvelopeColumns out;
+
+private:
+    std::vector<double>                delta[fmrt::DELTA_DIM];
+    std::vector<double>                phi, m, kappa;
+    std::vector<fmrt::Regime>          prev;
+    std::vector<fmrt::DerivedMetrics>  metrics;
+    std::vector<fmrt::InvariantStatus> inv;
+    std::vector<fmrt::StepStatus>      status;
+    std::vector<fmrt::ErrorCategory>   err;
+};
+
+// Steps the organisms of ref through `rounds` calls of
+// kernel(r, fixture, in_place) and checks every one of them after each
+// round against FMRT_Step / FMRT_StepInPlace of event(r, i).
+template <class Kernel, class Event>
+int check_column_kernel(const char* test, std::vector<fmrt::StructuralState> ref,
+                        std::size_t rounds, bool in_place, Kernel&& kernel, Event&& event)
+{
+    const std::size_t N = ref.size();
+
+    ColumnFixture c(N);
+    for (std::size_t i = 0; i < N; ++i)
+        c.X.store(i, ref[i]);
+
+    for (std::size_t r = 0; r < rounds; ++r)
+    {
+        kernel(r, c, in_place);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const fmrt::StructEvent E = event(r, i);
+
+            fmrt::StateEnvelope env = fmrt::FMRT_Step(ref[i], E);
+            if (in_place)
+            {
+                env.state = ref[i];
+                fmrt::FMRT_StepInPlace(env.state, E);
+            }
+
+            if (!c.matches(i, env))
+            {
+                std::cerr << test << " FAILED: organism " << i
+                          << " round " << r << (in_place ? " (in place)" : "") << "\n";
+                return 1;
+            }
+
+            ref[i] = env.state;
+        }
+    }
+
+    return 0;
+}
+
+// Two fleets of cfg, organism i starting from initial(i), driven by
+// round(r, fast, slow): phase, last status and state must agree after
+// every round, the stats at the end. Some steps must fail, and under a
+// collapse policy some organism must have collapsed.
+template <class Initial, class Round>
+int check_fleet_pair(const char* test, const char* name, const fmrt::FleetConfig& cfg,
+                     std::size_t organisms, std::size_t rounds, Initial&& initial, Round&& round)
+{
+    using namespace fmrt;
+
+    Fleet fast(cfg);
+    Fleet slow(cfg);
+    for (std::size_t i = 0; i < organisms; ++i)
+    {
+        const StructuralState X = initial(i);
+        fast.add(X);
+        slow.add(X);
+    }
+
+    for (std::size_t r = 0; r < rounds; ++r)
+    {
+        round(r, fast, slow);
+
+        for (std::size_t i = 0; i < organisms; ++i)
+        {
+            const OrganismId id = static_cast<OrganismId>(i);
+
+            bool ok = fast.phase(id) == slow.phase(id) &&
+                      fast.lastStatus(id) == slow.lastStatus(id);
+            if (ok && fast.phase(id) != OrganismPhase::Evicted)
+                ok = same_state(fast.state(id), slow.state(id));
+
+            if (!ok)
+            {
+                std::cerr << test << " FAILED [" << name << "]: organism " << i
+                          << " round " << r << "\n";
+                return 1;
+            }
+        }
+    }
+
+    const FleetStats a = fast.stats();
+    const FleetStats b = slow.stats();
+    if (a.steps != b.steps || a.errors != b.errors || a.dead != b.dead ||
+        a.dropped != b.dropped || a.auto_resets != b.auto_resets ||
+        a.evictions != b.evictions || fast.active() != slow.active() ||
+        a.errors == 0)
+    {
+        std::cerr << test << " FAILED [" << name << "]: stats\n";
+        return 1;
+    }
+
+    if (cfg.lifecycle != LifecyclePolicy::Keep && a.dead + a.dropped + a.auto_resets == 0)
+    {
+        std::cerr << test << " FAILED [" << name << "]: nothing collapsed\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+// Every organism of the columns stepped alone with FMRT_StepInPlace and
+// event(i): what a broadcast costs without its single-event kernel
+template <class Event>
+void step_each_in_place(const ColumnFixture& c, std::size_t n, Event&& event)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        fmrt::StructuralState X = c.X.load(i);
+        if (fmrt::FMRT_StepInPlace(X, event(i), c.out.metrics + i) == fmrt::StepStatus::OK)
+            c.X.store(i, X);
+    }
+}
+
+// true when fast() beats slow(): best of interleaved repetitions, a few
+// attempts so a busy machine does not decide. Optimized builds only
+// (NDEBUG); otherwise the comparison says nothing and is skipped.
+template <class Fast, class Slow>
+bool runs_faster(Fast&& fast, Slow&& slow)
+{
+#if defined(NDEBUG)
+    using Clock = std::chrono::steady_clock;
+
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        Clock::duration best_fast = Clock::duration::max();
+        Clock::duration best_slow = Clock::duration::max();
+        for (int rep = 0; rep < 15; ++rep)
+        {
+            const auto t0 = Clock::now();
+            fast();
+            const auto t1 = Clock::now();
+            slow();
+            const auto t2 = Clock::now();
+            best_fast = std::min(best_fast, t1 - t0);
+            best_slow = std::min(best_slow, t2 - t1);
+        }
+        if (best_fast < best_slow)
+            return true;
+    }
+    return false;
+#else
+    (void)fast;
+    (void)slow;
+    return true;
+#endif
+}
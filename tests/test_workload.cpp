@@ -0,0 +1,220 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "fmrt_api.hpp"
+#include "fmrt_philox.hpp"
+#include "fmrt_workload.hpp"
+
+using namespace fmrt;
+
+static bool same_event(const StructEvent& a, const StructEvent& b)
+{
+    if (a.type != b.type || std::memcmp(&a.dt, &b.dt, sizeof(double)) != 0)
+        return false;
+    return std::memcmp(a.stimulus.data(), b.stimulus.data(), sizeof(double) * DELTA_DIM) == 0;
+}
+
+// Random123 known-answer vectors for Philox4x32-10
+static int check_philox()
+{
+    struct Kat
+    {
+        Philox4x32::Counter c;
+        Philox4x32::Key     k;
+        std::uint32_t       expect[4];
+    };
+
+    const Kat kat[] = {
+        { { { 0u, 0u, 0u, 0u } }, { { 0u, 0u } },
+          { 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u } },
+        { { { 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu } }, { { 0xffffffffu, 0xffffffffu } },
+          { 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu } },
+        { { { 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u } }, { { 0xa4093822u, 0x299f31d0u } },
+          { 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u } },
+    };
+
+    for (const Kat& t : kat)
+    {
+        const Philox4x32::Block r = Philox4x32::generate(t.c, t.k);
+        for (int i = 0; i < 4; ++i)
+            if (r.v[i] != t.expect[i])
+            {
+                std::cerr << "workload: Philox4x32-10 known-answer mismatch\n";
+                return 1;
+            }
+    }
+
+    if (!(Philox4x32::uniform(0u, 0u) > 0.0) || Philox4x32::uniform(0xffffffffu, 0xffffffffu) != 1.0)
+    {
+        std::cerr << "workload: uniform() not in (0, 1]\n";
+        return 1;
+    }
+    return 0;
+}
+
+int test_workload()
+{
+    std::cout << "Running workload...\n";
+
+    if (check_philox() != 0)
+        return 1;
+
+    WorkloadConfig cfg;
+    cfg.seed           = 0x0123456789ABCDEFULL;
+    cfg.session_events = 2048;
+
+    const MarketWorkload w(cfg);
+
+    constexpr std::size_t  EVENTS = 20000;
+    constexpr OrganismId   ID     = 7;
+
+    std::vector<StructEvent> stream(EVENTS);
+    w.generate(ID, 0, EVENTS, stream.data());
+
+    // --- reproducible, and any slice equals the full stream -----------------
+    {
+        const MarketWorkload again(cfg);
+        for (std::uint64_t first : { std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{63},
+                                     std::uint64_t{2047}, std::uint64_t{12345} })
+        {
+            std::vector<StructEvent> slice(300);
+            again.generate(ID, first, slice.size(), slice.data());
+
+            for (std::size_t j = 0; j < slice.size() && first + j < EVENTS; ++j)
+                if (!same_event(slice[j], stream[first + j]) ||
+                    !same_event(again.event(ID, first + j), stream[first + j]))
+                {
+                    std::cerr << "workload: slice at " << first << " differs from the stream\n";
+                    return 1;
+                }
+        }
+    }
+
+    // --- FleetEvent forms carry the same events --------------------------------
+    {
+        std::vector<FleetEvent> fe(200);
+        w.generate(ID, 1000, fe.size(), fe.data());
+        for (std::size_t j = 0; j < fe.size(); ++j)
+            if (fe[j].id != ID || !same_event(fe[j].event(), stream[1000 + j]))
+            {
+                std::cerr << "workload: FleetEvent stream differs\n";
+                return 1;
+            }
+
+        std::vector<FleetEvent> rnd(16);
+        w.round(42, 3, rnd.size(), rnd.data());
+        for (std::size_t j = 0; j < rnd.size(); ++j)
+        {
+            const OrganismId id = 3 + static_cast<OrganismId>(j);
+            if (rnd[j].id != id || !same_event(rnd[j].event(), w.event(id, 42)))
+            {
+                std::cerr << "workload: round() differs from event()\n";
+                return 1;
+            }
+        }
+    }
+
+    // --- organisms and seeds give different streams ----------------------------
+    {
+        WorkloadConfig other = cfg;
+        other.seed ^= 1;
+        const MarketWorkload w2(other);
+
+        std::size_t same_id = 0, same_seed = 0;
+        for (std::uint64_t i = 0; i < 1000; ++i)
+        {
+            same_id   += same_event(w.event(ID + 1, i), stream[i]);
+            same_seed += same_event(w2.event(ID, i), stream[i]);
+        }
+        // identical HEARTBEATs are expected; UPDATEs never coincide
+        if (same_id > 200 || same_seed > 200)
+        {
+            std::cerr << "workload: streams of other organisms / seeds are not independent\n";
+            return 1;
+        }
+    }
+
+    // --- shape: every event valid, session GAPs, floods, bursts, tails -------
+    std::size_t updates = 0, gaps = 0, heartbeats = 0, big = 0, flood_runs = 0, run = 0;
+    double      stim_sum = 0.0;
+
+    for (std::size_t i = 0; i < EVENTS; ++i)
+    {
+        const StructEvent& E = stream[i];
+
+        if (!E.isFinite() || !E.hasValidDt() || E.type == EventType::Reset)
+        {
+            std::cerr << "workload: invalid event at " << i << "\n";
+            return 1;
+        }
+
+        if (i > 0 && i % cfg.session_events == 0 && E.type != EventType::Gap)
+        {
+            std::cerr << "workload: session " << i / cfg.session_events << " does not open with a GAP\n";
+            return 1;
+        }
+
+        switch (E.type)
+        {
+            case EventType::Update:
+                ++updates;
+                for (double v : E.stimulus)
+                {
+                    if (std::fabs(v) > cfg.stimulus_cap)
+                    {
+                        std::cerr << "workload: stimulus above the cap\n";
+                        return 1;
+                    }
+                    stim_sum += std::fabs(v);
+                    big      += std::fabs(v) > 10.0 * cfg.stimulus_scale;
+                }
+                break;
+            case EventType::Gap:       ++gaps;       break;
+            case EventType::Heartbeat: ++heartbeats; break;
+            default: break;
+        }
+
+        run = (E.type == EventType::Heartbeat) ? run + 1 : 0;
+        if (run == cfg.block_events)
+            ++flood_runs;
+    }
+
+    const double stim_mean = stim_sum / static_cast<double>(updates * DELTA_DIM);
+
+    if (updates < EVENTS / 2 || gaps < EVENTS / cfg.session_events || heartbeats == 0 ||
+        flood_runs == 0 || big == 0 ||
+        std::fabs(stim_mean - cfg.stimulus_scale) > 0.2 * cfg.stimulus_scale)
+    {
+        std::cerr << "workload: unexpected stream shape (updates " << updates << ", gaps " << gaps
+                  << ", heartbeats " << heartbeats << ", floods " << flood_runs
+                  << ", tail " << big << ", mean |stimulus| " << stim_mean << ")\n";
+        return 1;
+    }
+
+    // --- the stream drives FMRT_Step without input rejections -----------------
+    {
+        StructuralState X;
+        X.reset();
+        for (std::size_t i = 0; i < 2000; ++i)
+        {
+            const StateEnvelope env = FMRT_Step(X, stream[i]);
+            if (env.status == StepStatus::ERROR &&
+                (env.error_category == ErrorCategory::InvalidEvent ||
+                 env.error_category == ErrorCategory::NumericError))
+            {
+                std::cerr << "workload: event " << i << " rejected as input\n";
+                return 1;
+            }
+            if (env.status != StepStatus::ERROR)
+                X = env.state;
+            if (X.Kappa <= 0.0)
+                X.reset();
+        }
+    }
+
+    std::cout << "workload OK\n";
+    return 0;
+}